@@ -3,9 +3,11 @@
 
 #include "DataFormats/Math/interface/deltaR.h"                        // deltaR()
 
+#include "TallinnNtupleProducer/Cleaners/interface/markOverlaps.h"   // markOverlaps()
 #include "TallinnNtupleProducer/CommonTools/interface/cmsException.h" // get_human_line()
 
 #include <iostream>                                                   // std::cout
+#include <vector>                                                     // std::vector
 
 template <typename T>
 class ParticleCollectionCleaner
@@ -19,61 +21,115 @@ class ParticleCollectionCleaner
   ~ParticleCollectionCleaner() {}
 
   /**
-   * @brief Select subset of particles not overlapping with any of the other particles passed as function argument
+   * @brief Select subset of particles not overlapping with any of the other particles passed as function arguments
    * @return Collection of non-overlapping particles
    */
-  template <typename Toverlap>
+  template <typename... Toverlaps>
   std::vector<const T *>
   operator()(const std::vector<const T *> & particles,
-             const std::vector<const Toverlap *> & overlaps) const
+             const std::vector<const Toverlaps *> &... overlaps) const
+  {
+    std::vector<const T *> cleanedParticles;
+    clean(particles, cleanedParticles, overlaps...);
+    return cleanedParticles;
+  }
+
+  /**
+   * @brief Same as above, but fill the non-overlapping particles into the collection given as second function argument,
+   *        which is cleared first, but keeps its capacity, so that it can be reused for each event without reallocating memory
+   *
+   * The eta and phi of the particles are copied into contiguous buffers once, and all collections of overlaps are checked in one pass,
+   * filling a mask of the overlapping particles, from which the collection of non-overlapping particles is built at the end.
+   */
+  template <typename... Toverlaps>
+  void
+  clean(const std::vector<const T *> & particles,
+        std::vector<const T *> & cleanedParticles,
+        const std::vector<const Toverlaps *> &... overlaps) const
   {
     if(debug_)
     {
       std::cout << get_human_line(this, __func__, __LINE__) << '\n';
     }
-    std::vector<const T *> cleanedParticles;
-    for(const T * particle: particles)
+    const std::size_t numParticles = particles.size();
+    particles_eta_.resize(numParticles);
+    particles_phi_.resize(numParticles);
+    for(std::size_t idxParticle = 0; idxParticle < numParticles; ++idxParticle)
+    {
+      particles_eta_[idxParticle] = particles[idxParticle]->eta();
+      particles_phi_[idxParticle] = particles[idxParticle]->phi();
+    }
+    isOverlap_.assign(numParticles, 0);
+    (addOverlaps(particles, overlaps), ...);
+
+    cleanedParticles.clear();
+    for(std::size_t idxParticle = 0; idxParticle < numParticles; ++idxParticle)
+    {
+      if(! isOverlap_[idxParticle])
+      {
+        cleanedParticles.push_back(particles[idxParticle]);
+      }
+    }
+  }
+
+protected:
+  /**
+   * @brief Flag the particles that overlap with any of the given overlaps in isOverlap_
+   */
+  template <typename Toverlap>
+  void
+  addOverlaps(const std::vector<const T *> & particles,
+              const std::vector<const Toverlap *> & overlaps) const
+  {
+    const std::size_t numOverlaps = overlaps.size();
+    overlaps_eta_.resize(numOverlaps);
+    overlaps_phi_.resize(numOverlaps);
+    for(std::size_t idxOverlap = 0; idxOverlap < numOverlaps; ++idxOverlap)
+    {
+      overlaps_eta_[idxOverlap] = overlaps[idxOverlap]->eta();
+      overlaps_phi_[idxOverlap] = overlaps[idxOverlap]->phi();
+    }
+    const std::vector<unsigned char> isOverlap_previous = debug_ ? isOverlap_ : std::vector<unsigned char>();
+    markOverlaps(
+      particles_eta_.data(), particles_phi_.data(), particles_eta_.size(),
+      overlaps_eta_.data(), overlaps_phi_.data(), numOverlaps,
+      dR_, isOverlap_.data()
+    );
+    if(debug_)
     {
-      bool isOverlap = false;
-      for(const Toverlap * overlap: overlaps)
+      for(std::size_t idxParticle = 0; idxParticle < particles.size(); ++idxParticle)
       {
-        const double dRoverlap = deltaR(particle->eta(), particle->phi(), overlap->eta(), overlap->phi());
-        if(dRoverlap < dR_)
+        if(! isOverlap_[idxParticle] || isOverlap_previous[idxParticle])
         {
-          isOverlap = true;
-          if(debug_)
+          continue;
+        }
+        for(const Toverlap * overlap: overlaps)
+        {
+          const double dRoverlap = deltaR(particles[idxParticle]->eta(), particles[idxParticle]->phi(), overlap->eta(), overlap->phi());
+          if(dRoverlap < dR_)
           {
-            std::cout << "Removed:\n"                    << *particle
+            std::cout << "Removed:\n"                    << *particles[idxParticle]
                       << "because it overlapped with:\n" << *overlap
                       << " within "                      << dRoverlap
                       << '\n'
             ;
+            break;
           }
-          break;
         }
       }
-      if(! isOverlap)
-      {
-        cleanedParticles.push_back(particle);
-      }
     }
-    return cleanedParticles;
   }
 
-  template <typename Toverlap,
-            typename... Args>
-  std::vector<const T *>
-  operator()(const std::vector<const T *> & particles,
-             const std::vector<const Toverlap *> & overlaps,
-             Args... args) const
-  {
-    std::vector<const T *> cleanedParticles = (*this)(particles, overlaps);
-    return (*this)(cleanedParticles, args...);
-  }
-
-protected:
   double dR_;
   bool debug_;
+
+  // CV: buffers are kept between calls to avoid allocating memory for every event,
+  //     so the same instance must not be used by several threads at the same time
+  mutable std::vector<double> particles_eta_;
+  mutable std::vector<double> particles_phi_;
+  mutable std::vector<double> overlaps_eta_;
+  mutable std::vector<double> overlaps_phi_;
+  mutable std::vector<unsigned char> isOverlap_; ///< 1 if the particle overlaps with any of the overlaps, 0 otherwise
 };
 
 #include "TallinnNtupleProducer/Objects/interface/RecoElectron.h"
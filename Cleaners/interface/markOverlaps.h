@@ -0,0 +1,46 @@
+#ifndef TallinnNtupleProducer_Cleaners_markOverlaps_h
+#define TallinnNtupleProducer_Cleaners_markOverlaps_h
+
+#define _USE_MATH_DEFINES // M_PI
+
+#include <cmath>   // std::fabs()
+#include <cstddef> // std::size_t
+
+/**
+ * @brief Flag the particles that are within dR of any of the given overlaps.
+ *
+ * The eta and phi of the particles and of the overlaps are given as contiguous arrays,
+ * and the squared distance in the eta-phi plane is compared to dR^2, without taking the square root.
+ * The inner loop over the particles has neither function calls nor branches, so that the compiler can vectorize it.
+ * The flags of particles that overlap are set to 1, while the flags of all other particles are left unchanged,
+ * so that the function can be called for several collections of overlaps with the same array of flags.
+ *
+ * @note The phi values are expected to be within [-pi, +pi]
+ */
+inline void
+markOverlaps(const double * __restrict__ particles_eta,
+             const double * __restrict__ particles_phi,
+             std::size_t numParticles,
+             const double * overlaps_eta,
+             const double * overlaps_phi,
+             std::size_t numOverlaps,
+             double dR,
+             unsigned char * __restrict__ isOverlap)
+{
+  const double dR2 = dR * dR;
+  for(std::size_t idxOverlap = 0; idxOverlap < numOverlaps; ++idxOverlap)
+  {
+    const double overlap_eta = overlaps_eta[idxOverlap];
+    const double overlap_phi = overlaps_phi[idxOverlap];
+    for(std::size_t idxParticle = 0; idxParticle < numParticles; ++idxParticle)
+    {
+      const double dEta = particles_eta[idxParticle] - overlap_eta;
+      // CV: as both phi values are within [-pi, +pi], the difference needs to be wrapped at most once
+      double dPhi = std::fabs(particles_phi[idxParticle] - overlap_phi);
+      dPhi = dPhi > M_PI ? 2. * M_PI - dPhi : dPhi;
+      isOverlap[idxParticle] |= (dEta * dEta + dPhi * dPhi < dR2);
+    }
+  }
+}
+
+#endif // TallinnNtupleProducer_Cleaners_markOverlaps_h
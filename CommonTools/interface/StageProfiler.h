@@ -0,0 +1,128 @@
+#ifndef TallinnNtupleProducer_CommonTools_StageProfiler_h
+#define TallinnNtupleProducer_CommonTools_StageProfiler_h
+
+#include <chrono>  // std::chrono::steady_clock
+#include <iosfwd>  // std::ostream
+#include <string>  // std::string
+#include <vector>  // std::vector
+
+/**
+ * @brief Number of calls and time spent in each stage (reader, cleaner, selector, gen-matcher, writer plugin, ...) of the event processing.
+ *
+ * Each thread accumulates its own table of stages, so that no locking is needed in the event loop;
+ * the tables of all threads are merged by getStages() at the end of the job.
+ *
+ * The instrumentation is enabled by compiling with -DTALLINN_ENABLE_PROFILING (e.g. scram b USER_CXXFLAGS="-DTALLINN_ENABLE_PROFILING").
+ * Otherwise, the PROFILE_* macros below expand to nothing and the instrumentation has no overhead at all.
+ */
+class StageProfiler
+{
+ public:
+  struct Stage
+  {
+    Stage(const std::string & name);
+
+    std::string name_;         ///< name of the stage
+    unsigned long long calls_; ///< number of calls resp. value of the counter
+    long long time_;           ///< total time spent in the stage, in nanoseconds (zero for counters)
+  };
+
+  /**
+   * @brief Return the stage with given name in the table of the current thread, creating it if it does not exist yet
+   *
+   * @note The returned reference stays valid until the end of the job
+   */
+  static
+  Stage &
+  get(const std::string & name);
+
+  /**
+   * @brief Return the stages of all threads, merged by name, in the order in which they have been called first
+   *
+   * @note Must not be called while other threads are still processing events
+   */
+  static
+  std::vector<Stage>
+  getStages();
+
+  /**
+   * @brief Print number of calls, total and mean time and throughput of each stage
+   * @param numEvents Number of processed events, used to compute the throughput in events per second
+   */
+  static
+  void
+  print(std::ostream & stream,
+        long long numEvents);
+
+  /**
+   * @brief Return true if the instrumentation has been compiled in
+   */
+  static constexpr
+  bool
+  isEnabled()
+  {
+#ifdef TALLINN_ENABLE_PROFILING
+    return true;
+#else
+    return false;
+#endif
+  }
+};
+
+/**
+ * @brief Add the time elapsed between its construction and its destruction (or the call to stop) to the given stage
+ */
+class StageTimer
+{
+ public:
+  StageTimer(StageProfiler::Stage & stage)
+    : stage_(&stage)
+    , start_(std::chrono::steady_clock::now())
+  {}
+  ~StageTimer()
+  {
+    stop();
+  }
+
+  void
+  stop()
+  {
+    if(stage_)
+    {
+      stage_->time_ += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count();
+      ++stage_->calls_;
+      stage_ = nullptr;
+    }
+  }
+
+ private:
+  StageProfiler::Stage * stage_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+#define PROFILE_CONCAT_IMPL(x, y) x ## y
+#define PROFILE_CONCAT(x, y) PROFILE_CONCAT_IMPL(x, y)
+
+#ifdef TALLINN_ENABLE_PROFILING
+// CV: the stage is looked up once per call site and thread
+#define PROFILE_SCOPE(name) \
+  static thread_local StageProfiler::Stage & PROFILE_CONCAT(profileStage_, __LINE__) = StageProfiler::get(name); \
+  StageTimer PROFILE_CONCAT(profileTimer_, __LINE__)(PROFILE_CONCAT(profileStage_, __LINE__))
+#define PROFILE_START(timer, name) \
+  static thread_local StageProfiler::Stage & PROFILE_CONCAT(timer, _stage) = StageProfiler::get(name); \
+  StageTimer timer(PROFILE_CONCAT(timer, _stage))
+#define PROFILE_STOP(timer) timer.stop()
+// CV: for stages whose name is only known at run time, e.g. writer plugins; the stage is looked up on each call
+#define PROFILE_SCOPE_DYNAMIC(name) \
+  StageTimer PROFILE_CONCAT(profileTimer_, __LINE__)(StageProfiler::get(name))
+#define PROFILE_COUNT(name, n) \
+  do { static thread_local StageProfiler::Stage & profileCounter = StageProfiler::get(name); profileCounter.calls_ += (n); } while(0)
+#else
+#define PROFILE_SCOPE(name)
+#define PROFILE_START(timer, name)
+#define PROFILE_STOP(timer)
+#define PROFILE_SCOPE_DYNAMIC(name)
+#define PROFILE_COUNT(name, n)
+#endif
+
+#endif // TallinnNtupleProducer_CommonTools_StageProfiler_h
@@ -0,0 +1,104 @@
+#ifndef TallinnNtupleProducer_CommonTools_SysIdRegistry_h
+#define TallinnNtupleProducer_CommonTools_SysIdRegistry_h
+
+#include "TallinnNtupleProducer/CommonTools/interface/sysUncertOptions.h" // PUsys, TriggerSFsys, LeptonIDSFsys, TauIDSFsys, FRet, FRmt, ...
+
+#include <deque>                                                          // std::deque
+#include <map>                                                            // std::map
+#include <string>                                                         // std::string
+#include <vector>                                                         // std::vector
+
+/**
+ * @brief Central value or systematic shift, with the options for all categories of systematic uncertainties
+ *        (JetMET, b-tagging, lepton ID, trigger, ...) resolved from the name of the systematic shift once,
+ *        so that the string comparisons in the get*_option functions do not need to be repeated for every event
+ */
+struct SysId
+{
+  SysId();
+  SysId(const std::string & central_or_shift,
+        bool isMC,
+        std::size_t idx = 0);
+
+  std::string central_or_shift;                      ///< name of the central value or systematic shift
+  std::size_t idx;                                   ///< position of the systematic shift in the SysIdRegistry
+  bool isCentral;                                    ///< true if central value
+
+  int jet_option;                                    ///< getJet_option()
+  int met_option;                                    ///< getMET_option()
+  int fatJet_option;                                 ///< getFatJet_option()
+  int hadTauPt_option;                               ///< getHadTauPt_option()
+  int btagWeight_option;                             ///< getBTagWeight_option()
+  pileupJetIDSFsys pileupJetIDSF_option;             ///< getPileupJetIDSFsys_option()
+  int jetToTauFR_option;                             ///< getJetToTauFR_option()
+  FRet eToTauFR_option;                              ///< getEToTauFR_option()
+  FRmt muToTauFR_option;                             ///< getMuToTauFR_option()
+  LeptonIDSFsys leptonIDSF_option;                   ///< getLeptonIDSFsys_option()
+  TauIDSFsys tauIDSF_option;                         ///< getTauIDSFsys_option()
+  TriggerSFsys triggerSF_lepton_option;              ///< getTriggerSF_option(), for TriggerSFsysChoice::leptonOnly
+  TriggerSFsys triggerSF_hadTau_option;              ///< getTriggerSF_option(), for TriggerSFsysChoice::hadTauOnly
+  int lheScale_option;                               ///< getLHEscale_option()
+  int partonShower_option;                           ///< getPartonShower_option()
+  int jetToLeptonFR_option;                          ///< getJetToLeptonFR_option()
+  PUsys pu_option;                                   ///< getPUsys_option()
+  L1PreFiringWeightSys l1PreFiringWeight_option;     ///< getL1PreFiringWeightSys_option()
+  int dyMCReweighting_option;                        ///< getDYMCReweighting_option()
+  int dyMCNormScaleFactors_option;                   ///< getDYMCNormScaleFactors_option()
+  int topPtReweighting_option;                       ///< getTopPtReweighting_option()
+  EWKJetSys ewkJet_option;                           ///< getEWKJetSys_option()
+  EWKBJetSys ewkBJet_option;                         ///< getEWKBJetSys_option()
+  PDFSys pdf_option;                                 ///< getPDFSys_option()
+  bool isPDFmember;                                  ///< isPDFsys_member()
+  LHEVptSys lheVpt_option;                           ///< getLHEVptSys_option()
+  SubjetBtagSys subjetBtag_option;                   ///< getSubjetBtagSys_option()
+  bool isCentral_FR;                                 ///< true if both jet->lepton and jet->tau fake-rate options are central
+};
+
+/**
+ * @brief Registry of systematic shifts, which assigns a SysId to each systematic shift at configuration time
+ *        and returns the same SysId for all subsequent look-ups
+ */
+class SysIdRegistry
+{
+ public:
+  SysIdRegistry(bool isMC);
+  SysIdRegistry(const std::vector<std::string> & central_or_shifts,
+                bool isMC);
+  ~SysIdRegistry();
+
+  /**
+   * @brief Resolve options for given systematic shift and add it to the registry.
+   *        If the systematic shift has already been added, the existing SysId is returned.
+   */
+  const SysId &
+  add(const std::string & central_or_shift);
+
+  /**
+   * @brief Return SysId for given systematic shift, which needs to have been added to the registry before
+   */
+  const SysId &
+  get(const std::string & central_or_shift) const;
+
+  const SysId &
+  get(std::size_t idx) const;
+
+  bool
+  has(const std::string & central_or_shift) const;
+
+  /**
+   * @brief Return SysIds of all systematic shifts in the order in which they were added to the registry
+   */
+  std::vector<const SysId *>
+  get_sysIds() const;
+
+  std::size_t
+  size() const;
+
+ protected:
+  bool isMC_;
+
+  std::deque<SysId> sysIds_;                  ///< std::deque, so that references to SysId objects stay valid when new systematic shifts are added
+  std::map<std::string, std::size_t> sysIdx_; ///< map of systematic shift names to position in sysIds_ container
+};
+
+#endif // TallinnNtupleProducer_CommonTools_SysIdRegistry_h
@@ -0,0 +1,90 @@
+#ifndef TallinnNtupleProducer_CommonTools_TTreeEntryIndex_h
+#define TallinnNtupleProducer_CommonTools_TTreeEntryIndex_h
+
+#include <string> // std::string
+#include <vector> // std::vector
+
+/**
+ * @brief Number of entries and cluster boundaries of the TTree in each of a list of input files,
+ *        so that a range of entries, counted across all input files, can be mapped to the files and the entries within these files
+ *        without opening the preceding files.
+ *
+ * The index is built by opening each input file once. It can be stored in a small text file (the "sidecar" index file) and read back,
+ * so that it needs to be built only once per dataset and can be shared by all jobs that process a range of entries of the same input files.
+ */
+class TTreeEntryIndex
+{
+ public:
+  /**
+   * @brief Read the index from the given index file, if it exists and matches the TTree name and list of input files;
+   *        otherwise, build the index from the input files and, if an index file name is given, write it to the index file
+   * @param treeName      The name of the input TTree
+   * @param fileNames     List of input files
+   * @param indexFileName Name of the index file (empty: do not read or write the index from or to a file)
+   */
+  TTreeEntryIndex(const std::string & treeName,
+                  const std::vector<std::string> & fileNames,
+                  const std::string & indexFileName = "");
+
+  /**
+   * @brief Return the total number of entries in all input files
+   */
+  long long
+  getEntryCount() const;
+
+  /**
+   * @brief Return the number of entries in the input file with given index
+   */
+  long long
+  getEntryCount(unsigned fileIdx) const;
+
+  /**
+   * @brief Return the index, counted across all input files, of the first entry in the input file with given index
+   */
+  long long
+  getFirstEntry(unsigned fileIdx) const;
+
+  /**
+   * @brief Return the index of the input file that contains the entry with given index, counted across all input files
+   *
+   * @note Will throw if the entry index is out of range
+   */
+  unsigned
+  getFileIdx(long long entry) const;
+
+  /**
+   * @brief Return the first entry of the cluster that contains the entry with given index,
+   *        so that ranges of entries can be aligned to the cluster boundaries and no cluster is read by two jobs.
+   *        Entry indices beyond the last entry are mapped to the total number of entries.
+   */
+  long long
+  alignToCluster(long long entry) const;
+
+ protected:
+  /**
+   * @brief Open each input file and record the number of entries and the cluster boundaries of the TTree
+   */
+  void
+  build();
+
+  /**
+   * @brief Read the index from the given file
+   * @return true,  if the index file exists and matches the TTree name and list of input files;
+   *         false, otherwise
+   */
+  bool
+  read(const std::string & indexFileName);
+
+  /**
+   * @brief Write the index to the given file
+   */
+  void
+  write(const std::string & indexFileName) const;
+
+  std::string treeName_;                ///< Name of the input TTree
+  std::vector<std::string> fileNames_;  ///< List of input files
+  std::vector<long long> firstEntries_; ///< Index of the first entry in each input file, followed by the total number of entries
+  std::vector<long long> clusters_;     ///< Index of the first entry in each cluster, counted across all input files, in ascending order
+};
+
+#endif // TallinnNtupleProducer_CommonTools_TTreeEntryIndex_h
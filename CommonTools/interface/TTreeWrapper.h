@@ -2,14 +2,17 @@
 #define TallinnNtupleProducer_CommonTools_TTreeWrapper_h
 
 #include <algorithm>   // std::transform()
+#include <future>      // std::future<>
 #include <string>      // std::string
 #include <type_traits> // std::is_base_of, std::enable_if
 #include <vector>      // std::vector<>
 
 // forward declarations
 class ReaderBase;
+class TBranch;
 class TFile;
 class TTree;
+class TTreeEntryIndex;
 
 /**
  * @brief Alternative class to TChain for reading
@@ -179,6 +182,12 @@ class TTreeWrapper
     return *this;
   }
 
+  /**
+   * @brief Return the registered object reader instances
+   */
+  const std::vector<ReaderBase *> &
+  getReaders() const;
+
   /**
    * @brief Checks if it is possible to reader next event from the list of files
    *        and, if so, proceeds to read it
@@ -201,6 +210,15 @@ class TTreeWrapper
   bool
   hasNextEvent(bool getEntry = true);
 
+  /**
+   * @brief Read the remaining branches of the event that has been read by hasNextEvent()
+   *
+   * @note Needs to be called for each event that passes the preselection, if the preselection branches have been set;
+   *       does nothing otherwise
+   */
+  void
+  getEntry_remaining();
+
   /**
    * @brief Returns pointer to TTree object in currently processed file
    */
@@ -224,11 +242,61 @@ class TTreeWrapper
   /**
    * @brief Set status to 0 of branches that are never read
    * @param flag Enable/disable the feature
+   *
+   * @note The branches that are read are those returned by ReaderBase::setBranchAddresses of the registered readers
    */
   void
   setBranchStatus(bool flag);
 
+  /**
+   * @brief Open the next input file in a background thread while the current file is processed
+   * @param flag Enable/disable the feature
+   *
+   * @note The background thread opens the file, reads the TTree, sets the basket and cache size
+   *       and, if the cache size is set, trains the TTreeCache on the branches that were bound
+   *       by the readers in the current file and reads the first cluster of baskets into it.
+   *       The branch addresses are still set in the thread that calls hasNextEvent().
+   * @note Requires ROOT::EnableThreadSafety() to be called before the first file is opened.
+   */
+  void
+  setPrefetch(bool flag);
+
+  /**
+   * @brief Read the entries in two stages: hasNextEvent() reads only the given branches,
+   *        while all other bound branches are read by getEntry_remaining(),
+   *        which is supposed to be called only for events that pass a preselection on the given branches
+   * @param branches Branches needed by the preselection; must be bound by one of the registered readers
+   *
+   * @note The branches are read with TBranch::GetEntry, so that the baskets of the other branches are not decompressed
+   *       for events that fail the preselection
+   */
+  void
+  setPreselectionBranches(const std::vector<std::string> & branches);
+
+  /**
+   * @brief Process only the entries in the range [firstEntry, lastEntry), counted across all input files
+   * @param entryIndex Number of entries in each input file; the caller keeps ownership
+   * @param firstEntry Index of the first entry to be processed
+   * @param lastEntry  Index of the entry following the last entry to be processed (-1: process all entries following firstEntry)
+   *
+   * @note The input files preceding the file that contains firstEntry are not opened.
+   *       The number of entries to be processed is limited by both the entry range and maxEvents.
+   *       Needs to be called before the first call to hasNextEvent().
+   */
+  void
+  setEntryRange(const TTreeEntryIndex * entryIndex,
+                long long firstEntry,
+                long long lastEntry = -1);
+
  private:
+  /**
+   * @brief Input file and TTree, as returned by openFile()
+   */
+  struct InputFile
+  {
+    TFile * filePtr_;
+    TTree * treePtr_;
+  };
   unsigned currentFileIdx_;             ///< Index of currently open file
   long long currentEventIdx_;           ///< Index of currently read event (per single file)
   long long currentMaxEvents_;          ///< Total nof events in currently open file/tree
@@ -245,6 +313,50 @@ class TTreeWrapper
   int basketSize_;                      ///< Basket size of all branches
   int cacheSize_;                       ///< Cache size
   bool setBranchStatus_;                ///< Explicitly set the branch status
+  bool prefetch_;                       ///< Open the next file in a background thread
+  std::future<InputFile> nextFile_;     ///< Next file, opened in the background thread
+  unsigned nextFileIdx_;                ///< Index of the file opened in the background thread
+  std::vector<std::string> branches_;   ///< Branches bound by the readers in the current file
+
+  std::vector<std::string> branchesPreselection_;  ///< Branches read by hasNextEvent(), if the entries are read in two stages
+  std::vector<TBranch *> branchPtrsPreselection_;  ///< Pointers to the branches read by hasNextEvent() in the current file
+  std::vector<TBranch *> branchPtrsRemaining_;     ///< Pointers to the branches read by getEntry_remaining() in the current file
+
+  const TTreeEntryIndex * entryIndex_;  ///< Number of entries in each input file, if only a range of entries is processed
+  unsigned firstFileIdx_;               ///< Index of the file that contains the first entry to be processed
+  long long firstEventIdx_;             ///< Index of the first entry to be processed in this file
+
+  /**
+   * @brief Open the file with given index, read the TTree and set the basket and cache size
+   * @param fileIdx       Index of the file in fileNames_
+   * @param branchesCache Branches to be added to the TTreeCache
+   *
+   * @note May be called from the background thread, so it must not access the readers or the current file
+   */
+  InputFile
+  openFile(unsigned fileIdx,
+           const std::vector<std::string> & branchesCache) const;
+
+  /**
+   * @brief Add exactly the given branches to the TTreeCache and end its learning phase
+   * @param treePtr       TTree, for which the cache size has been set
+   * @param branchesCache Branches to be added to the TTreeCache
+   */
+  void
+  trainCache(TTree * treePtr,
+             const std::vector<std::string> & branchesCache) const;
+
+  /**
+   * @brief Start opening the file following the currently open file in the background thread
+   */
+  void
+  prefetchNextFile();
+
+  /**
+   * @brief Wait for the background thread to finish and close the file it opened, if it has not been used
+   */
+  void
+  discardNextFile();
 
   /**
    * @brief Closes a currently open file, if there is any
@@ -13,6 +13,9 @@ enum class Btag
   kDeepJet, kDeepCSV, kCSVv2
 };
 
+//--- number of b-tagging algorithms declared above (needed to dimension arrays indexed by Btag)
+constexpr int kNumBtags = static_cast<int>(Btag::kCSVv2) + 1;
+
 //--- declare pileup jet ID working points
 enum class pileupJetID 
 {
@@ -0,0 +1,105 @@
+#include "TallinnNtupleProducer/CommonTools/interface/StageProfiler.h"
+
+#include <algorithm>     // std::max()
+#include <deque>         // std::deque
+#include <iomanip>       // std::setw(), std::setprecision()
+#include <iostream>      // std::ostream
+#include <map>           // std::map
+#include <memory>        // std::unique_ptr
+#include <mutex>         // std::mutex, std::lock_guard
+#include <unordered_map> // std::unordered_map
+
+namespace
+{
+  /**
+   * @brief Table of stages of one thread
+   */
+  struct StageTable
+  {
+    std::deque<StageProfiler::Stage> stages_; ///< CV: std::deque, so that references to the stages stay valid when new stages are added
+    std::unordered_map<std::string, StageProfiler::Stage *> index_;
+  };
+
+  std::mutex gStageTables_mutex;
+  std::vector<std::unique_ptr<StageTable>> gStageTables; ///< tables of all threads, kept until the end of the job
+  thread_local StageTable * gStageTable = nullptr;       ///< table of the current thread
+}
+
+StageProfiler::Stage::Stage(const std::string & name)
+  : name_(name)
+  , calls_(0)
+  , time_(0)
+{}
+
+StageProfiler::Stage &
+StageProfiler::get(const std::string & name)
+{
+  if(! gStageTable)
+  {
+    std::lock_guard<std::mutex> lock(gStageTables_mutex);
+    gStageTables.emplace_back(new StageTable());
+    gStageTable = gStageTables.back().get();
+  }
+  auto it = gStageTable->index_.find(name);
+  if(it == gStageTable->index_.end())
+  {
+    gStageTable->stages_.emplace_back(name);
+    it = gStageTable->index_.emplace(name, &gStageTable->stages_.back()).first;
+  }
+  return *it->second;
+}
+
+std::vector<StageProfiler::Stage>
+StageProfiler::getStages()
+{
+  std::lock_guard<std::mutex> lock(gStageTables_mutex);
+  std::vector<Stage> stages;
+  std::map<std::string, std::size_t> index;
+  for(const std::unique_ptr<StageTable> & table: gStageTables)
+  {
+    for(const Stage & stage: table->stages_)
+    {
+      auto it = index.find(stage.name_);
+      if(it == index.end())
+      {
+        it = index.emplace(stage.name_, stages.size()).first;
+        stages.emplace_back(stage.name_);
+      }
+      stages[it->second].calls_ += stage.calls_;
+      stages[it->second].time_ += stage.time_;
+    }
+  }
+  return stages;
+}
+
+void
+StageProfiler::print(std::ostream & stream,
+                     long long numEvents)
+{
+  const std::vector<Stage> stages = getStages();
+  std::size_t maxLength = 5;
+  for(const Stage & stage: stages)
+  {
+    maxLength = std::max(maxLength, stage.name_.size());
+  }
+  stream << std::left << std::setw(maxLength) << "stage" << std::right
+         << std::setw(14) << "calls"
+         << std::setw(14) << "total [s]"
+         << std::setw(14) << "mean [us]"
+         << std::setw(14) << "events/s" << '\n';
+  for(const Stage & stage: stages)
+  {
+    stream << std::left << std::setw(maxLength) << stage.name_ << std::right << std::setw(14) << stage.calls_;
+    if(stage.time_ > 0)
+    {
+      const double time = 1.e-9*stage.time_;
+      stream << std::fixed << std::setprecision(3)
+             << std::setw(14) << time
+             << std::setw(14) << (stage.calls_ > 0 ? 1.e+6*time/stage.calls_ : 0.)
+             << std::setprecision(1)
+             << std::setw(14) << numEvents/time;
+      stream.unsetf(std::ios_base::floatfield);
+    }
+    stream << '\n';
+  }
+}
@@ -0,0 +1,119 @@
+#include "TallinnNtupleProducer/CommonTools/interface/SysIdRegistry.h"
+
+#include "TallinnNtupleProducer/CommonTools/interface/cmsException.h" // cmsException()
+
+SysId::SysId()
+  : SysId("central", false)
+{}
+
+SysId::SysId(const std::string & central_or_shift,
+             bool isMC,
+             std::size_t idx)
+  : central_or_shift(central_or_shift)
+  , idx(idx)
+  , isCentral(central_or_shift == "central")
+  , jet_option(getJet_option(central_or_shift, isMC))
+  , met_option(getMET_option(central_or_shift, isMC))
+  , fatJet_option(getFatJet_option(central_or_shift, isMC))
+  , hadTauPt_option(getHadTauPt_option(central_or_shift))
+  , btagWeight_option(getBTagWeight_option(central_or_shift))
+  , pileupJetIDSF_option(getPileupJetIDSFsys_option(central_or_shift))
+  , jetToTauFR_option(getJetToTauFR_option(central_or_shift))
+  , eToTauFR_option(getEToTauFR_option(central_or_shift))
+  , muToTauFR_option(getMuToTauFR_option(central_or_shift))
+  , leptonIDSF_option(getLeptonIDSFsys_option(central_or_shift))
+  , tauIDSF_option(getTauIDSFsys_option(central_or_shift))
+  , triggerSF_lepton_option(getTriggerSF_option(central_or_shift, TriggerSFsysChoice::leptonOnly))
+  , triggerSF_hadTau_option(getTriggerSF_option(central_or_shift, TriggerSFsysChoice::hadTauOnly))
+  , lheScale_option(getLHEscale_option(central_or_shift))
+  , partonShower_option(getPartonShower_option(central_or_shift))
+  , jetToLeptonFR_option(getJetToLeptonFR_option(central_or_shift))
+  , pu_option(getPUsys_option(central_or_shift))
+  , l1PreFiringWeight_option(getL1PreFiringWeightSys_option(central_or_shift))
+  , dyMCReweighting_option(getDYMCReweighting_option(central_or_shift))
+  , dyMCNormScaleFactors_option(getDYMCNormScaleFactors_option(central_or_shift))
+  , topPtReweighting_option(getTopPtReweighting_option(central_or_shift))
+  , ewkJet_option(getEWKJetSys_option(central_or_shift))
+  , ewkBJet_option(getEWKBJetSys_option(central_or_shift))
+  , pdf_option(getPDFSys_option(central_or_shift))
+  , isPDFmember(isPDFsys_member(central_or_shift))
+  , lheVpt_option(getLHEVptSys_option(central_or_shift))
+  , subjetBtag_option(getSubjetBtagSys_option(central_or_shift))
+  , isCentral_FR(jetToLeptonFR_option == kFRl_central && jetToTauFR_option == kFRjt_central)
+{}
+
+SysIdRegistry::SysIdRegistry(bool isMC)
+  : isMC_(isMC)
+{}
+
+SysIdRegistry::SysIdRegistry(const std::vector<std::string> & central_or_shifts,
+                             bool isMC)
+  : SysIdRegistry(isMC)
+{
+  for ( const std::string & central_or_shift : central_or_shifts )
+  {
+    add(central_or_shift);
+  }
+}
+
+SysIdRegistry::~SysIdRegistry()
+{}
+
+const SysId &
+SysIdRegistry::add(const std::string & central_or_shift)
+{
+  auto it = sysIdx_.find(central_or_shift);
+  if ( it != sysIdx_.end() )
+  {
+    return sysIds_[it->second];
+  }
+  checkOptionValidity(central_or_shift, isMC_);
+  const std::size_t idx = sysIds_.size();
+  sysIds_.emplace_back(central_or_shift, isMC_, idx);
+  sysIdx_[central_or_shift] = idx;
+  return sysIds_.back();
+}
+
+const SysId &
+SysIdRegistry::get(const std::string & central_or_shift) const
+{
+  auto it = sysIdx_.find(central_or_shift);
+  if ( it == sysIdx_.end() )
+  {
+    throw cmsException(this, __func__, __LINE__) << "Systematic shift = '" << central_or_shift << "' not registered !!";
+  }
+  return sysIds_[it->second];
+}
+
+const SysId &
+SysIdRegistry::get(std::size_t idx) const
+{
+  if ( idx >= sysIds_.size() )
+  {
+    throw cmsException(this, __func__, __LINE__) << "Invalid index = " << idx << " of systematic shift !!";
+  }
+  return sysIds_[idx];
+}
+
+bool
+SysIdRegistry::has(const std::string & central_or_shift) const
+{
+  return sysIdx_.count(central_or_shift);
+}
+
+std::vector<const SysId *>
+SysIdRegistry::get_sysIds() const
+{
+  std::vector<const SysId *> sysIds;
+  for ( const SysId & sysId : sysIds_ )
+  {
+    sysIds.push_back(&sysId);
+  }
+  return sysIds;
+}
+
+std::size_t
+SysIdRegistry::size() const
+{
+  return sysIds_.size();
+}
@@ -0,0 +1,193 @@
+#include "TallinnNtupleProducer/CommonTools/interface/TTreeEntryIndex.h"
+
+#include "TallinnNtupleProducer/CommonTools/interface/cmsException.h" // cmsException()
+
+#include <TFile.h>                                                    // TFile
+#include <TTree.h>                                                    // TTree
+
+#include <algorithm>                                                  // std::upper_bound()
+#include <assert.h>                                                   // assert()
+#include <fstream>                                                    // std::ifstream, std::ofstream
+#include <iostream>                                                   // std::cout
+#include <iterator>                                                   // std::distance()
+
+TTreeEntryIndex::TTreeEntryIndex(const std::string & treeName,
+                                 const std::vector<std::string> & fileNames,
+                                 const std::string & indexFileName)
+  : treeName_(treeName)
+  , fileNames_(fileNames)
+{
+  if(! indexFileName.empty() && read(indexFileName))
+  {
+    std::cout << "Read entry index of " << fileNames_.size() << " file(s) from " << indexFileName << '\n';
+    return;
+  }
+  build();
+  if(! indexFileName.empty())
+  {
+    write(indexFileName);
+    std::cout << "Wrote entry index of " << fileNames_.size() << " file(s) to " << indexFileName << '\n';
+  }
+}
+
+long long
+TTreeEntryIndex::getEntryCount() const
+{
+  return firstEntries_.back();
+}
+
+long long
+TTreeEntryIndex::getEntryCount(unsigned fileIdx) const
+{
+  assert(fileIdx < fileNames_.size());
+  return firstEntries_[fileIdx + 1] - firstEntries_[fileIdx];
+}
+
+long long
+TTreeEntryIndex::getFirstEntry(unsigned fileIdx) const
+{
+  assert(fileIdx < fileNames_.size());
+  return firstEntries_[fileIdx];
+}
+
+unsigned
+TTreeEntryIndex::getFileIdx(long long entry) const
+{
+  if(entry < 0 || entry >= getEntryCount())
+  {
+    throw cmsException(this, __func__, __LINE__)
+      << "Entry " << entry << " out of range [0, " << getEntryCount() << ")";
+  }
+  // CV: empty files have the same first entry as the following file, so take the last file whose first entry is not after the given entry
+  const auto it = std::upper_bound(firstEntries_.cbegin(), firstEntries_.cend(), entry);
+  return static_cast<unsigned>(std::distance(firstEntries_.cbegin(), it)) - 1;
+}
+
+long long
+TTreeEntryIndex::alignToCluster(long long entry) const
+{
+  if(entry >= getEntryCount())
+  {
+    return getEntryCount();
+  }
+  if(entry <= 0)
+  {
+    return 0;
+  }
+  const auto it = std::upper_bound(clusters_.cbegin(), clusters_.cend(), entry);
+  assert(it != clusters_.cbegin());
+  return *(it - 1);
+}
+
+void
+TTreeEntryIndex::build()
+{
+  firstEntries_.clear();
+  clusters_.clear();
+  long long totalNofEntries = 0;
+  for(const std::string & fileName: fileNames_)
+  {
+    TFile * filePtr = TFile::Open(fileName.c_str(), "READ");
+    if(! filePtr)
+    {
+      throw cmsException(this, __func__, __LINE__) << "Could not open file " << fileName;
+    }
+    if(filePtr -> IsZombie())
+    {
+      throw cmsException(this, __func__, __LINE__)
+        << "The file '" << fileName << "' appears to be a zombie";
+    }
+    TTree * treePtr = static_cast<TTree *>(filePtr -> Get(treeName_.c_str()));
+    if(! treePtr)
+    {
+      throw cmsException(this, __func__, __LINE__)
+        << "The file '" << fileName << "' does not have a TTree named " << treeName_;
+    }
+    const long long nofEntries = treePtr -> GetEntries();
+    firstEntries_.push_back(totalNofEntries);
+    TTree::TClusterIterator clusterIt = treePtr -> GetClusterIterator(0);
+    long long clusterStart = 0;
+    while((clusterStart = clusterIt()) < nofEntries)
+    {
+      clusters_.push_back(totalNofEntries + clusterStart);
+    }
+    totalNofEntries += nofEntries;
+
+    filePtr -> Close();
+    delete filePtr;
+  }
+  firstEntries_.push_back(totalNofEntries);
+}
+
+bool
+TTreeEntryIndex::read(const std::string & indexFileName)
+{
+  std::ifstream indexFile(indexFileName);
+  if(! indexFile)
+  {
+    return false;
+  }
+  std::string treeName;
+  std::size_t numFiles = 0;
+  if(! (indexFile >> treeName >> numFiles) || treeName != treeName_ || numFiles != fileNames_.size())
+  {
+    std::cout << "Entry index in " << indexFileName << " does not match the input files, rebuilding it\n";
+    return false;
+  }
+  std::vector<long long> firstEntries;
+  std::vector<long long> clusters;
+  long long totalNofEntries = 0;
+  for(const std::string & fileName_expected: fileNames_)
+  {
+    std::string fileName;
+    long long nofEntries = 0;
+    std::size_t numClusters = 0;
+    if(! (indexFile >> fileName >> nofEntries >> numClusters) || fileName != fileName_expected)
+    {
+      std::cout << "Entry index in " << indexFileName << " does not match the input files, rebuilding it\n";
+      return false;
+    }
+    firstEntries.push_back(totalNofEntries);
+    for(std::size_t idxCluster = 0; idxCluster < numClusters; ++idxCluster)
+    {
+      long long clusterStart = 0;
+      if(! (indexFile >> clusterStart))
+      {
+        throw cmsException(this, __func__, __LINE__) << "Failed to read entry index from " << indexFileName;
+      }
+      clusters.push_back(totalNofEntries + clusterStart);
+    }
+    totalNofEntries += nofEntries;
+  }
+  firstEntries.push_back(totalNofEntries);
+  firstEntries_ = firstEntries;
+  clusters_ = clusters;
+  return true;
+}
+
+void
+TTreeEntryIndex::write(const std::string & indexFileName) const
+{
+  std::ofstream indexFile(indexFileName);
+  if(! indexFile)
+  {
+    throw cmsException(this, __func__, __LINE__) << "Failed to open " << indexFileName << " for writing";
+  }
+  // CV: one line per input file, with the number of entries and the first entry of each cluster, counted within the file
+  indexFile << treeName_ << ' ' << fileNames_.size() << '\n';
+  std::size_t idxCluster = 0;
+  for(std::size_t idxFile = 0; idxFile < fileNames_.size(); ++idxFile)
+  {
+    std::vector<long long> clusters;
+    for(; idxCluster < clusters_.size() && clusters_[idxCluster] < firstEntries_[idxFile + 1]; ++idxCluster)
+    {
+      clusters.push_back(clusters_[idxCluster] - firstEntries_[idxFile]);
+    }
+    indexFile << fileNames_[idxFile] << ' ' << firstEntries_[idxFile + 1] - firstEntries_[idxFile] << ' ' << clusters.size();
+    for(long long clusterStart: clusters)
+    {
+      indexFile << ' ' << clusterStart;
+    }
+    indexFile << '\n';
+  }
+}
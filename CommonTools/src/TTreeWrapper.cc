@@ -2,12 +2,18 @@
 
 #include "TallinnNtupleProducer/CommonTools/interface/cmsException.h"     // cmsException()
 #include "TallinnNtupleProducer/CommonTools/interface/TFileOpenWrapper.h" // TFileOpenWrapper::
+#include "TallinnNtupleProducer/CommonTools/interface/TTreeEntryIndex.h"  // TTreeEntryIndex
 #include "TallinnNtupleProducer/Readers/interface/ReaderBase.h"           // ReaderBase
 
+#include <TBranch.h>                                                      // TBranch
 #include <TFile.h>                                                        // TFile
 #include <TTree.h>                                                        // TTree
+#include <TTreeCache.h>                                                   // TTreeCache
 
-#include <iostream>                                                       // std::cout
+#include <algorithm>                                                      // std::find(), std::min()
+#include <assert.h>                                                       // assert()
+#include <iostream>                                                       // std::cout, std::cerr
+#include <memory>                                                         // std::unique_ptr
 
 TTreeWrapper::TTreeWrapper()
   : TTreeWrapper("", {})
@@ -31,6 +37,11 @@ TTreeWrapper::TTreeWrapper(const std::string & treeName,
   , basketSize_(-1)
   , cacheSize_(-1)
   , setBranchStatus_(true)
+  , prefetch_(false)
+  , nextFileIdx_(0)
+  , entryIndex_(nullptr)
+  , firstFileIdx_(0)
+  , firstEventIdx_(0)
 {
   if(! treeName_.empty())
   {
@@ -55,14 +66,16 @@ TTreeWrapper::TTreeWrapper(const std::string & treeName,
 
 TTreeWrapper::~TTreeWrapper()
 {
+  discardNextFile();
   close();
 }
 
 void
 TTreeWrapper::reset()
 {
-  currentFileIdx_ = 0;
-  currentEventIdx_ = 0;
+  discardNextFile();
+  currentFileIdx_ = firstFileIdx_;
+  currentEventIdx_ = firstEventIdx_;
   currentMaxEvents_ = -1;
   currentMaxEventIdx_ = 0;
   currentFilePtr_ = nullptr;
@@ -92,7 +105,7 @@ TTreeWrapper::getCumulativeMaxEventCount() const
 int
 TTreeWrapper::getProcessedFileCount() const
 {
-  return currentMaxEventIdx_ > 0 ? currentFileIdx_ + (!!currentFilePtr_ ? 1 : 0) : 0;
+  return currentMaxEventIdx_ > 0 ? currentFileIdx_ - firstFileIdx_ + (!!currentFilePtr_ ? 1 : 0) : 0;
 }
 
 long long
@@ -126,83 +139,117 @@ TTreeWrapper::registerReader(ReaderBase * reader)
   return *this;
 }
 
+const std::vector<ReaderBase *> &
+TTreeWrapper::getReaders() const
+{
+  return readers_;
+}
+
 bool
 TTreeWrapper::hasNextEvent(bool getEntry)
 {
   // check if we already have an open file
   if(! isOpen())
   {
-    // try to open the file
-    if(currentFileIdx_ < fileCount_)
-    {
-      std::cout << "Opening #" << currentFileIdx_ << " file " << fileNames_[currentFileIdx_] << '\n';
-#if 0
-      currentFilePtr_ = TFileOpenWrapper::Open(fileNames_[currentFileIdx_].c_str(), "READ");
-#else
-      currentFilePtr_ = TFile::Open(fileNames_[currentFileIdx_].c_str(), "READ");
-#endif
-    }
-    else
+    if(currentFileIdx_ >= fileCount_)
     {
       // we are out of files
       return false;
     }
 
-    if(! isOpen())
-    {
-      throw cmsException(this, __func__)
-        << "The file '" << fileNames_[currentFileIdx_] << "' failed to open";
-    }
-    if(currentFilePtr_ -> IsZombie())
+    // take the file from the background thread, if it has already been opened there
+    InputFile inputFile;
+    if(nextFile_.valid() && nextFileIdx_ == currentFileIdx_)
     {
-      throw cmsException(this, __func__)
-        << "The file '" << fileNames_[currentFileIdx_] << "' appears to be corrupted";
+      std::cout << "Opening #" << currentFileIdx_ << " file " << fileNames_[currentFileIdx_] << " (prefetched)\n";
+      inputFile = nextFile_.get();
     }
-  }
-
-  // we should have an open file right now
-  if(! currentTreePtr_)
-  {
-    // attempt to read the TTree
-    currentTreePtr_ = static_cast<TTree *>(currentFilePtr_ -> Get(treeName_.c_str()));
-
-    if(! currentTreePtr_)
+    else
     {
-      throw cmsException(this, __func__)
-        << "The file '" << fileNames_[currentFileIdx_] << "' does not have a TTree named "
-        << treeName_;
+      discardNextFile();
+      std::cout << "Opening #" << currentFileIdx_ << " file " << fileNames_[currentFileIdx_] << '\n';
+      inputFile = openFile(currentFileIdx_, branches_);
     }
+    currentFilePtr_ = inputFile.filePtr_;
+    currentTreePtr_ = inputFile.treePtr_;
 
-    // set the basket size different than what the default is only if the user has requested so
-    if(basketSize_ > 0)
-    {
-      currentTreePtr_->SetBasketSize("*", basketSize_);
-    }
-    if(cacheSize_ > 0)
-    {
-      currentTreePtr_->SetCacheSize(cacheSize_);
-    }
     // set the branch addresses
     std::vector<std::string> branches_enable;
     for(ReaderBase * reader: readers_)
     {
       const std::vector<std::string> branches_bound = reader -> setBranchAddresses(currentTreePtr_);
-      branches_enable.insert(branches_enable.end(), branches_bound.begin(), branches_bound.end());
+      for(const std::string & branch_bound: branches_bound)
+      {
+        // CV: the same branch may be reported by several readers that share the gen-level readers
+        if(std::find(branches_enable.cbegin(), branches_enable.cend(), branch_bound) == branches_enable.cend())
+        {
+          branches_enable.push_back(branch_bound);
+        }
+      }
     }
     if(setBranchStatus_)
     {
+      if(branches_enable.empty())
+      {
+        throw cmsException(this, __func__, __LINE__)
+          << "No branches bound by the readers in the file " << fileNames_[currentFileIdx_] << ", refusing to disable all branches";
+      }
       currentTreePtr_->SetBranchStatus("*", 0);
       for(const std::string & branch_enable: branches_enable)
       {
         currentTreePtr_->SetBranchStatus(branch_enable.data(), 1);
       }
     }
+    // CV: the TTreeCache of the first file is trained here, as the bound branches are known only after the branch addresses are set;
+    //     the TTreeCache of subsequent files is trained in openFile() already
+    if(cacheSize_ > 0 && branches_enable != branches_)
+    {
+      trainCache(currentTreePtr_, branches_enable);
+    }
+    branches_ = branches_enable;
+
+    // find the branches that are read in the first resp. second stage, if the entries are read in two stages
+    branchPtrsPreselection_.clear();
+    branchPtrsRemaining_.clear();
+    if(! branchesPreselection_.empty())
+    {
+      for(const std::string & branch_enable: branches_enable)
+      {
+        TBranch * branchPtr = currentTreePtr_->GetBranch(branch_enable.data());
+        assert(branchPtr);
+        if(std::find(branchesPreselection_.cbegin(), branchesPreselection_.cend(), branch_enable) != branchesPreselection_.cend())
+        {
+          branchPtrsPreselection_.push_back(branchPtr);
+        }
+        else
+        {
+          branchPtrsRemaining_.push_back(branchPtr);
+        }
+      }
+      if(branchPtrsPreselection_.size() != branchesPreselection_.size())
+      {
+        throw cmsException(this, __func__, __LINE__)
+          << "Not all of the preselection branches are bound by the readers in the file " << fileNames_[currentFileIdx_];
+      }
+    }
 
     // save the total number of events in this file
     const long long currentMaxEvents = currentTreePtr_ -> GetEntries();
     std::cout << "The file " << fileNames_[currentFileIdx_] << " has " << currentMaxEvents << " entries\n";
+    if(entryIndex_ && currentMaxEvents != entryIndex_->getEntryCount(currentFileIdx_))
+    {
+      throw cmsException(this, __func__, __LINE__)
+        << "The file " << fileNames_[currentFileIdx_] << " has " << currentMaxEvents << " entries,"
+           " but the entry index expects " << entryIndex_->getEntryCount(currentFileIdx_) << " entries";
+    }
     currentMaxEvents_ = currentMaxEvents;
-    cumulativeMaxEventCount_ += currentMaxEvents_;
+    // CV: the entries preceding the first entry of the entry range are skipped
+    cumulativeMaxEventCount_ += currentMaxEvents_ - currentEventIdx_;
+
+    if(prefetch_)
+    {
+      prefetchNextFile();
+    }
   }
 
   // if the TFile and TTree are already opened
@@ -212,7 +259,20 @@ TTreeWrapper::hasNextEvent(bool getEntry)
     if(getEntry)
     {
       // we still have some events to be read here
-      currentTreePtr_ -> GetEntry(currentEventIdx_);
+      if(branchPtrsPreselection_.empty())
+      {
+        currentTreePtr_ -> GetEntry(currentEventIdx_);
+      }
+      else
+      {
+        // CV: read only the branches needed by the preselection;
+        //     the remaining branches are read by getEntry_remaining() for the events that pass the preselection
+        currentTreePtr_ -> LoadTree(currentEventIdx_);
+        for(TBranch * branchPtr: branchPtrsPreselection_)
+        {
+          branchPtr -> GetEntry(currentEventIdx_);
+        }
+      }
       ++currentEventIdx_;
       ++currentMaxEventIdx_;
     }
@@ -229,6 +289,22 @@ TTreeWrapper::hasNextEvent(bool getEntry)
   return true;
 }
 
+void
+TTreeWrapper::getEntry_remaining()
+{
+  if(branchPtrsRemaining_.empty())
+  {
+    return;
+  }
+  // CV: currentEventIdx_ has already been incremented by hasNextEvent()
+  assert(currentTreePtr_ && currentEventIdx_ > 0);
+  const long long eventIdx = currentEventIdx_ - 1;
+  for(TBranch * branchPtr: branchPtrsRemaining_)
+  {
+    branchPtr -> GetEntry(eventIdx);
+  }
+}
+
 TTree *
 TTreeWrapper::getCurrentTree() const
 {
@@ -253,6 +329,160 @@ TTreeWrapper::setBranchStatus(bool flag)
   setBranchStatus_ = flag;
 }
 
+void
+TTreeWrapper::setPrefetch(bool flag)
+{
+  prefetch_ = flag;
+}
+
+void
+TTreeWrapper::setPreselectionBranches(const std::vector<std::string> & branches)
+{
+  branchesPreselection_ = branches;
+}
+
+void
+TTreeWrapper::setEntryRange(const TTreeEntryIndex * entryIndex,
+                            long long firstEntry,
+                            long long lastEntry)
+{
+  assert(entryIndex);
+  const long long entryCount = entryIndex->getEntryCount();
+  if(lastEntry < 0 || lastEntry > entryCount)
+  {
+    lastEntry = entryCount;
+  }
+  if(firstEntry < 0 || firstEntry > lastEntry)
+  {
+    throw cmsException(this, __func__, __LINE__)
+      << "Invalid entry range [" << firstEntry << ", " << lastEntry << ") for " << entryCount << " entries";
+  }
+  entryIndex_ = entryIndex;
+  if(firstEntry < entryCount)
+  {
+    firstFileIdx_ = entryIndex_->getFileIdx(firstEntry);
+    firstEventIdx_ = firstEntry - entryIndex_->getFirstEntry(firstFileIdx_);
+  }
+  else
+  {
+    // CV: empty range at the end of the input files
+    firstFileIdx_ = fileCount_;
+    firstEventIdx_ = 0;
+  }
+  currentFileIdx_ = firstFileIdx_;
+  currentEventIdx_ = firstEventIdx_;
+  const long long numEntries = lastEntry - firstEntry;
+  maxEvents_ = maxEvents_ == -1 ? numEntries : std::min(maxEvents_, numEntries);
+  eventCount_ = entryCount;
+  std::cout << "Processing entries [" << firstEntry << ", " << lastEntry << "),"
+               " starting at entry " << firstEventIdx_ << " of file #" << firstFileIdx_ << '\n';
+}
+
+TTreeWrapper::InputFile
+TTreeWrapper::openFile(unsigned fileIdx,
+                       const std::vector<std::string> & branchesCache) const
+{
+  const std::string & fileName = fileNames_[fileIdx];
+  // CV: the file is owned by filePtr until it is returned, so that it is closed and deleted if an exception is thrown below;
+  //     this matters in particular if the file is opened in the background and discarded afterwards
+#if 0
+  std::unique_ptr<TFile> filePtr(TFileOpenWrapper::Open(fileName.c_str(), "READ"));
+#else
+  std::unique_ptr<TFile> filePtr(TFile::Open(fileName.c_str(), "READ"));
+#endif
+  if(! filePtr)
+  {
+    throw cmsException(this, __func__)
+      << "The file '" << fileName << "' failed to open";
+  }
+  if(filePtr -> IsZombie())
+  {
+    throw cmsException(this, __func__)
+      << "The file '" << fileName << "' appears to be corrupted";
+  }
+
+  // attempt to read the TTree
+  TTree * treePtr = static_cast<TTree *>(filePtr -> Get(treeName_.c_str()));
+  if(! treePtr)
+  {
+    throw cmsException(this, __func__)
+      << "The file '" << fileName << "' does not have a TTree named " << treeName_;
+  }
+
+  // set the basket size different than what the default is only if the user has requested so
+  if(basketSize_ > 0)
+  {
+    treePtr->SetBasketSize("*", basketSize_);
+  }
+  if(cacheSize_ > 0)
+  {
+    treePtr->SetCacheSize(cacheSize_);
+    if(! branchesCache.empty())
+    {
+      // CV: the readers bind the same branches in all files,
+      //     so the TTreeCache can be trained on the branches bound in the previous file,
+      //     and the first cluster of baskets can be read before the first entry is requested
+      trainCache(treePtr, branchesCache);
+      treePtr->LoadTree(0);
+      TTreeCache * treeCache = dynamic_cast<TTreeCache *>(filePtr->GetCacheRead(treePtr));
+      if(treeCache)
+      {
+        treeCache->FillBuffer();
+      }
+    }
+  }
+  return { filePtr.release(), treePtr };
+}
+
+void
+TTreeWrapper::trainCache(TTree * treePtr,
+                         const std::vector<std::string> & branchesCache) const
+{
+  for(const std::string & branchCache: branchesCache)
+  {
+    treePtr->AddBranchToCache(branchCache.data(), false);
+  }
+  treePtr->StopCacheLearningPhase();
+}
+
+void
+TTreeWrapper::prefetchNextFile()
+{
+  const unsigned nextFileIdx = currentFileIdx_ + 1;
+  if(nextFileIdx >= fileCount_ || (maxEvents_ != -1 && cumulativeMaxEventCount_ >= maxEvents_))
+  {
+    // the next file will not be read
+    return;
+  }
+  nextFileIdx_ = nextFileIdx;
+  nextFile_ = std::async(std::launch::async, &TTreeWrapper::openFile, this, nextFileIdx, branches_);
+}
+
+void
+TTreeWrapper::discardNextFile()
+{
+  if(! nextFile_.valid())
+  {
+    return;
+  }
+  try
+  {
+    const InputFile inputFile = nextFile_.get();
+    inputFile.filePtr_ -> Close();
+    delete inputFile.filePtr_;
+  }
+  // CV: the file is not going to be read, so errors encountered when opening it are only reported;
+  //     this function is called from the destructor, so no exception must escape from it
+  catch(const std::exception & exception)
+  {
+    std::cerr << "Warning in <TTreeWrapper::discardNextFile>: ignoring error while opening prefetched file: " << exception.what() << '\n';
+  }
+  catch(...)
+  {
+    std::cerr << "Warning in <TTreeWrapper::discardNextFile>: ignoring unknown error while opening prefetched file\n";
+  }
+}
+
 void
 TTreeWrapper::close()
 {
@@ -270,6 +500,8 @@ TTreeWrapper::close()
     }
 #endif
     currentTreePtr_ = nullptr;
+    branchPtrsPreselection_.clear();
+    branchPtrsRemaining_.clear();
     currentMaxEvents_ = -1;
     currentEventIdx_  =  0;
   }
@@ -278,6 +510,10 @@ TTreeWrapper::close()
 long long
 TTreeWrapper::getEventCount() const
 {
+  if(eventCount_ < 0 && entryIndex_)
+  {
+    eventCount_ = entryIndex_->getEntryCount();
+  }
   // we have to open the files one-by-one and get the event counts
   // in each file separately
   if(eventCount_ < 0)
@@ -288,7 +524,7 @@ TTreeWrapper::getEventCount() const
 #if 0
       TFile * filePtr = TFileOpenWrapper::Open(fileName.c_str(), "READ");
 #else
-      TFile * filePtr = TFile::Open(fileNames_[currentFileIdx_].c_str(), "READ");
+      TFile * filePtr = TFile::Open(fileName.c_str(), "READ");
 #endif
       if(! filePtr)
       {
@@ -644,7 +644,7 @@ getBranchName_jetMET(const std::string & default_branchName,
                      int central_or_shift,
                      bool isPt)
 {
-  static std::map<int, std::string> branchNames_sys;
+  static thread_local std::map<int, std::string> branchNames_sys;
   const bool isJet = boost::starts_with(default_branchName, "Jet");
   const bool isMET = default_branchName == "MET";
   const std::string era_str = ::era_str(era);
@@ -719,7 +719,7 @@ getBranchName_fatJet(const std::string & default_branchName,
 {
   assert(boost::starts_with(default_branchName, "FatJet"));
   const std::string era_str = ::era_str(era);
-  static std::map<int, std::string> branchNames_sys;
+  static thread_local std::map<int, std::string> branchNames_sys;
   branchNames_sys[kFatJet_central_nonNominal] = Form(
     "%s_%s", default_branchName.data(), attribute_name.data()
   );
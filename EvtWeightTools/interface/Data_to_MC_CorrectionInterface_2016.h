@@ -10,13 +10,13 @@ public:
   Data_to_MC_CorrectionInterface_2016(const edm::ParameterSet & cfg);
   ~Data_to_MC_CorrectionInterface_2016() override;
 
+protected:
   //-----------------------------------------------------------------------------
   // data/MC correction for electron and muon trigger efficiency
   double
-  getSF_leptonTriggerEff(TriggerSFsys central_or_shift) const override;
+  comp_leptonTriggerEff(TriggerSFsys central_or_shift) const override;
   //-----------------------------------------------------------------------------
 
-protected:
   // data/MC corrections for efficiencies of single lepton triggers in 2016 data
   vLutWrapperBase effTrigger_1e_data_;
   vLutWrapperBase effTrigger_1e_mc_;
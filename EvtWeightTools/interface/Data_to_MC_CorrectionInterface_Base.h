@@ -5,6 +5,7 @@
 
 #include "TallinnNtupleProducer/CommonTools/interface/sysUncertOptions.h" // FRet, FRmt
 
+#include <map>                                                            // std::map
 #include <string>                                                         // std::string
 #include <vector>                                                         // std::vector
 
@@ -36,6 +37,10 @@ class Data_to_MC_CorrectionInterface_Base
   //-----------------------------------------------------------------------------
   // set leptons, taus, and jets
   // (to be called once per event, before calling any of the getSF.. functions)
+  //
+  // The SFs returned by the getSF.. functions are cached per systematic shift
+  // and are reused until the leptons, taus, or jets they depend on change,
+  // so the set.. functions may be called for every systematic shift of the same event at little cost
   void
   setLeptons(const std::vector<const RecoLepton *> & leptons,
              bool requireChargeMatch = false);
@@ -49,7 +54,7 @@ class Data_to_MC_CorrectionInterface_Base
 
   //-----------------------------------------------------------------------------
   // data/MC correction for electron and muon trigger efficiency
-  virtual double
+  double
   getSF_leptonTriggerEff(TriggerSFsys central_or_shift) const;
   //-----------------------------------------------------------------------------
 
@@ -72,13 +77,13 @@ class Data_to_MC_CorrectionInterface_Base
   //-----------------------------------------------------------------------------
   // data/MC corrections for hadronic tau identification efficiency,
   // and for e->tau and mu->tau misidentification rates
-  virtual double
+  double
   getSF_hadTauID_and_Iso(TauIDSFsys central_or_shift) const;
 
-  virtual double
+  double
   getSF_eToTauFakeRate(FRet central_or_shift) const;
 
-  virtual double
+  double
   getSF_muToTauFakeRate(FRmt central_or_shift) const;
   //-----------------------------------------------------------------------------
 
@@ -89,6 +94,42 @@ class Data_to_MC_CorrectionInterface_Base
   //-----------------------------------------------------------------------------
 
  protected:
+  //-----------------------------------------------------------------------------
+  // compute the SFs returned (and cached) by the getSF.. functions
+  virtual double
+  comp_leptonTriggerEff(TriggerSFsys central_or_shift) const;
+
+  double
+  comp_leptonID_and_Iso_loose(LeptonIDSFsys central_or_shift) const;
+
+  double
+  comp_leptonID_and_Iso_tight_to_loose_woTightCharge(LeptonIDSFsys central_or_shift) const;
+
+  double
+  comp_leptonID_and_Iso_tight_to_loose_wTightCharge(LeptonIDSFsys central_or_shift) const;
+
+  virtual double
+  comp_hadTauID_and_Iso(TauIDSFsys central_or_shift) const;
+
+  virtual double
+  comp_eToTauFakeRate(FRet central_or_shift) const;
+
+  virtual double
+  comp_muToTauFakeRate(FRmt central_or_shift) const;
+
+  double
+  comp_pileupJetID(pileupJetIDSFsys central_or_shift) const;
+  //-----------------------------------------------------------------------------
+
+  void
+  clearCache_leptons();
+
+  void
+  clearCache_hadTaus();
+
+  void
+  clearCache_jets();
+
   double
   getSF_leptonID_and_Iso(std::size_t numLeptons,
                          const std::vector<double> & lepton_pt,
@@ -207,6 +248,21 @@ class Data_to_MC_CorrectionInterface_Base
   std::vector<double> jet_eta_;
   std::vector<bool> jet_isPileup_;
   std::vector<bool> jet_passesPileupJetId_;
+
+  // kinematics and flags of the leptons, taus, and jets given in the last call to setLeptons(), setHadTaus() resp. setJets(),
+  // used to decide whether the cached SFs are still valid
+  std::vector<double> leptonKey_;
+  std::vector<double> hadTauKey_;
+  std::vector<double> jetKey_;
+
+  mutable std::map<TriggerSFsys, double> sfCache_leptonTriggerEff_;
+  mutable std::map<LeptonIDSFsys, double> sfCache_leptonID_and_Iso_loose_;
+  mutable std::map<LeptonIDSFsys, double> sfCache_leptonID_and_Iso_tight_to_loose_woTightCharge_;
+  mutable std::map<LeptonIDSFsys, double> sfCache_leptonID_and_Iso_tight_to_loose_wTightCharge_;
+  mutable std::map<TauIDSFsys, double> sfCache_hadTauID_and_Iso_;
+  mutable std::map<FRet, double> sfCache_eToTauFakeRate_;
+  mutable std::map<FRmt, double> sfCache_muToTauFakeRate_;
+  mutable std::map<pileupJetIDSFsys, double> sfCache_pileupJetID_;
 };
 
 #endif // TallinnNtupleProducer_EvtWeightTools_Data_to_MC_CorrectionInterface_Base_h
@@ -1,9 +1,11 @@
 #ifndef TallinnNtupleProducer_EvtWeightTools_EvtWeightRecorder_h
 #define TallinnNtupleProducer_EvtWeightTools_EvtWeightRecorder_h
 
-#include "FWCore/ParameterSet/interface/ParameterSet.h"          // edm::VParameterSet
+#include "FWCore/ParameterSet/interface/ParameterSet.h"                     // edm::VParameterSet
 
-#include "TallinnNtupleProducer/Objects/interface/GenParticle.h" // GenParticle
+#include "TallinnNtupleProducer/CommonTools/interface/SysIdRegistry.h"      // SysId
+#include "TallinnNtupleProducer/EvtWeightTools/interface/EvtWeightTable.h"  // EvtWeightTable
+#include "TallinnNtupleProducer/Objects/interface/GenParticle.h"            // GenParticle
 
 // forward declarations
 class L1PreFiringWeightReader;
@@ -49,16 +51,47 @@ class EvtWeightRecorder
   EvtWeightRecorder(const std::vector<std::string> & central_or_shifts,
                     const std::string & central_or_shift,
                     bool isMC);
+
+  /**
+   * @brief Same as above, for systematic shifts resolved by a SysIdRegistry at configuration time.
+   *        The getter functions taking a SysId argument avoid the parsing of the systematic shift name for every event.
+   */
+  EvtWeightRecorder(const std::vector<const SysId *> & central_or_shifts,
+                    const SysId & central_or_shift,
+                    bool isMC);
   virtual ~EvtWeightRecorder() {}
 
+  /**
+   * @brief Reset all weights to their values before any weight has been recorded, keeping the memory allocated for them,
+   *        so that one EvtWeightRecorder object can be reused for all events of a job
+   */
+  void
+  reset();
+
+  /**
+   * @brief Same as above, also replacing the systematic shifts for which the weights are recorded by the one given as function argument
+   *
+   * The SysId object given as function argument is identified by its address and must therefore be owned by the SysIdRegistry.
+   */
+  void
+  reset(const SysId & central_or_shift);
+
   double
   get(const std::string & central_or_shift,
       const std::string & bin = "") const;
 
+  double
+  get(const SysId & sysId,
+      const std::string & bin = "") const;
+
   virtual double
   get_inclusive(const std::string & central_or_shift,
                 const std::string & bin = "") const;
 
+  virtual double
+  get_inclusive(const SysId & sysId,
+                const std::string & bin = "") const;
+
   double
   get_genWeight() const;
 
@@ -77,52 +110,95 @@ class EvtWeightRecorder
   double
   get_auxWeight(const std::string & central_or_shift) const;
 
+  double
+  get_auxWeight(const SysId & sysId) const;
+
   double
   get_lumiScale(const std::string & central_or_shift,
                 const std::string & bin = "") const;
 
+  double
+  get_lumiScale(const SysId & sysId,
+                const std::string & bin = "") const;
+
   double
   get_prescaleWeight() const; 
   
   double
   get_btagSFRatio(const std::string & central_or_shift) const;
 
+  double
+  get_btagSFRatio(const SysId & sysId) const;
+
   double
   get_nom_tH_weight(const std::string & central_or_shift) const;
 
+  double
+  get_nom_tH_weight(const SysId & sysId) const;
+
   double
   get_puWeight(const std::string & central_or_shift) const;
 
+  double
+  get_puWeight(const SysId & sysId) const;
+
   double
   get_pileupJetIDSF(const std::string & central_or_shift) const;
 
+  double
+  get_pileupJetIDSF(const SysId & sysId) const;
+
   double
   get_l1PreFiringWeight(const std::string & central_or_shift) const;
 
+  double
+  get_l1PreFiringWeight(const SysId & sysId) const;
+
   double
   get_lheScaleWeight(const std::string & central_or_shift) const;
 
+  double
+  get_lheScaleWeight(const SysId & sysId) const;
+
   double
   get_pdfWeight(const std::string & central_or_shift) const;
 
+  double
+  get_pdfWeight(const SysId & sysId) const;
+
   double
   get_pdfMemberWeight(const std::string & central_or_shift) const;
 
+  double
+  get_pdfMemberWeight(const SysId & sysId) const;
+
   double
   get_psWeight(const std::string & central_or_shift) const;
 
+  double
+  get_psWeight(const SysId & sysId) const;
+
   double
   get_leptonSF() const;
 
   double
   get_leptonIDSF_recoToLoose(const std::string & central_or_shift) const;
 
+  double
+  get_leptonIDSF_recoToLoose(const SysId & sysId) const;
+
   double
   get_leptonIDSF_looseToTight(const std::string & central_or_shift) const;
 
+  double
+  get_leptonIDSF_looseToTight(const SysId & sysId) const;
+
   double
   get_leptonIDSF(const std::string & central_or_shift) const;
 
+  double
+  get_leptonIDSF(const SysId & sysId) const;
+
   double
   get_chargeMisIdProb() const;
 
@@ -132,39 +208,75 @@ class EvtWeightRecorder
   double
   get_data_to_MC_correction(const std::string & central_or_shift) const;
 
+  double
+  get_data_to_MC_correction(const SysId & sysId) const;
+
   double
   get_btag(const std::string & central_or_shift) const;
 
+  double
+  get_btag(const SysId & sysId) const;
+
   double
   get_ewk_jet(const std::string & central_or_shift) const;
 
+  double
+  get_ewk_jet(const SysId & sysId) const;
+
   double
   get_ewk_bjet(const std::string & central_or_shift) const;
 
+  double
+  get_ewk_bjet(const SysId & sysId) const;
+
   double
   get_dy_rwgt(const std::string & central_or_shift) const;
 
+  double
+  get_dy_rwgt(const SysId & sysId) const;
+
   double
   get_dy_norm(const std::string & central_or_shift) const;
 
+  double
+  get_dy_norm(const SysId & sysId) const;
+
   double
   get_toppt_rwgt(const std::string & central_or_shift) const;
 
+  double
+  get_toppt_rwgt(const SysId & sysId) const;
+
   double
   get_LHEVpt(const std::string & central_or_shift) const;
 
+  double
+  get_LHEVpt(const SysId & sysId) const;
+
   double
   get_subjetBtagSF(const std::string & central_or_shift) const;
+
+  double
+  get_subjetBtagSF(const SysId & sysId) const;
   
   double
   get_sf_triggerEff(const std::string & central_or_shift) const;
 
+  double
+  get_sf_triggerEff(const SysId & sysId) const;
+
   virtual double
   get_tauSF(const std::string & central_or_shift) const;
 
+  virtual double
+  get_tauSF(const SysId & sysId) const;
+
   double
   get_FR(const std::string & central_or_shift) const;
 
+  double
+  get_FR(const SysId & sysId) const;
+
   void
   record_genWeight(const EventInfo & eventInfo,
                    bool use_sign_only = false);
@@ -315,6 +427,21 @@ class EvtWeightRecorder
              const EvtWeightRecorder & evtWeightRecorder);
 
  protected:
+  /**
+   * @brief Return SysId for given systematic shift (resolving the options of systematic shifts not recorded by this class once per job)
+   */
+  const SysId &
+  get_sysId(const std::string & central_or_shift) const;
+
+  /**
+   * @brief Return position of given systematic shift in central_or_shifts_, or -1 if the systematic shift is not recorded by this class
+   *
+   * The systematic shift is identified by the address of the SysId object, which is either owned by the SysIdRegistry or returned by get_sysId,
+   * so that the per-event getter functions do not need to compare the names of the systematic shifts.
+   */
+  int
+  get_shiftIdx(const SysId & sysId) const;
+
   void
   record_jetToLepton_FR(const LeptonFakeRateInterface * const leptonFakeRateInterface,
                         const RecoLepton * const lepton,
@@ -322,10 +449,13 @@ class EvtWeightRecorder
 
   bool isMC_;
   double genWeight_;
-  std::map<std::string, double> auxWeight_;
-  std::map<std::string, std::map<std::string, double>> lumiScale_;
-  std::map<std::string, double> nom_tH_weight_;
-  std::map<std::string, double> btagSFRatio_;
+  EvtWeightTable<int> auxWeight_;                                     ///< indexed by position of the systematic shift in central_or_shifts_
+  const edm::VParameterSet * lumiScales_;                             ///< configuration from which lumiScale_ has been filled
+  std::map<std::string, std::map<std::string, double>> lumiScale_;    ///< lumiscale for each systematic shift and bin, filled once per job
+  std::vector<const std::map<std::string, double> *> lumiScale_bins_; ///< entry of lumiScale_ for each systematic shift in central_or_shifts_
+  bool isLumiScale_recorded_;
+  EvtWeightTable<int> nom_tH_weight_;                                 ///< indexed by position of the systematic shift in central_or_shifts_
+  EvtWeightTable<int> btagSFRatio_;                                   ///< indexed by position of the systematic shift in central_or_shifts_
   double leptonSF_;
   double chargeMisIdProb_;
   double dyBgrWeight_;
@@ -333,35 +463,37 @@ class EvtWeightRecorder
   double hhWeight_lo_;
   double hhWeight_nlo_;
   double rescaling_;
-  std::string central_or_shift_;
-  std::vector<std::string> central_or_shifts_;
-
-  std::map<L1PreFiringWeightSys, double> weights_l1PreFiring_;
-  std::map<int, double> weights_lheScale_;
-  std::map<PDFSys, double> weights_pdf_;
+  SysId central_or_shift_;
+  std::vector<SysId> central_or_shifts_;
+  std::vector<const SysId *> sysIds_;                                 ///< SysId objects owned by the SysIdRegistry (nullptr if not resolved by it), parallel to central_or_shifts_
+  mutable std::map<std::string, SysId> sysIds_unrecorded_;            ///< systematic shifts not recorded by this class, resolved by get_sysId
+
+  EvtWeightTable<L1PreFiringWeightSys> weights_l1PreFiring_;
+  EvtWeightTable<int> weights_lheScale_;
+  EvtWeightTable<PDFSys> weights_pdf_;
   std::map<std::string, double> weights_pdf_members_;
-  std::map<int, double> weights_partonShower_;
-  std::map<PUsys, double> weights_pu_;
-  std::map<int, double> weights_dy_norm_;
-  std::map<int, double> weights_dy_rwgt_;
-  std::map<int, double> weights_toppt_rwgt_;
-  std::map<LHEVptSys, double> weights_lhe_vpt_;
-  std::map<SubjetBtagSys, double> weights_subjet_btag_;
-  std::map<int, double> weights_btag_;
-  std::map<pileupJetIDSFsys, double> weights_puJetIDSF_;
-  std::map<TriggerSFsys, double> weights_leptonTriggerEff_;
-  std::map<TriggerSFsys, double> weights_tauTriggerEff_;
-  std::map<LeptonIDSFsys, double> weights_leptonID_and_Iso_recoToLoose_;
-  std::map<LeptonIDSFsys, double> weights_leptonID_and_Iso_looseToTight_;
-  std::map<TauIDSFsys, double> weights_hadTauID_and_Iso_;
-  std::map<FRet, double> weights_eToTauFakeRate_;
-  std::map<FRmt, double> weights_muToTauFakeRate_;
-  std::map<int, double> weights_jetToTauFakeRate_;
-  std::map<int, double> weights_jetToTauSF_;
-  std::map<int, double> weights_jetToLeptonFakeRate_;
-  std::map<std::string, double> weights_FR_;
-  std::map<EWKJetSys, double> weights_ewk_jet_;
-  std::map<EWKBJetSys, double> weights_ewk_bjet_;
+  EvtWeightTable<int> weights_partonShower_;
+  EvtWeightTable<PUsys> weights_pu_;
+  EvtWeightTable<int> weights_dy_norm_;
+  EvtWeightTable<int> weights_dy_rwgt_;
+  EvtWeightTable<int> weights_toppt_rwgt_;
+  EvtWeightTable<LHEVptSys> weights_lhe_vpt_;
+  EvtWeightTable<SubjetBtagSys> weights_subjet_btag_;
+  EvtWeightTable<int> weights_btag_;
+  EvtWeightTable<pileupJetIDSFsys> weights_puJetIDSF_;
+  EvtWeightTable<TriggerSFsys> weights_leptonTriggerEff_;
+  EvtWeightTable<TriggerSFsys> weights_tauTriggerEff_;
+  EvtWeightTable<LeptonIDSFsys> weights_leptonID_and_Iso_recoToLoose_;
+  EvtWeightTable<LeptonIDSFsys> weights_leptonID_and_Iso_looseToTight_;
+  EvtWeightTable<TauIDSFsys> weights_hadTauID_and_Iso_;
+  EvtWeightTable<FRet> weights_eToTauFakeRate_;
+  EvtWeightTable<FRmt> weights_muToTauFakeRate_;
+  EvtWeightTable<int> weights_jetToTauFakeRate_;
+  EvtWeightTable<int> weights_jetToTauSF_;
+  EvtWeightTable<int> weights_jetToLeptonFakeRate_;
+  EvtWeightTable<int> weights_FR_;                                    ///< see comment on central_FR_idx in EvtWeightRecorder.cc
+  EvtWeightTable<EWKJetSys> weights_ewk_jet_;
+  EvtWeightTable<EWKBJetSys> weights_ewk_bjet_;
 };
 
 #endif
@@ -0,0 +1,102 @@
+#ifndef TallinnNtupleProducer_EvtWeightTools_EvtWeightTable_h
+#define TallinnNtupleProducer_EvtWeightTools_EvtWeightTable_h
+
+#include <algorithm> // std::fill()
+#include <assert.h>  // assert()
+#include <cstddef>   // std::size_t
+#include <vector>    // std::vector
+
+/**
+ * @brief Weights of one type of correction (e.g. pileup reweighting), stored in a dense array indexed by the option of the systematic shift
+ *        (an enum such as PUsys or TriggerSFsys, or an int such as the b-tagging option).
+ *
+ * The interface mirrors the subset of std::map used by the EvtWeightRecorder class.
+ * The memory is allocated when an option is recorded for the first time and kept when the weights are cleared,
+ * so that the weights of each event can be recorded without any memory allocations once the first events have been processed.
+ */
+template <typename T>
+class EvtWeightTable
+{
+ public:
+  EvtWeightTable()
+    : numRecorded_(0)
+  {}
+  ~EvtWeightTable() {}
+
+  /**
+   * @brief Mark all weights as not recorded (keeping the capacity of the table)
+   */
+  void
+  clear()
+  {
+    std::fill(isRecorded_.begin(), isRecorded_.end(), 0);
+    numRecorded_ = 0;
+  }
+
+  bool
+  empty() const
+  {
+    return numRecorded_ == 0;
+  }
+
+  bool
+  count(T option) const
+  {
+    const std::size_t idx = index(option);
+    return idx < isRecorded_.size() && isRecorded_[idx];
+  }
+
+  double
+  at(T option) const
+  {
+    assert(count(option));
+    return weights_[index(option)];
+  }
+
+  /**
+   * @brief Return the weight recorded for given option, or the default value given as second function argument if no weight has been recorded
+   */
+  double
+  get(T option,
+      double defaultWeight = 1.) const
+  {
+    const std::size_t idx = index(option);
+    return idx < isRecorded_.size() && isRecorded_[idx] ? weights_[idx] : defaultWeight;
+  }
+
+  /**
+   * @brief Return reference to the weight for given option, marking it as recorded (the weight is initialized to 1 if it was not recorded before)
+   */
+  double &
+  operator[](T option)
+  {
+    const std::size_t idx = index(option);
+    if(idx >= weights_.size())
+    {
+      weights_.resize(idx + 1, 1.);
+      isRecorded_.resize(idx + 1, 0);
+    }
+    if(! isRecorded_[idx])
+    {
+      weights_[idx] = 1.;
+      isRecorded_[idx] = 1;
+      ++numRecorded_;
+    }
+    return weights_[idx];
+  }
+
+ protected:
+  static std::size_t
+  index(T option)
+  {
+    const int idx = static_cast<int>(option);
+    assert(idx >= 0);
+    return static_cast<std::size_t>(idx);
+  }
+
+  std::vector<double> weights_;            ///< weights, indexed by option
+  std::vector<unsigned char> isRecorded_;  ///< flags indicating whether the weight for an option has been recorded for the current event
+  std::size_t numRecorded_;                ///< number of options for which weights have been recorded for the current event
+};
+
+#endif // TallinnNtupleProducer_EvtWeightTools_EvtWeightTable_h
@@ -6,6 +6,7 @@
 #include <Python.h>                                     // PyObject
 
 #include <map>                                          // std::map
+#include <vector>                                       // std::vector
 
 // forward declarations
 class HHCoupling;
@@ -63,6 +64,24 @@ class HHWeightInterfaceLO
                     double cosThetaStar,
                     bool isDEBUG = false) const;
 
+  /**
+   * @brief Get weights resp. reWeights for all coupling scenarios in a single call,
+   *        in the order given by HHWeightInterfaceCouplings::get_bm_names()
+   *
+   * The LO coefficients are looked up once for the (gen_mHH, cos(theta*)) bin of the event
+   * and then contracted with the (precomputed) coupling monomials of all coupling scenarios.
+   * If the python implementation is enabled (Configuration parameter 'usePython'), the weights are computed one by one.
+   */
+  void
+  getWeights(double mHH,
+             double cosThetaStar,
+             std::vector<double> & weights) const;
+
+  void
+  getRelativeWeights(double mHH,
+                     double cosThetaStar,
+                     std::vector<double> & reWeights) const;
+
   /**
    * @brief Get normalization coefficients
    */
@@ -76,9 +95,45 @@ class HHWeightInterfaceLO
   double
   getDenom(double mHH, double cosThetaStar) const;
 
+  /**
+   * @brief Read LO coefficients A1..A15 from coefFile, one line per (gen_mHH, |cos(theta*)|) bin of the denominator histogram
+   */
+  void
+  loadCoefficients(const std::string & coefFilePath);
+
+  /**
+   * @brief Return index of the (gen_mHH, |cos(theta*)|) bin in the table of LO coefficients
+   */
+  int
+  getBin(double mHH, double cosThetaStar) const;
+
+  /**
+   * @brief Compute the 15 monomials of the couplings (kl, kt, c2, cg, c2g),
+   *        which multiply the coefficients A1..A15 in the analytic parametrization of the LO HH cross section (arXiv:1608.06578)
+   */
+  static void
+  getMonomials(const HHCoupling & coupling, double * monomials);
+
+  double
+  getWeight_python(const std::string & bmName, double mHH, double cosThetaStar) const;
+
+  double
+  getNorm_python(const HHCoupling * const coupling) const;
+
   const HHWeightInterfaceCouplings * const couplings_;
   std::map<std::string, double> norm_;
 
+  bool usePython_; ///< evaluate the weights by calling do_weight.py through the embedded python interpreter (for cross-checks)
+
+  static const int numCoefs_ = 15;
+  int numBinsX_;                              ///< number of gen_mHH bins
+  int numBinsY_;                              ///< number of |cos(theta*)| bins
+  std::vector<double> coefs_;                 ///< LO coefficients, numCoefs_ consecutive entries for each bin
+  std::vector<double> denoms_;                ///< content of the denominator histogram, for each bin
+  std::vector<std::string> bmNames_;          ///< names of coupling scenarios
+  std::map<std::string, std::size_t> bmIdx_;  ///< position of coupling scenarios in bmNames_
+  std::vector<double> bmMonomials_;           ///< coupling monomials divided by normalization, numCoefs_ consecutive entries for each coupling scenario
+
   PyObject * modeldata_;
   PyObject * moduleMainString_;
   PyObject * moduleMain_;
@@ -13,9 +13,12 @@
 #include "TallinnNtupleProducer/CommonTools/interface/LocalFileInPath.h" // LocalFileInPath
 
 #include <map>                                                           // std::map
+#include <string>                                                        // std::string
+#include <vector>                                                        // std::vector
 
 // forward declarations
 class HHWeightInterfaceCouplings;
+class TAxis;
 class TH1;
 class TH2;
 
@@ -104,6 +107,24 @@ class HHWeightInterfaceNLO
                                double cosThetaStar,
                                bool isDEBUG = false) const;
 
+ /**
+   * @brief Get weights resp. reWeights for all coupling scenarios in a single call,
+   *        in the order given by HHWeightInterfaceCouplings::get_bm_names()
+   *
+   * The results are the same as calling getWeight_LOtoNLO(...) resp. getRelativeWeight_LOtoNLO(...) for each coupling scenario,
+   * but the (gen_mHH, cos(theta*)) bin is located only once per call and the weights of all coupling scenarios
+   * are read from a contiguous table that is filled when the HHWeightInterfaceNLO object is constructed.
+   */
+  void
+  getWeights_LOtoNLO(double mHH,
+                     double cosThetaStar,
+                     std::vector<double> & weights) const;
+
+  void
+  getRelativeWeights_LOtoNLO(double mHH,
+                             double cosThetaStar,
+                             std::vector<double> & reWeights) const;
+
  /**
    * @brief Get single reWeight
    *
@@ -181,6 +202,20 @@ class HHWeightInterfaceNLO
   get_totalXsec(const std::string & bmName,
                 const std::map<std::string, double> & totalXsec);
 
+  /**
+   * @brief Fill the table of LO-to-NLO weights (for the reweighting mode given by mode_) for all bins and coupling scenarios
+   */
+  void
+  initWeightTable_LOtoNLO();
+
+  /**
+   * @brief Return row of the table of LO-to-NLO weights and the factor by which the entries of that row need to be multiplied
+   */
+  const double *
+  getWeightTableRow_LOtoNLO(double mHH,
+                            double cosThetaStar,
+                            double & factor) const;
+
   const HHWeightInterfaceCouplings * const couplings_;
   const HHWeightInterfaceNLOMode mode_;
 
@@ -207,6 +242,13 @@ class HHWeightInterfaceNLO
   TH2 * sumEvt_;
   int nof_sumEvt_entries_;
 
+  std::vector<std::string> bmNames_;              ///< coupling scenarios, in the order given by HHWeightInterfaceCouplings::get_bm_names()
+  std::size_t idxSM_;                             ///< index of SM in bmNames_
+  const TAxis * weightTable_xAxis_;               ///< binning in gen_mHH of the table of LO-to-NLO weights
+  const TAxis * weightTable_yAxis_;               ///< binning in cos(theta*) of the table of LO-to-NLO weights (nullptr in mode v1)
+  int weightTable_numBinsY_;
+  std::vector<double> weightTable_LOtoNLO_;       ///< LO-to-NLO weights, indexed by [idxBin * bmNames_.size() + idxBM]
+
   Era era_;
   bool apply_coupling_fix_CMS_;
   double max_weight_;
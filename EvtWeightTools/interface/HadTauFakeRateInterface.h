@@ -3,6 +3,7 @@
 
 #include "TallinnNtupleProducer/CommonTools/interface/sysUncertOptions.h"             // kFRjt_*
 #include "TallinnNtupleProducer/EvtWeightTools/interface/HadTauFakeRateWeightEntry.h" // HadTauFakeRateWeightEntry
+#include "TallinnNtupleProducer/EvtWeightTools/interface/ScaleFactorMemo.h"           // ScaleFactorMemo
 
 #include <vector>                                                                     // std::vector
 
@@ -47,6 +48,9 @@ class HadTauFakeRateInterface
   bool isInitialized_third_;
   std::map<int, std::vector<HadTauFakeRateWeightEntry*>> hadTauFakeRateWeights_fourth_;
   bool isInitialized_fourth_;
+
+  // fake-rate weights and SFs computed for previous systematic shifts of the same event
+  mutable ScaleFactorMemo fakeRateMemo_;
 };
 
 #endif // TallinnNtupleProducer_EvtWeightTools_HadTauFakeRateInterface_h
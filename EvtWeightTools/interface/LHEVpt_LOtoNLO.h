@@ -62,8 +62,9 @@ class LHEVpt_LOtoNLO : public ReaderBase
   std::map<UChar_t, IdParams> coefs_;
   bool isDEBUG_;
 
-  static std::map<UChar_t, IdParams> wjets_;
-  static std::map<UChar_t, IdParams> dy_;
+  // CV: the coefficients are const, so that they can be shared by the instances of all threads
+  static const std::map<UChar_t, IdParams> wjets_;
+  static const std::map<UChar_t, IdParams> dy_;
 };
 
 #endif // TallinnNtupleProducer_EvtWeightTools_LHEVpt_LOtoNLO_h
@@ -1,11 +1,12 @@
 #ifndef TallinnNtupleProducer_EvtWeightTools_LeptonFakeRateInterface_h
 #define TallinnNtupleProducer_EvtWeightTools_LeptonFakeRateInterface_h
 
-#include "FWCore/ParameterSet/interface/ParameterSet.h"                   // edm::ParameterSet
+#include "FWCore/ParameterSet/interface/ParameterSet.h"                     // edm::ParameterSet
 
-#include "TallinnNtupleProducer/CommonTools/interface/sysUncertOptions.h" // kFRl_*
+#include "TallinnNtupleProducer/CommonTools/interface/sysUncertOptions.h"   // kFRl_*
+#include "TallinnNtupleProducer/EvtWeightTools/interface/ScaleFactorMemo.h" // ScaleFactorMemo
 
-#include <map>                                                            // std::map
+#include <map>                                                              // std::map
 
 // forward declarations
 class lutWrapperBase;
@@ -35,6 +36,10 @@ class LeptonFakeRateInterface
   std::map<int, lutWrapperBase *> lutFakeRate_e_;
   std::map<int, lutWrapperBase *> lutFakeRate_mu_;
 
+  // fake-rates computed for previous systematic shifts of the same event
+  mutable ScaleFactorMemo fakeRateMemo_e_;
+  mutable ScaleFactorMemo fakeRateMemo_mu_;
+
   bool isDEBUG_;
 };
 
@@ -0,0 +1,55 @@
+#ifndef TallinnNtupleProducer_EvtWeightTools_ScaleFactorMemo_h
+#define TallinnNtupleProducer_EvtWeightTools_ScaleFactorMemo_h
+
+#include <array>   // std::array
+#include <cstddef> // std::size_t
+
+/**
+ * @brief Small cache of fake-rate weights resp. scale-factors, keyed by the pT and |eta| of the object,
+ *        the index of the object in the collection, and the systematic shift.
+ *
+ * Used to avoid re-evaluating the look-up tables for each systematic shift of the same event,
+ * when the shift does not change the kinematics of the object.
+ * Entries are keyed by their input values, so they never need to be invalidated explicitly;
+ * once all slots are used, the oldest entry is overwritten.
+ */
+class ScaleFactorMemo
+{
+ public:
+  ScaleFactorMemo();
+
+  bool
+  get(int idx,
+      double pt,
+      double absEta,
+      int central_or_shift,
+      double & sf) const;
+
+  void
+  set(int idx,
+      double pt,
+      double absEta,
+      int central_or_shift,
+      double sf);
+
+  void
+  clear();
+
+ private:
+  struct Entry
+  {
+    int idx_;
+    int central_or_shift_;
+    double pt_;
+    double absEta_;
+    double sf_;
+  };
+
+  static constexpr std::size_t kCapacity = 16;
+
+  std::array<Entry, kCapacity> entries_;
+  std::size_t numEntries_;
+  std::size_t nextEntry_; ///< slot to be overwritten next, once all slots are used
+};
+
+#endif // TallinnNtupleProducer_EvtWeightTools_ScaleFactorMemo_h
@@ -67,7 +67,7 @@ class SubjetBtagSFInterface
   void
   get_flavors();
 
-  static std::map<int, BTagEntry::JetFlavor> flavorMap_;
+  static const std::map<int, BTagEntry::JetFlavor> flavorMap_; ///< const, so that it can be shared by the instances of all threads
 
   double btag_wp_;
   std::vector<GenParticle> genParticles_;
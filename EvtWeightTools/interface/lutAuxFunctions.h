@@ -6,6 +6,7 @@
 #include "TallinnNtupleProducer/CommonTools/interface/LocalFileInPath.h" // LocalFileInPath
 
 #include <type_traits>                                                   // std::enable_if, std::is_arithmetic
+#include <vector>                                                        // std::vector
 
 // forward declarations
 class TF1;
@@ -62,6 +63,53 @@ getSF_from_TGraph(TGraph * lut,
                   double x,
                   int error_shift);
 
+/**
+ * @brief Flattened copy of a look-up table stored in a TH1, TH2 or TGraph object.
+ *
+ * The bin edges and the bin contents (and errors) are copied into contiguous arrays when the look-up table is loaded,
+ * so that the data/MC scale-factors can be evaluated by binary search, without calls to ROOT.
+ * Values outside the histogram range are assigned to the first or last bin, as in the getSF_from_TH1(...) and getSF_from_TH2(...) functions;
+ * graphs are evaluated by linear interpolation, as in TGraph::Eval().
+ */
+class CompiledLut
+{
+ public:
+  CompiledLut();
+  explicit CompiledLut(const TH1 * lut);
+  explicit CompiledLut(const TH2 * lut);
+  explicit CompiledLut(const TGraph * lut);
+
+  bool
+  isValid() const;
+
+  bool
+  is1D() const;
+
+  double
+  getSF(double x,
+        double y,
+        int error_shift) const;
+
+ private:
+  enum class Type { kUndefined, kTH1, kTH2, kTGraph };
+
+  static int
+  findBin(const std::vector<double> & edges,
+          double x);
+
+  double
+  getSF_graph(double x) const;
+
+  Type type_;
+  std::vector<double> xEdges_;   ///< bin edges in x (x-coordinates of points in case of TGraph)
+  std::vector<double> yEdges_;   ///< bin edges in y (empty in case of TH1 and TGraph)
+  std::vector<double> contents_; ///< bin contents, indexed by [idxBinX * numBinsY + idxBinY] (y-coordinates of points in case of TGraph)
+  std::vector<double> errors_;   ///< bin errors, same indexing as contents_ (empty in case of TGraph)
+  int numBinsY_;
+  double xMin_;                  ///< range of x-axis in case of TGraph
+  double xMax_;
+};
+
 class lutWrapperBase
 {
  public:
@@ -96,6 +144,15 @@ class lutWrapperBase
 
  protected:
   void initialize(int lutType);
+
+  /**
+   * @brief Evaluate compiledLut_, applying the range limits (xMin, xMax, yMin, yMax) in the same way as
+   *        the getSF_private(...) functions of the lutWrapperTH1, lutWrapperTH2 and lutWrapperTGraph classes
+   */
+  double getSF_compiled(double x,
+                        double y,
+                        int error_shift) const;
+
   enum { kUndefined, kPt, kEta, kAbsEta };
 
   std::string inputFileName_;
@@ -109,6 +166,7 @@ class lutWrapperBase
   double yMin_;
   double yMax_;
   int yAction_;
+  CompiledLut compiledLut_; ///< set by the derived classes that support it, evaluated without virtual function call
 
  private:
   virtual double getSF_private(double x,
@@ -112,7 +112,7 @@ Data_to_MC_CorrectionInterface_2016::~Data_to_MC_CorrectionInterface_2016()
 {}
 
 double
-Data_to_MC_CorrectionInterface_2016::getSF_leptonTriggerEff(TriggerSFsys central_or_shift) const
+Data_to_MC_CorrectionInterface_2016::comp_leptonTriggerEff(TriggerSFsys central_or_shift) const
 {
   if(! check_triggerSFsys_opt(central_or_shift))
   {
@@ -123,7 +123,7 @@ Data_to_MC_CorrectionInterface_2017::~Data_to_MC_CorrectionInterface_2017()
 {}
 
 double
-Data_to_MC_CorrectionInterface_2017::getSF_leptonTriggerEff(TriggerSFsys central_or_shift) const
+Data_to_MC_CorrectionInterface_2017::comp_leptonTriggerEff(TriggerSFsys central_or_shift) const
 {
   if(! check_triggerSFsys_opt(central_or_shift))
   {
@@ -104,7 +104,7 @@ Data_to_MC_CorrectionInterface_2018::~Data_to_MC_CorrectionInterface_2018()
 {}
 
 double
-Data_to_MC_CorrectionInterface_2018::getSF_leptonTriggerEff(TriggerSFsys central_or_shift) const
+Data_to_MC_CorrectionInterface_2018::comp_leptonTriggerEff(TriggerSFsys central_or_shift) const
 {
   if(! check_triggerSFsys_opt(central_or_shift))
   {
@@ -22,6 +22,7 @@
 #include <boost/algorithm/string/predicate.hpp>                                                 // boost::ends_with(), boost::starts_with()
 
 #include <assert.h>                                                                             // assert()
+#include <map>                                                                                  // std::map
 
 namespace
 {
@@ -30,6 +31,31 @@ namespace
   {
     return x * x;
   }
+
+  /**
+   * @brief Return SF for given systematic shift from cache, computing it if it is not cached yet
+   */
+  template <typename T,
+            typename F>
+  double
+  getSF_cached(std::map<T, double> & sfCache,
+               T central_or_shift,
+               F compSF,
+               bool isDEBUG)
+  {
+    // CV: always recompute the SF in debug mode, so that the debug output is printed for every systematic shift
+    if(! isDEBUG)
+    {
+      const typename std::map<T, double>::const_iterator sf_iter = sfCache.find(central_or_shift);
+      if(sf_iter != sfCache.end())
+      {
+        return sf_iter->second;
+      }
+    }
+    const double sf = compSF(central_or_shift);
+    sfCache[central_or_shift] = sf;
+    return sf;
+  }
 }
 
 Data_to_MC_CorrectionInterface_Base::Data_to_MC_CorrectionInterface_Base(Era era, const edm::ParameterSet & cfg)
@@ -268,6 +294,7 @@ Data_to_MC_CorrectionInterface_Base::setHadTauSelection(const std::string & hadT
 {
   hadTauSelection_ = get_tau_id_wp_int(hadTauSelection);
   hadTauId_ = get_tau_id_enum(hadTauSelection);
+  clearCache_hadTaus();
 }
 
 void
@@ -294,7 +321,8 @@ Data_to_MC_CorrectionInterface_Base::setLeptons(const std::vector<const RecoLept
   electron_eta_.clear();
   electron_isGenMatched_.clear();
   electron_isTight_.clear();
- 
+
+  std::vector<double> leptonKey;
   for(const RecoLepton * const lepton: leptons)
   {
     lepton_pt_.push_back(lepton->pt());
@@ -331,6 +359,16 @@ Data_to_MC_CorrectionInterface_Base::setLeptons(const std::vector<const RecoLept
     {
       assert(0);
     }
+    const bool isGenMatched = lepton_type_.back() == kMuon ? muon_isGenMatched_.back() : electron_isGenMatched_.back();
+    leptonKey.insert(leptonKey.end(), {
+      static_cast<double>(lepton_type_.back()), lepton->pt(), lepton->cone_pt(), lepton->eta(),
+      static_cast<double>(isGenMatched), static_cast<double>(lepton->isTight())
+    });
+  }
+  if(leptonKey != leptonKey_)
+  {
+    leptonKey_.swap(leptonKey);
+    clearCache_leptons();
   }
 }
 
@@ -353,12 +391,19 @@ Data_to_MC_CorrectionInterface_Base::setHadTaus(const std::vector<const RecoHadT
   hadTau_genPdgId_.clear();
   hadTau_pt_.clear();
   hadTau_absEta_.clear();
+  std::vector<double> hadTauKey;
   for(const RecoHadTau * const hadTau: hadTaus)
   {
     hadTau_genPdgId_.push_back(getHadTau_genPdgId(hadTau));
     hadTau_pt_.push_back(hadTau->pt());
     hadTau_absEta_.push_back(hadTau->absEta());
     ++numHadTaus_;
+    hadTauKey.insert(hadTauKey.end(), { static_cast<double>(hadTau_genPdgId_.back()), hadTau_pt_.back(), hadTau_absEta_.back() });
+  }
+  if(hadTauKey != hadTauKey_)
+  {
+    hadTauKey_.swap(hadTauKey);
+    clearCache_hadTaus();
   }
 }
 
@@ -370,6 +415,7 @@ Data_to_MC_CorrectionInterface_Base::setJets(const std::vector<const RecoJetAK4
   jet_eta_.clear();
   jet_isPileup_.clear();
   jet_passesPileupJetId_.clear();
+  std::vector<double> jetKey;
   for(const RecoJetAK4 * const jet: jets)
   {
     if(! jet->is_PUID_taggable())
@@ -381,12 +427,117 @@ Data_to_MC_CorrectionInterface_Base::setJets(const std::vector<const RecoJetAK4
     jet_isPileup_.push_back(jet->genJet() ? false : true);
     jet_passesPileupJetId_.push_back(jet->passesPUID(pileupJetId_));
     ++numJets_;
+    jetKey.insert(jetKey.end(), {
+      jet_pt_.back(), jet_eta_.back(), static_cast<double>(jet_isPileup_.back()), static_cast<double>(jet_passesPileupJetId_.back())
+    });
+  }
+  if(jetKey != jetKey_)
+  {
+    jetKey_.swap(jetKey);
+    clearCache_jets();
   }
 }
 
+void
+Data_to_MC_CorrectionInterface_Base::clearCache_leptons()
+{
+  sfCache_leptonTriggerEff_.clear();
+  sfCache_leptonID_and_Iso_loose_.clear();
+  sfCache_leptonID_and_Iso_tight_to_loose_woTightCharge_.clear();
+  sfCache_leptonID_and_Iso_tight_to_loose_wTightCharge_.clear();
+}
+
+void
+Data_to_MC_CorrectionInterface_Base::clearCache_hadTaus()
+{
+  // CV: the trigger SFs depend on the number of taus, too
+  sfCache_leptonTriggerEff_.clear();
+  sfCache_hadTauID_and_Iso_.clear();
+  sfCache_eToTauFakeRate_.clear();
+  sfCache_muToTauFakeRate_.clear();
+}
+
+void
+Data_to_MC_CorrectionInterface_Base::clearCache_jets()
+{
+  sfCache_pileupJetID_.clear();
+}
 
 double
 Data_to_MC_CorrectionInterface_Base::getSF_leptonTriggerEff(TriggerSFsys central_or_shift) const
+{
+  return getSF_cached(
+    sfCache_leptonTriggerEff_, central_or_shift,
+    [this](TriggerSFsys option) { return comp_leptonTriggerEff(option); }, isDEBUG_
+  );
+}
+
+double
+Data_to_MC_CorrectionInterface_Base::getSF_leptonID_and_Iso_loose(LeptonIDSFsys central_or_shift) const
+{
+  return getSF_cached(
+    sfCache_leptonID_and_Iso_loose_, central_or_shift,
+    [this](LeptonIDSFsys option) { return comp_leptonID_and_Iso_loose(option); }, isDEBUG_
+  );
+}
+
+double
+Data_to_MC_CorrectionInterface_Base::getSF_leptonID_and_Iso_tight_to_loose_woTightCharge(LeptonIDSFsys central_or_shift) const
+{
+  return getSF_cached(
+    sfCache_leptonID_and_Iso_tight_to_loose_woTightCharge_, central_or_shift,
+    [this](LeptonIDSFsys option) { return comp_leptonID_and_Iso_tight_to_loose_woTightCharge(option); }, isDEBUG_
+  );
+}
+
+double
+Data_to_MC_CorrectionInterface_Base::getSF_leptonID_and_Iso_tight_to_loose_wTightCharge(LeptonIDSFsys central_or_shift) const
+{
+  return getSF_cached(
+    sfCache_leptonID_and_Iso_tight_to_loose_wTightCharge_, central_or_shift,
+    [this](LeptonIDSFsys option) { return comp_leptonID_and_Iso_tight_to_loose_wTightCharge(option); }, isDEBUG_
+  );
+}
+
+double
+Data_to_MC_CorrectionInterface_Base::getSF_hadTauID_and_Iso(TauIDSFsys central_or_shift) const
+{
+  return getSF_cached(
+    sfCache_hadTauID_and_Iso_, central_or_shift,
+    [this](TauIDSFsys option) { return comp_hadTauID_and_Iso(option); }, isDEBUG_
+  );
+}
+
+double
+Data_to_MC_CorrectionInterface_Base::getSF_eToTauFakeRate(FRet central_or_shift) const
+{
+  return getSF_cached(
+    sfCache_eToTauFakeRate_, central_or_shift,
+    [this](FRet option) { return comp_eToTauFakeRate(option); }, isDEBUG_
+  );
+}
+
+double
+Data_to_MC_CorrectionInterface_Base::getSF_muToTauFakeRate(FRmt central_or_shift) const
+{
+  return getSF_cached(
+    sfCache_muToTauFakeRate_, central_or_shift,
+    [this](FRmt option) { return comp_muToTauFakeRate(option); }, isDEBUG_
+  );
+}
+
+double
+Data_to_MC_CorrectionInterface_Base::getSF_pileupJetID(pileupJetIDSFsys central_or_shift) const
+{
+  return getSF_cached(
+    sfCache_pileupJetID_, central_or_shift,
+    [this](pileupJetIDSFsys option) { return comp_pileupJetID(option); }, isDEBUG_
+  );
+}
+
+
+double
+Data_to_MC_CorrectionInterface_Base::comp_leptonTriggerEff(TriggerSFsys central_or_shift) const
 {
   throw cmsException(this, __func__, __LINE__)
     << "Cannot call from base class"
@@ -553,7 +704,7 @@ Data_to_MC_CorrectionInterface_Base::comp_triggerSFsys_opt(double sf,
 }
 
 double
-Data_to_MC_CorrectionInterface_Base::getSF_leptonID_and_Iso_loose(LeptonIDSFsys central_or_shift) const
+Data_to_MC_CorrectionInterface_Base::comp_leptonID_and_Iso_loose(LeptonIDSFsys central_or_shift) const
 {
   const bool sfForTightSelection = false;
   const double recompSF = 0.;
@@ -613,7 +764,7 @@ Data_to_MC_CorrectionInterface_Base::getSF_leptonID_and_Iso_looseToFakeable() co
 }
 
 double
-Data_to_MC_CorrectionInterface_Base::getSF_leptonID_and_Iso_tight_to_loose_woTightCharge(LeptonIDSFsys central_or_shift) const
+Data_to_MC_CorrectionInterface_Base::comp_leptonID_and_Iso_tight_to_loose_woTightCharge(LeptonIDSFsys central_or_shift) const
 {
   const bool sfForTightSelection = true;
   const double recompSF = 0.;
@@ -708,7 +859,7 @@ Data_to_MC_CorrectionInterface_Base::getSF_leptonID_and_Iso_tight_to_loose_woTig
 }
 
 double
-Data_to_MC_CorrectionInterface_Base::getSF_leptonID_and_Iso_tight_to_loose_wTightCharge(LeptonIDSFsys central_or_shift) const
+Data_to_MC_CorrectionInterface_Base::comp_leptonID_and_Iso_tight_to_loose_wTightCharge(LeptonIDSFsys central_or_shift) const
 {
   const bool sfForTightSelection = true;
   const double recompSF = 0.;
@@ -801,7 +952,7 @@ Data_to_MC_CorrectionInterface_Base::getSF_leptonID_and_Iso_tight_to_loose_wTigh
 }
 
 double
-Data_to_MC_CorrectionInterface_Base::getSF_hadTauID_and_Iso(TauIDSFsys central_or_shift) const
+Data_to_MC_CorrectionInterface_Base::comp_hadTauID_and_Iso(TauIDSFsys central_or_shift) const
 {
   double sf = 1.;
   if(applyHadTauSF_)
@@ -832,7 +983,7 @@ Data_to_MC_CorrectionInterface_Base::getSF_hadTauID_and_Iso(TauIDSFsys central_o
 }
 
 double
-Data_to_MC_CorrectionInterface_Base::getSF_eToTauFakeRate(FRet central_or_shift) const
+Data_to_MC_CorrectionInterface_Base::comp_eToTauFakeRate(FRet central_or_shift) const
 {
   double sf = 1.;
   if(applyHadTauSF_)
@@ -862,7 +1013,7 @@ Data_to_MC_CorrectionInterface_Base::getSF_eToTauFakeRate(FRet central_or_shift)
 }
 
 double
-Data_to_MC_CorrectionInterface_Base::getSF_muToTauFakeRate(FRmt central_or_shift) const 
+Data_to_MC_CorrectionInterface_Base::comp_muToTauFakeRate(FRmt central_or_shift) const 
 {
   double sf = 1.;
   if(applyHadTauSF_)
@@ -892,7 +1043,7 @@ Data_to_MC_CorrectionInterface_Base::getSF_muToTauFakeRate(FRmt central_or_shift
 }
 
 double
-Data_to_MC_CorrectionInterface_Base::getSF_pileupJetID(pileupJetIDSFsys central_or_shift) const
+Data_to_MC_CorrectionInterface_Base::comp_pileupJetID(pileupJetIDSFsys central_or_shift) const
 {
   // CV: Compute SF for efficiencies and mistag rates for jets to pass the pileup jet ID, following the recipe provided by the JetMET POG
   // https://twiki.cern.ch/twiki/bin/viewauth/CMS/PileupJetID
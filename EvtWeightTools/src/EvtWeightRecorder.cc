@@ -27,8 +27,16 @@
 
 #include <boost/math/special_functions/sign.hpp>                                                           // boost::math::sign()
 
+#include <algorithm>                                                                                       // std::find(), std::find_if()
 #include <assert.h>                                                                                        // assert()
 
+namespace
+{
+  // CV: the fake-rate weight of all systematic shifts with central jet->lepton and jet->tau fake-rate options is stored at index 0,
+  //     the fake-rate weights of the other systematic shifts are stored at their position in central_or_shifts_ plus one
+  const int central_FR_idx = 0;
+}
+
 EvtWeightRecorder::EvtWeightRecorder()
   : EvtWeightRecorder({ "central" }, "central", false)
 {}
@@ -45,22 +53,154 @@ EvtWeightRecorder::EvtWeightRecorder(const std::vector<std::string> & central_or
   , hhWeight_lo_(1.)
   , hhWeight_nlo_(1.)
   , rescaling_(1.)
-  , central_or_shift_(central_or_shift)
-  , central_or_shifts_(central_or_shifts)
+  , lumiScales_(nullptr)
+  , isLumiScale_recorded_(false)
 {
-  for(const std::string & central_or_shift_option: central_or_shifts_)
+  for(const std::string & central_or_shift_option: central_or_shifts)
   {
     checkOptionValidity(central_or_shift_option, isMC);
+    central_or_shifts_.push_back(SysId(central_or_shift_option, isMC, central_or_shifts_.size()));
+  }
+  // CV: systematic shifts that have not been resolved by a SysIdRegistry are identified by their copy in central_or_shifts_ only
+  sysIds_.assign(central_or_shifts_.size(), nullptr);
+  assert(std::find(central_or_shifts.cbegin(), central_or_shifts.cend(), central_or_shift) != central_or_shifts.cend());
+  central_or_shift_ = get_sysId(central_or_shift);
+  lumiScale_bins_.assign(central_or_shifts_.size(), nullptr);
+}
+
+EvtWeightRecorder::EvtWeightRecorder(const std::vector<const SysId *> & central_or_shifts,
+                                     const SysId & central_or_shift,
+                                     bool isMC)
+  : isMC_(isMC)
+  , genWeight_(1.)
+  , leptonSF_(1.)
+  , chargeMisIdProb_(1.)
+  , dyBgrWeight_(1.)
+  , prescale_(1.)
+  , hhWeight_lo_(1.)
+  , hhWeight_nlo_(1.)
+  , rescaling_(1.)
+  , lumiScales_(nullptr)
+  , isLumiScale_recorded_(false)
+  , central_or_shift_(central_or_shift)
+{
+  // CV: options of systematic shifts have already been resolved (and checked for validity) by the SysIdRegistry
+  for(const SysId * central_or_shift_option: central_or_shifts)
+  {
+    central_or_shifts_.push_back(*central_or_shift_option);
+    sysIds_.push_back(central_or_shift_option);
+  }
+  assert(std::find_if(central_or_shifts_.cbegin(), central_or_shifts_.cend(),
+    [&central_or_shift](const SysId & sysId) { return sysId.central_or_shift == central_or_shift.central_or_shift; }) != central_or_shifts_.cend());
+  lumiScale_bins_.assign(central_or_shifts_.size(), nullptr);
+}
+
+void
+EvtWeightRecorder::reset()
+{
+  genWeight_ = 1.;
+  leptonSF_ = 1.;
+  chargeMisIdProb_ = 1.;
+  dyBgrWeight_ = 1.;
+  prescale_ = 1.;
+  hhWeight_lo_ = 1.;
+  hhWeight_nlo_ = 1.;
+  rescaling_ = 1.;
+  auxWeight_.clear();
+  isLumiScale_recorded_ = false;
+  lumiScale_bins_.assign(central_or_shifts_.size(), nullptr);
+  nom_tH_weight_.clear();
+  btagSFRatio_.clear();
+
+  weights_l1PreFiring_.clear();
+  weights_lheScale_.clear();
+  weights_pdf_.clear();
+  weights_pdf_members_.clear();
+  weights_partonShower_.clear();
+  weights_pu_.clear();
+  weights_dy_norm_.clear();
+  weights_dy_rwgt_.clear();
+  weights_toppt_rwgt_.clear();
+  weights_lhe_vpt_.clear();
+  weights_subjet_btag_.clear();
+  weights_btag_.clear();
+  weights_puJetIDSF_.clear();
+  weights_leptonTriggerEff_.clear();
+  weights_tauTriggerEff_.clear();
+  weights_leptonID_and_Iso_recoToLoose_.clear();
+  weights_leptonID_and_Iso_looseToTight_.clear();
+  weights_hadTauID_and_Iso_.clear();
+  weights_eToTauFakeRate_.clear();
+  weights_muToTauFakeRate_.clear();
+  weights_jetToTauFakeRate_.clear();
+  weights_jetToTauSF_.clear();
+  weights_jetToLeptonFakeRate_.clear();
+  weights_FR_.clear();
+  weights_ewk_jet_.clear();
+  weights_ewk_bjet_.clear();
+}
+
+void
+EvtWeightRecorder::reset(const SysId & central_or_shift)
+{
+  // CV: options of systematic shift have already been resolved (and checked for validity) by the SysIdRegistry
+  // CV: the SysId objects are copied only when the systematic shift changes, i.e. not for every event
+  if(sysIds_.size() != 1 || sysIds_[0] != &central_or_shift)
+  {
+    central_or_shifts_.assign(1, central_or_shift);
+    sysIds_.assign(1, &central_or_shift);
+    central_or_shift_ = central_or_shift;
+  }
+  reset();
+}
+
+const SysId &
+EvtWeightRecorder::get_sysId(const std::string & central_or_shift) const
+{
+  for(const SysId & sysId: central_or_shifts_)
+  {
+    if(sysId.central_or_shift == central_or_shift)
+    {
+      return sysId;
+    }
+  }
+  // CV: systematic shifts that are not recorded by this class are resolved once and cached,
+  //     so that the same SysId object is returned for every event
+  auto sysId_unrecorded = sysIds_unrecorded_.find(central_or_shift);
+  if(sysId_unrecorded == sysIds_unrecorded_.end())
+  {
+    sysId_unrecorded = sysIds_unrecorded_.emplace(central_or_shift, SysId(central_or_shift, isMC_)).first;
   }
-  assert(std::find(central_or_shifts_.cbegin(), central_or_shifts_.cend(), central_or_shift_) != central_or_shifts_.cend());
+  return sysId_unrecorded->second;
+}
+
+int
+EvtWeightRecorder::get_shiftIdx(const SysId & sysId) const
+{
+  // CV: compare addresses of the SysId objects instead of the names of the systematic shifts
+  for(std::size_t shiftIdx = 0; shiftIdx < central_or_shifts_.size(); ++shiftIdx)
+  {
+    if(&sysId == sysIds_[shiftIdx] || &sysId == &central_or_shifts_[shiftIdx])
+    {
+      return shiftIdx;
+    }
+  }
+  return -1;
 }
 
 double
 EvtWeightRecorder::get(const std::string & central_or_shift,
                        const std::string & bin) const
 {
-  double retVal = (isMC_ ? get_inclusive(central_or_shift, bin) * get_data_to_MC_correction(central_or_shift) * get_prescaleWeight() : 1.) *
-         get_FR(central_or_shift) * get_chargeMisIdProb() * get_dyBgrWeight()
+  return get(get_sysId(central_or_shift), bin);
+}
+
+double
+EvtWeightRecorder::get(const SysId & sysId,
+                       const std::string & bin) const
+{
+  double retVal = (isMC_ ? get_inclusive(sysId, bin) * get_data_to_MC_correction(sysId) * get_prescaleWeight() : 1.) *
+         get_FR(sysId) * get_chargeMisIdProb() * get_dyBgrWeight()
   ;
   return retVal;
 }
@@ -69,11 +209,18 @@ double
 EvtWeightRecorder::get_inclusive(const std::string & central_or_shift,
                                  const std::string & bin) const
 {
-  double retVal = isMC_ ? get_genWeight() * get_auxWeight(central_or_shift) * get_lumiScale(central_or_shift, bin) *
-                 get_nom_tH_weight(central_or_shift) * get_puWeight(central_or_shift) *
-                 get_l1PreFiringWeight(central_or_shift) * get_lheScaleWeight(central_or_shift) * get_pdfWeight(central_or_shift) *
-                 get_dy_rwgt(central_or_shift) * get_rescaling() * get_psWeight(central_or_shift) * get_hhWeight() *
-                 get_pdfMemberWeight(central_or_shift) * get_LHEVpt(central_or_shift)
+  return get_inclusive(get_sysId(central_or_shift), bin);
+}
+
+double
+EvtWeightRecorder::get_inclusive(const SysId & sysId,
+                                 const std::string & bin) const
+{
+  double retVal = isMC_ ? get_genWeight() * get_auxWeight(sysId) * get_lumiScale(sysId, bin) *
+                 get_nom_tH_weight(sysId) * get_puWeight(sysId) *
+                 get_l1PreFiringWeight(sysId) * get_lheScaleWeight(sysId) * get_pdfWeight(sysId) *
+                 get_dy_rwgt(sysId) * get_rescaling() * get_psWeight(sysId) * get_hhWeight() *
+                 get_pdfMemberWeight(sysId) * get_LHEVpt(sysId)
                : 1.
   ;
   return retVal;
@@ -112,24 +259,53 @@ EvtWeightRecorder::get_rescaling() const
 double
 EvtWeightRecorder::get_auxWeight(const std::string & central_or_shift) const
 {
-  if(isMC_ && auxWeight_.count(central_or_shift))
-  {
-    return auxWeight_.at(central_or_shift);
-  }
-  return 1.;
+  return get_auxWeight(get_sysId(central_or_shift));
+}
+
+double
+EvtWeightRecorder::get_auxWeight(const SysId & sysId) const
+{
+  const int shiftIdx = get_shiftIdx(sysId);
+  return isMC_ && shiftIdx >= 0 ? auxWeight_.get(shiftIdx) : 1.;
 }
 
 double
 EvtWeightRecorder::get_lumiScale(const std::string & central_or_shift,
                                  const std::string & bin) const
 {
-  if(isMC_ && lumiScale_.count(central_or_shift))
+  return get_lumiScale(get_sysId(central_or_shift), bin);
+}
+
+double
+EvtWeightRecorder::get_lumiScale(const SysId & sysId,
+                                 const std::string & bin) const
+{
+  if(isMC_ && isLumiScale_recorded_)
   {
-    if(! lumiScale_.at(central_or_shift).count(bin))
+    const std::map<std::string, double> * lumiScale_bins = nullptr;
+    const int shiftIdx = get_shiftIdx(sysId);
+    if(shiftIdx >= 0)
+    {
+      lumiScale_bins = lumiScale_bins_[shiftIdx];
+    }
+    else
+    {
+      // CV: systematic shifts that are not recorded by this class are looked up by name
+      const auto lumiScale = lumiScale_.find(sysId.central_or_shift);
+      if(lumiScale != lumiScale_.end())
+      {
+        lumiScale_bins = &lumiScale->second;
+      }
+    }
+    if(lumiScale_bins)
     {
-      throw cmsException(this, __func__, __LINE__) << "No such bin found in lumiscale map: '" << bin << '\'';
+      const auto lumiScale_bin = lumiScale_bins->find(bin);
+      if(lumiScale_bin == lumiScale_bins->end())
+      {
+        throw cmsException(this, __func__, __LINE__) << "No such bin found in lumiscale map: '" << bin << '\'';
+      }
+      return lumiScale_bin->second;
     }
-    return lumiScale_.at(central_or_shift).at(bin);
   }
   return 1.;
 }
@@ -143,100 +319,102 @@ EvtWeightRecorder::get_prescaleWeight() const
 double
 EvtWeightRecorder::get_btagSFRatio(const std::string & central_or_shift) const
 {
-  if(isMC_ && btagSFRatio_.count(central_or_shift))
-  {
-    return btagSFRatio_.at(central_or_shift);
-  }
-  return 1.;
+  return get_btagSFRatio(get_sysId(central_or_shift));
+}
+
+double
+EvtWeightRecorder::get_btagSFRatio(const SysId & sysId) const
+{
+  const int shiftIdx = get_shiftIdx(sysId);
+  return isMC_ && shiftIdx >= 0 ? btagSFRatio_.get(shiftIdx) : 1.;
 }
 
 double
 EvtWeightRecorder::get_nom_tH_weight(const std::string & central_or_shift) const
 {
-  if(isMC_ && nom_tH_weight_.count(central_or_shift))
-  {
-    return nom_tH_weight_.at(central_or_shift);
-  }
-  return 1.;
+  return get_nom_tH_weight(get_sysId(central_or_shift));
+}
+
+double
+EvtWeightRecorder::get_nom_tH_weight(const SysId & sysId) const
+{
+  const int shiftIdx = get_shiftIdx(sysId);
+  return isMC_ && shiftIdx >= 0 ? nom_tH_weight_.get(shiftIdx) : 1.;
 }
 
 double
 EvtWeightRecorder::get_puWeight(const std::string & central_or_shift) const
 {
-  if(isMC_)
-  {
-    const PUsys puSys_option = getPUsys_option(central_or_shift);
-    if(weights_pu_.count(puSys_option))
-    {
-      return  weights_pu_.at(puSys_option);
-    }
-  }
-  return 1.;
+  return get_puWeight(get_sysId(central_or_shift));
+}
+
+double
+EvtWeightRecorder::get_puWeight(const SysId & sysId) const
+{
+  return isMC_ ? weights_pu_.get(sysId.pu_option) : 1.;
 }
 
 double
 EvtWeightRecorder::get_pileupJetIDSF(const std::string & central_or_shift) const
 {
-  if(isMC_)
-  {
-    const pileupJetIDSFsys puJetIDSF_option = getPileupJetIDSFsys_option(central_or_shift);
-    if(weights_puJetIDSF_.count(puJetIDSF_option))
-    {
-      return  weights_puJetIDSF_.at(puJetIDSF_option);
-    }
-  }
-  return 1.;
+  return get_pileupJetIDSF(get_sysId(central_or_shift));
+}
+
+double
+EvtWeightRecorder::get_pileupJetIDSF(const SysId & sysId) const
+{
+  return isMC_ ? weights_puJetIDSF_.get(sysId.pileupJetIDSF_option) : 1.;
 }
 
 double
 EvtWeightRecorder::get_l1PreFiringWeight(const std::string & central_or_shift) const
 {
-  if(isMC_ && ! weights_l1PreFiring_.empty())
-  {
-    const L1PreFiringWeightSys l1PreFire_option = getL1PreFiringWeightSys_option(central_or_shift);
-    if(weights_l1PreFiring_.count(l1PreFire_option))
-    {
-      return weights_l1PreFiring_.at(l1PreFire_option);
-    }
-  }
-  return 1.;
+  return get_l1PreFiringWeight(get_sysId(central_or_shift));
+}
+
+double
+EvtWeightRecorder::get_l1PreFiringWeight(const SysId & sysId) const
+{
+  return isMC_ ? weights_l1PreFiring_.get(sysId.l1PreFiringWeight_option) : 1.;
 }
 
 double
 EvtWeightRecorder::get_lheScaleWeight(const std::string & central_or_shift) const
 {
-  if(isMC_ && ! weights_lheScale_.empty())
-  {
-    const int lheScale_option = getLHEscale_option(central_or_shift);
-    if(weights_lheScale_.count(lheScale_option))
-    {
-      return weights_lheScale_.at(lheScale_option);
-    }
-  }
-  return 1.;
+  return get_lheScaleWeight(get_sysId(central_or_shift));
+}
+
+double
+EvtWeightRecorder::get_lheScaleWeight(const SysId & sysId) const
+{
+  return isMC_ ? weights_lheScale_.get(sysId.lheScale_option) : 1.;
 }
 
 double
 EvtWeightRecorder::get_pdfWeight(const std::string & central_or_shift) const
 {
-  if(isMC_ && ! weights_pdf_.empty())
-  {
-    const PDFSys pdf_option = getPDFSys_option(central_or_shift);
-    if(weights_pdf_.count(pdf_option))
-    {
-      return weights_pdf_.at(pdf_option);
-    }
-  }
-  return 1.;
+  return get_pdfWeight(get_sysId(central_or_shift));
+}
+
+double
+EvtWeightRecorder::get_pdfWeight(const SysId & sysId) const
+{
+  return isMC_ ? weights_pdf_.get(sysId.pdf_option) : 1.;
 }
 
 double
 EvtWeightRecorder::get_pdfMemberWeight(const std::string & central_or_shift) const
 {
-  if(isMC_ && ! weights_pdf_members_.empty() && isPDFsys_member(central_or_shift))
+  return get_pdfMemberWeight(get_sysId(central_or_shift));
+}
+
+double
+EvtWeightRecorder::get_pdfMemberWeight(const SysId & sysId) const
+{
+  if(isMC_ && ! weights_pdf_members_.empty() && sysId.isPDFmember)
   {
-    assert(weights_pdf_members_.count(central_or_shift));
-    return weights_pdf_members_.at(central_or_shift);
+    assert(weights_pdf_members_.count(sysId.central_or_shift));
+    return weights_pdf_members_.at(sysId.central_or_shift);
   }
   return 1.;
 }
@@ -244,147 +422,123 @@ EvtWeightRecorder::get_pdfMemberWeight(const std::string & central_or_shift) con
 double
 EvtWeightRecorder::get_psWeight(const std::string & central_or_shift) const
 {
-  if(isMC_ && ! weights_partonShower_.empty())
-  {
-    const int psWeight_option = getPartonShower_option(central_or_shift);
-    if(weights_partonShower_.count(psWeight_option))
-    {
-      return weights_partonShower_.at(psWeight_option);
-    }
-  }
-  return 1.;
+  return get_psWeight(get_sysId(central_or_shift));
+}
+
+double
+EvtWeightRecorder::get_psWeight(const SysId & sysId) const
+{
+  return isMC_ ? weights_partonShower_.get(sysId.partonShower_option) : 1.;
 }
 
 double
 EvtWeightRecorder::get_btag(const std::string & central_or_shift) const
 {
-  if(isMC_ && ! weights_btag_.empty())
-  {
-    const int jetBtagSF_option = getBTagWeight_option(central_or_shift);
-    if(weights_btag_.count(jetBtagSF_option))
-    {
-      return weights_btag_.at(jetBtagSF_option);
-    }
-  }
-  return 1.;
+  return get_btag(get_sysId(central_or_shift));
+}
+
+double
+EvtWeightRecorder::get_btag(const SysId & sysId) const
+{
+  return isMC_ ? weights_btag_.get(sysId.btagWeight_option) : 1.;
 }
 
 double
 EvtWeightRecorder::get_ewk_jet(const std::string & central_or_shift) const
 {
-  if(isMC_ && ! weights_ewk_jet_.empty())
-  {
-    const EWKJetSys ewk_jet_option = getEWKJetSys_option(central_or_shift);
-    if(weights_ewk_jet_.count(ewk_jet_option))
-    {
-      return weights_ewk_jet_.at(ewk_jet_option);
-    }
-  }
-  return 1.;
+  return get_ewk_jet(get_sysId(central_or_shift));
+}
+
+double
+EvtWeightRecorder::get_ewk_jet(const SysId & sysId) const
+{
+  return isMC_ ? weights_ewk_jet_.get(sysId.ewkJet_option) : 1.;
 }
 
 double
 EvtWeightRecorder::get_ewk_bjet(const std::string & central_or_shift) const
 {
-  if(isMC_ && ! weights_ewk_bjet_.empty())
-  {
-    const EWKBJetSys ewk_bjet_option = getEWKBJetSys_option(central_or_shift);
-    if(weights_ewk_bjet_.count(ewk_bjet_option))
-    {
-      return weights_ewk_bjet_.at(ewk_bjet_option);
-    }
-  }
-  return 1.;
+  return get_ewk_bjet(get_sysId(central_or_shift));
+}
+
+double
+EvtWeightRecorder::get_ewk_bjet(const SysId & sysId) const
+{
+  return isMC_ ? weights_ewk_bjet_.get(sysId.ewkBJet_option) : 1.;
 }
 
 double
 EvtWeightRecorder::get_dy_rwgt(const std::string & central_or_shift) const
 {
-  if(isMC_ && ! weights_dy_rwgt_.empty())
-  {
-    const int dyMCReweighting_option = getDYMCReweighting_option(central_or_shift);
-    if(weights_dy_rwgt_.count(dyMCReweighting_option))
-    {
-      return weights_dy_rwgt_.at(dyMCReweighting_option);
-    }
-  }
-  return 1.;
+  return get_dy_rwgt(get_sysId(central_or_shift));
+}
+
+double
+EvtWeightRecorder::get_dy_rwgt(const SysId & sysId) const
+{
+  return isMC_ ? weights_dy_rwgt_.get(sysId.dyMCReweighting_option) : 1.;
 }
 
 double
 EvtWeightRecorder::get_dy_norm(const std::string & central_or_shift) const
 {
-  if(isMC_ && ! weights_dy_norm_.empty())
-  {
-    const int dyMCNormScaleFactors_option = getDYMCNormScaleFactors_option(central_or_shift);
-    if(weights_dy_norm_.count(dyMCNormScaleFactors_option))
-    {
-      return weights_dy_norm_.at(dyMCNormScaleFactors_option);
-    }
-  }
-  return 1.;
+  return get_dy_norm(get_sysId(central_or_shift));
+}
+
+double
+EvtWeightRecorder::get_dy_norm(const SysId & sysId) const
+{
+  return isMC_ ? weights_dy_norm_.get(sysId.dyMCNormScaleFactors_option) : 1.;
 }
 
 double
 EvtWeightRecorder::get_toppt_rwgt(const std::string & central_or_shift) const
 {
-  if(isMC_ && ! weights_toppt_rwgt_.empty())
-  {
-    const int topPtReweighting_option = getTopPtReweighting_option(central_or_shift);
-    if(weights_toppt_rwgt_.count(topPtReweighting_option))
-    {
-      return weights_toppt_rwgt_.at(topPtReweighting_option);
-    }
-  }
-  return 1.;
+  return get_toppt_rwgt(get_sysId(central_or_shift));
+}
+
+double
+EvtWeightRecorder::get_toppt_rwgt(const SysId & sysId) const
+{
+  return isMC_ ? weights_toppt_rwgt_.get(sysId.topPtReweighting_option) : 1.;
 }
 
 double
 EvtWeightRecorder::get_LHEVpt(const std::string & central_or_shift) const
 {
-  if(isMC_ && ! weights_lhe_vpt_.empty())
-  {
-    const LHEVptSys lhe_vpt_option = getLHEVptSys_option(central_or_shift);
-    if(weights_lhe_vpt_.count(lhe_vpt_option))
-    {
-      return weights_lhe_vpt_.at(lhe_vpt_option);
-    }
-  }
-  return 1.;
+  return get_LHEVpt(get_sysId(central_or_shift));
+}
+
+double
+EvtWeightRecorder::get_LHEVpt(const SysId & sysId) const
+{
+  return isMC_ ? weights_lhe_vpt_.get(sysId.lheVpt_option) : 1.;
 }
 
 double
 EvtWeightRecorder::get_subjetBtagSF(const std::string & central_or_shift) const
 {
-  if(isMC_ && ! weights_subjet_btag_.empty())
-  {
-    const SubjetBtagSys subjet_btag_option = getSubjetBtagSys_option(central_or_shift);
-    if(weights_subjet_btag_.count(subjet_btag_option))
-    {
-      return weights_subjet_btag_.at(subjet_btag_option);
-    }
-  }
-  return 1.;
+  return get_subjetBtagSF(get_sysId(central_or_shift));
+}
+
+double
+EvtWeightRecorder::get_subjetBtagSF(const SysId & sysId) const
+{
+  return isMC_ ? weights_subjet_btag_.get(sysId.subjetBtag_option) : 1.;
 }
 
 double
 EvtWeightRecorder::get_sf_triggerEff(const std::string & central_or_shift) const
 {
-  double sf_triggerEff = 1.;
-  if(isMC_ && (! weights_leptonTriggerEff_.empty() || ! weights_tauTriggerEff_.empty()))
-  {
-    const TriggerSFsys triggerSF_lepton_option = getTriggerSF_option(central_or_shift, TriggerSFsysChoice::leptonOnly);
-    if(weights_leptonTriggerEff_.count(triggerSF_lepton_option))
-    {
-      sf_triggerEff *= weights_leptonTriggerEff_.at(triggerSF_lepton_option);
-    }
-    const TriggerSFsys triggerSF_hadTau_option = getTriggerSF_option(central_or_shift, TriggerSFsysChoice::hadTauOnly);
-    if(weights_tauTriggerEff_.count(triggerSF_hadTau_option))
-    {
-      sf_triggerEff *= weights_tauTriggerEff_.at(triggerSF_hadTau_option);
-    }
-  }
-  return sf_triggerEff;
+  return get_sf_triggerEff(get_sysId(central_or_shift));
+}
+
+double
+EvtWeightRecorder::get_sf_triggerEff(const SysId & sysId) const
+{
+  return isMC_ ? weights_leptonTriggerEff_.get(sysId.triggerSF_lepton_option) * weights_tauTriggerEff_.get(sysId.triggerSF_hadTau_option)
+               : 1.
+  ;
 }
 
 double
@@ -408,10 +562,16 @@ EvtWeightRecorder::get_dyBgrWeight() const
 double
 EvtWeightRecorder::get_data_to_MC_correction(const std::string & central_or_shift) const
 {
-  return isMC_ ? get_sf_triggerEff(central_or_shift) * get_leptonSF() * get_leptonIDSF(central_or_shift) *
-                 get_tauSF(central_or_shift) * get_btag(central_or_shift) * get_dy_norm(central_or_shift) *
-                 get_toppt_rwgt(central_or_shift) * get_ewk_jet(central_or_shift) * get_ewk_bjet(central_or_shift) *
-                 get_btagSFRatio(central_or_shift) * get_pileupJetIDSF(central_or_shift) * get_subjetBtagSF(central_or_shift)
+  return get_data_to_MC_correction(get_sysId(central_or_shift));
+}
+
+double
+EvtWeightRecorder::get_data_to_MC_correction(const SysId & sysId) const
+{
+  return isMC_ ? get_sf_triggerEff(sysId) * get_leptonSF() * get_leptonIDSF(sysId) *
+                 get_tauSF(sysId) * get_btag(sysId) * get_dy_norm(sysId) *
+                 get_toppt_rwgt(sysId) * get_ewk_jet(sysId) * get_ewk_bjet(sysId) *
+                 get_btagSFRatio(sysId) * get_pileupJetIDSF(sysId) * get_subjetBtagSF(sysId)
                : 1.
   ;
 }
@@ -419,44 +579,33 @@ EvtWeightRecorder::get_data_to_MC_correction(const std::string & central_or_shif
 double
 EvtWeightRecorder::get_tauSF(const std::string & central_or_shift) const
 {
-  double tauSF_weight = 1.;
-  if(isMC_)
-  {
-    const TauIDSFsys tauIDSF_option = getTauIDSFsys_option(central_or_shift);
-    if(weights_hadTauID_and_Iso_.count(tauIDSF_option))
-    {
-      tauSF_weight *= weights_hadTauID_and_Iso_.at(tauIDSF_option);
-    }
-    const FRet eToTauFakeRate_option = getEToTauFR_option(central_or_shift);
-    if(weights_eToTauFakeRate_.count(eToTauFakeRate_option))
-    {
-      tauSF_weight *= weights_eToTauFakeRate_.at(eToTauFakeRate_option);
-    }
-    const FRmt muToTauFakeRate_option = getMuToTauFR_option(central_or_shift);
-    if(weights_muToTauFakeRate_.count(muToTauFakeRate_option))
-    {
-      tauSF_weight *= weights_muToTauFakeRate_.at(muToTauFakeRate_option);
-    }
-    const int jetToTauFakeRate_option = getJetToTauFR_option(central_or_shift);
-    if(weights_jetToTauSF_.count(jetToTauFakeRate_option))
-    {
-      tauSF_weight *= weights_jetToTauSF_.at(jetToTauFakeRate_option);
-    }
-  }
-  return tauSF_weight;
+  return get_tauSF(get_sysId(central_or_shift));
+}
+
+double
+EvtWeightRecorder::get_tauSF(const SysId & sysId) const
+{
+  return isMC_ ? weights_hadTauID_and_Iso_.get(sysId.tauIDSF_option) * weights_eToTauFakeRate_.get(sysId.eToTauFR_option) *
+                 weights_muToTauFakeRate_.get(sysId.muToTauFR_option) * weights_jetToTauSF_.get(sysId.jetToTauFR_option)
+               : 1.
+  ;
 }
 
 double
 EvtWeightRecorder::get_FR(const std::string & central_or_shift) const
 {
-  const int jetToLeptonFakeRate_option = getJetToLeptonFR_option(central_or_shift);
-  const int jetToTauFakeRate_option = getJetToTauFR_option(central_or_shift);
-  const std::string weightKey = jetToLeptonFakeRate_option == kFRl_central && jetToTauFakeRate_option == kFRjt_central ? "central" : central_or_shift;
-  if(weights_FR_.count(weightKey))
+  return get_FR(get_sysId(central_or_shift));
+}
+
+double
+EvtWeightRecorder::get_FR(const SysId & sysId) const
+{
+  if(sysId.isCentral_FR)
   {
-    return weights_FR_.at(weightKey);
+    return weights_FR_.get(central_FR_idx);
   }
-  return 1.;
+  const int shiftIdx = get_shiftIdx(sysId);
+  return shiftIdx >= 0 ? weights_FR_.get(shiftIdx + 1) : 1.;
 }
 
 void
@@ -483,10 +632,11 @@ EvtWeightRecorder::record_auxWeight(const EvtWeightManager * const evtWeightMana
 {
   assert(isMC_);
   auxWeight_.clear();
-  for(const std::string & central_or_shift: central_or_shifts_)
+  for(std::size_t shiftIdx = 0; shiftIdx < central_or_shifts_.size(); ++shiftIdx)
   {
-    auxWeight_[central_or_shift] = evtWeightManager->has_central_or_shift(central_or_shift) ?
-      evtWeightManager->getWeight(central_or_shift) :
+    const SysId & sysId = central_or_shifts_[shiftIdx];
+    auxWeight_[shiftIdx] = evtWeightManager->has_central_or_shift(sysId.central_or_shift) ?
+      evtWeightManager->getWeight(sysId.central_or_shift) :
       evtWeightManager->getWeight()
     ;
   }
@@ -498,9 +648,9 @@ EvtWeightRecorder::record_dy_rwgt(const DYMCReweighting * const dyReweighting,
 {
   assert(isMC_);
   weights_dy_rwgt_.clear();
-  for(const std::string & central_or_shift: central_or_shifts_)
+  for(const SysId & sysId: central_or_shifts_)
   {
-    const int dyMCReweighting_option = getDYMCReweighting_option(central_or_shift);
+    const int dyMCReweighting_option = sysId.dyMCReweighting_option;
     if(weights_dy_rwgt_.count(dyMCReweighting_option))
     {
       continue;
@@ -518,9 +668,9 @@ EvtWeightRecorder::record_dy_norm(const DYMCNormScaleFactors * const dyNormScale
 {
   assert(isMC_);
   weights_dy_norm_.clear();
-  for(const std::string & central_or_shift: central_or_shifts_)
+  for(const SysId & sysId: central_or_shifts_)
   {
-    const int dyMCNormScaleFactors_option = getDYMCNormScaleFactors_option(central_or_shift);
+    const int dyMCNormScaleFactors_option = sysId.dyMCNormScaleFactors_option;
     if(weights_dy_norm_.count(dyMCNormScaleFactors_option))
     {
       continue;
@@ -536,9 +686,9 @@ EvtWeightRecorder::record_toppt_rwgt(double sf)
 {
   assert(isMC_);
   weights_toppt_rwgt_.clear();
-  for(const std::string & central_or_shift: central_or_shifts_)
+  for(const SysId & sysId: central_or_shifts_)
   {
-    const int topPtReweighting_option = getTopPtReweighting_option(central_or_shift);
+    const int topPtReweighting_option = sysId.topPtReweighting_option;
     if(weights_toppt_rwgt_.count(topPtReweighting_option))
     {
       continue;
@@ -555,27 +705,32 @@ void
 EvtWeightRecorder::record_lumiScale(const edm::VParameterSet & lumiScales)
 {
   assert(isMC_);
-  lumiScale_.clear();
-  for(const edm::ParameterSet & lumiScale: lumiScales)
+  // CV: the lumi scales do not depend on the event, so the configuration is parsed only when it changes
+  if(&lumiScales != lumiScales_)
   {
-    const std::string central_or_shift = lumiScale.getParameter<std::string>("central_or_shift");
-    const std::string bin = lumiScale.exists("bin") ? lumiScale.getParameter<std::string>("bin") : "";
-    const double nof_events = lumiScale.getParameter<double>("lumi");
-    if(! lumiScale_.count(central_or_shift))
+    lumiScale_.clear();
+    for(const edm::ParameterSet & lumiScale: lumiScales)
     {
-      lumiScale_[central_or_shift] = {};
+      const std::string central_or_shift = lumiScale.getParameter<std::string>("central_or_shift");
+      const std::string bin = lumiScale.exists("bin") ? lumiScale.getParameter<std::string>("bin") : "";
+      const double nof_events = lumiScale.getParameter<double>("lumi");
+      assert(! lumiScale_[central_or_shift].count(bin));
+      lumiScale_[central_or_shift][bin] = nof_events;
     }
-    assert(! lumiScale_.at(central_or_shift).count(bin));
-    lumiScale_[central_or_shift][bin] = nof_events;
+    lumiScales_ = &lumiScales;
   }
-  assert(lumiScale_.count(central_or_shift_));
-  for(const std::string & central_or_shift: central_or_shifts_)
+  const auto lumiScale_central = lumiScale_.find(central_or_shift_.central_or_shift);
+  if(lumiScale_central == lumiScale_.end())
   {
-    if(! lumiScale_.count(central_or_shift))
-    {
-      lumiScale_[central_or_shift] = lumiScale_.at(central_or_shift_);
-    }
+    throw cmsException(this, __func__, __LINE__) << "No lumiscale given for systematic shift '" << central_or_shift_.central_or_shift << '\'';
+  }
+  // CV: systematic shifts without dedicated lumiscale use the lumiscale of the central value
+  for(std::size_t shiftIdx = 0; shiftIdx < central_or_shifts_.size(); ++shiftIdx)
+  {
+    const auto lumiScale = lumiScale_.find(central_or_shifts_[shiftIdx].central_or_shift);
+    lumiScale_bins_[shiftIdx] = lumiScale != lumiScale_.end() ? &lumiScale->second : &lumiScale_central->second;
   }
+  isLumiScale_recorded_ = true;
 }
 
 void
@@ -584,11 +739,11 @@ EvtWeightRecorder::record_btagSFRatio(const BtagSFRatioInterface * const btagSFR
 {
   assert(isMC_);
   btagSFRatio_.clear();
-  for(const std::string & central_or_shift: central_or_shifts_)
+  for(std::size_t shiftIdx = 0; shiftIdx < central_or_shifts_.size(); ++shiftIdx)
   {
-    btagSFRatio_[central_or_shift] = btagSFRatioInterface->get_btagSFRatio(central_or_shift, nselJets);
+    btagSFRatio_[shiftIdx] = btagSFRatioInterface->get_btagSFRatio(central_or_shifts_[shiftIdx].central_or_shift, nselJets);
   }
-  assert(btagSFRatio_.count(central_or_shift_));
+  assert(btagSFRatio_.count(get_shiftIdx(get_sysId(central_or_shift_.central_or_shift))));
 }
 
 void
@@ -603,10 +758,11 @@ EvtWeightRecorder::record_nom_tH_weight(const EventInfo * const eventInfo)
 {
   assert(isMC_);
   nom_tH_weight_.clear();
-  for(const std::string & central_or_shift: central_or_shifts_)
+  for(std::size_t shiftIdx = 0; shiftIdx < central_or_shifts_.size(); ++shiftIdx)
   {
-    nom_tH_weight_[central_or_shift] = eventInfo->has_central_or_shift(central_or_shift) ?
-      eventInfo->genWeight_tH(central_or_shift) :
+    const SysId & sysId = central_or_shifts_[shiftIdx];
+    nom_tH_weight_[shiftIdx] = eventInfo->has_central_or_shift(sysId.central_or_shift) ?
+      eventInfo->genWeight_tH(sysId.central_or_shift) :
       eventInfo->genWeight_tH()
     ;
   }
@@ -624,9 +780,9 @@ EvtWeightRecorder::record_leptonIDSF_recoToLoose(const Data_to_MC_CorrectionInte
 {
   assert(isMC_);
   weights_leptonID_and_Iso_recoToLoose_.clear();
-  for(const std::string & central_or_shift: central_or_shifts_)
+  for(const SysId & sysId: central_or_shifts_)
   {
-    const LeptonIDSFsys leptonIDSF_option = getLeptonIDSFsys_option(central_or_shift);
+    const LeptonIDSFsys leptonIDSF_option = sysId.leptonIDSF_option;
     if(weights_leptonID_and_Iso_recoToLoose_.count(leptonIDSF_option))
     {
       continue;
@@ -641,9 +797,9 @@ EvtWeightRecorder::record_leptonIDSF_looseToTight(const Data_to_MC_CorrectionInt
 {
   assert(isMC_);
   weights_leptonID_and_Iso_looseToTight_.clear();
-  for(const std::string & central_or_shift: central_or_shifts_)
+  for(const SysId & sysId: central_or_shifts_)
   {
-    const LeptonIDSFsys leptonIDSF_option = getLeptonIDSFsys_option(central_or_shift);
+    const LeptonIDSFsys leptonIDSF_option = sysId.leptonIDSF_option;
     if(weights_leptonID_and_Iso_looseToTight_.count(leptonIDSF_option))
     {
       continue;
@@ -662,35 +818,37 @@ EvtWeightRecorder::record_leptonIDSF_looseToTight(const Data_to_MC_CorrectionInt
 double
 EvtWeightRecorder::get_leptonIDSF_recoToLoose(const std::string & central_or_shift) const
 {
-  if(isMC_ && ! weights_leptonID_and_Iso_recoToLoose_.empty())
-  {
-    const LeptonIDSFsys leptonIDSF_option = getLeptonIDSFsys_option(central_or_shift);
-    if(weights_leptonID_and_Iso_recoToLoose_.count(leptonIDSF_option))
-    {
-      return weights_leptonID_and_Iso_recoToLoose_.at(leptonIDSF_option);
-    }
-  }
-  return 1.;
+  return get_leptonIDSF_recoToLoose(get_sysId(central_or_shift));
+}
+
+double
+EvtWeightRecorder::get_leptonIDSF_recoToLoose(const SysId & sysId) const
+{
+  return isMC_ ? weights_leptonID_and_Iso_recoToLoose_.get(sysId.leptonIDSF_option) : 1.;
 }
 
 double
 EvtWeightRecorder::get_leptonIDSF_looseToTight(const std::string & central_or_shift) const
 {
-  if(isMC_ && ! weights_leptonID_and_Iso_looseToTight_.empty())
-  {
-    const LeptonIDSFsys leptonIDSF_option = getLeptonIDSFsys_option(central_or_shift);
-    if(weights_leptonID_and_Iso_looseToTight_.count(leptonIDSF_option))
-    {
-      return weights_leptonID_and_Iso_looseToTight_.at(leptonIDSF_option);
-    }
-  }
-  return 1.;
+  return get_leptonIDSF_looseToTight(get_sysId(central_or_shift));
+}
+
+double
+EvtWeightRecorder::get_leptonIDSF_looseToTight(const SysId & sysId) const
+{
+  return isMC_ ? weights_leptonID_and_Iso_looseToTight_.get(sysId.leptonIDSF_option) : 1.;
 }
 
 double
 EvtWeightRecorder::get_leptonIDSF(const std::string & central_or_shift) const
 {
-  return get_leptonIDSF_recoToLoose(central_or_shift) * get_leptonIDSF_looseToTight(central_or_shift);
+  return get_leptonIDSF(get_sysId(central_or_shift));
+}
+
+double
+EvtWeightRecorder::get_leptonIDSF(const SysId & sysId) const
+{
+  return get_leptonIDSF_recoToLoose(sysId) * get_leptonIDSF_looseToTight(sysId);
 }
 
 void
@@ -749,9 +907,9 @@ EvtWeightRecorder::record_l1PrefireWeight(const L1PreFiringWeightReader * const
 {
   assert(isMC_);
   weights_l1PreFiring_.clear();
-  for(const std::string & central_or_shift: central_or_shifts_)
+  for(const SysId & sysId: central_or_shifts_)
   {
-    const L1PreFiringWeightSys l1PreFire_option = getL1PreFiringWeightSys_option(central_or_shift);
+    const L1PreFiringWeightSys l1PreFire_option = sysId.l1PreFiringWeight_option;
     if(weights_l1PreFiring_.count(l1PreFire_option))
     {
       continue;
@@ -765,9 +923,9 @@ EvtWeightRecorder::record_lheScaleWeight(const LHEInfoReader * const lheInfoRead
 {
   assert(isMC_);
   weights_lheScale_.clear();
-  for(const std::string & central_or_shift: central_or_shifts_)
+  for(const SysId & sysId: central_or_shifts_)
   {
-    const int lheScale_option = getLHEscale_option(central_or_shift);
+    const int lheScale_option = sysId.lheScale_option;
     if(weights_lheScale_.count(lheScale_option))
     {
       continue;
@@ -781,9 +939,9 @@ EvtWeightRecorder::record_pdfWeight(const LHEInfoReader * const lheInfoReader)
 {
   assert(isMC_);
   weights_pdf_.clear();
-  for(const std::string & central_or_shift: central_or_shifts_)
+  for(const SysId & sysId: central_or_shifts_)
   {
-    const PDFSys pdf_option = getPDFSys_option(central_or_shift);
+    const PDFSys pdf_option = sysId.pdf_option;
     if(weights_pdf_.count(pdf_option))
     {
       continue;
@@ -809,9 +967,9 @@ EvtWeightRecorder::record_psWeight(const PSWeightReader * const psWeightReader)
 {
   assert(isMC_);
   weights_partonShower_.clear();
-  for(const std::string & central_or_shift: central_or_shifts_)
+  for(const SysId & sysId: central_or_shifts_)
   {
-    const int psWeight_option = getPartonShower_option(central_or_shift);
+    const int psWeight_option = sysId.partonShower_option;
     if(weights_partonShower_.count(psWeight_option))
     {
       continue;
@@ -825,9 +983,9 @@ EvtWeightRecorder::record_puWeight(const EventInfo * const eventInfo)
 {
   assert(isMC_);
   weights_pu_.clear();
-  for(const std::string & central_or_shift: central_or_shifts_)
+  for(const SysId & sysId: central_or_shifts_)
   {
-    const PUsys puSys_option = getPUsys_option(central_or_shift);
+    const PUsys puSys_option = sysId.pu_option;
     if(weights_pu_.count(puSys_option))
     {
       continue;
@@ -847,9 +1005,9 @@ EvtWeightRecorder::record_pileupJetIDSF(const Data_to_MC_CorrectionInterface_Bas
 {
   assert(isMC_);
   weights_puJetIDSF_.clear();
-  for(const std::string & central_or_shift: central_or_shifts_)
+  for(const SysId & sysId: central_or_shifts_)
   {
-    const pileupJetIDSFsys puJetIDSF_option = getPileupJetIDSFsys_option(central_or_shift);
+    const pileupJetIDSFsys puJetIDSF_option = sysId.pileupJetIDSF_option;
     if(weights_puJetIDSF_.count(puJetIDSF_option))
     {
       continue;
@@ -900,9 +1058,9 @@ EvtWeightRecorder::record_ewk_jet(const std::vector<const RecoJetAK4 *> & jets)
 {
   assert(isMC_);
   weights_ewk_jet_.clear();
-  for(const std::string & central_or_shift: central_or_shifts_)
+  for(const SysId & sysId: central_or_shifts_)
   {
-    const EWKJetSys ewk_jet_option = getEWKJetSys_option(central_or_shift);
+    const EWKJetSys ewk_jet_option = sysId.ewkJet_option;
     if(weights_ewk_jet_.count(ewk_jet_option))
     {
       continue;
@@ -916,9 +1074,9 @@ EvtWeightRecorder::record_ewk_bjet(const std::vector<const RecoJetAK4 *> & bjets
 {
   assert(isMC_);
   weights_ewk_bjet_.clear();
-  for(const std::string & central_or_shift: central_or_shifts_)
+  for(const SysId & sysId: central_or_shifts_)
   {
-    const EWKBJetSys ewk_bjet_option = getEWKBJetSys_option(central_or_shift);
+    const EWKBJetSys ewk_bjet_option = sysId.ewkBJet_option;
     if(weights_ewk_bjet_.count(ewk_bjet_option))
     {
       continue;
@@ -932,9 +1090,9 @@ EvtWeightRecorder::record_LHEVpt(const LHEVpt_LOtoNLO * const lhe_vpt)
 {
   assert(isMC_);
   weights_lhe_vpt_.clear();
-  for(const std::string & central_or_shift: central_or_shifts_)
+  for(const SysId & sysId: central_or_shifts_)
   {
-    const LHEVptSys lhe_vpt_option = getLHEVptSys_option(central_or_shift);
+    const LHEVptSys lhe_vpt_option = sysId.lheVpt_option;
     if(weights_lhe_vpt_.count(lhe_vpt_option))
     {
       continue;
@@ -948,9 +1106,9 @@ EvtWeightRecorder::record_subjetBtagSF(SubjetBtagSFInterface * const subjetBtagS
 {
   assert(isMC_);
   weights_subjet_btag_.clear();
-  for(const std::string & central_or_shift: central_or_shifts_)
+  for(const SysId & sysId: central_or_shifts_)
   {
-    const SubjetBtagSys subjet_btag_option = getSubjetBtagSys_option(central_or_shift);
+    const SubjetBtagSys subjet_btag_option = sysId.subjetBtag_option;
     if(weights_subjet_btag_.count(subjet_btag_option))
     {
       continue;
@@ -979,9 +1137,9 @@ EvtWeightRecorder::record_btagWeight(const std::vector<const RecoJetAK4 *> & jet
 {
   assert(isMC_);
   weights_btag_.clear();
-  for(const std::string & central_or_shift: central_or_shifts_)
+  for(const SysId & sysId: central_or_shifts_)
   {
-    const int jetBtagSF_option = getBTagWeight_option(central_or_shift);
+    const int jetBtagSF_option = sysId.btagWeight_option;
     if(weights_btag_.count(jetBtagSF_option))
     {
       continue;
@@ -995,9 +1153,9 @@ EvtWeightRecorder::record_leptonTriggerEff(const Data_to_MC_CorrectionInterface_
 {
   assert(isMC_);
   weights_leptonTriggerEff_.clear();
-  for(const std::string & central_or_shift: central_or_shifts_)
+  for(const SysId & sysId: central_or_shifts_)
   {
-    const TriggerSFsys triggerSF_option = getTriggerSF_option(central_or_shift, TriggerSFsysChoice::leptonOnly);
+    const TriggerSFsys triggerSF_option = sysId.triggerSF_lepton_option;
     if(weights_leptonTriggerEff_.count(triggerSF_option))
     {
       continue;
@@ -1011,9 +1169,9 @@ EvtWeightRecorder::record_tauTriggerEff(const Data_to_MC_CorrectionInterface_0l_
 {
   assert(isMC_);
   weights_tauTriggerEff_.clear();
-  for(const std::string & central_or_shift: central_or_shifts_)
+  for(const SysId & sysId: central_or_shifts_)
   {
-    const TriggerSFsys triggerSF_option = getTriggerSF_option(central_or_shift, TriggerSFsysChoice::hadTauOnly);
+    const TriggerSFsys triggerSF_option = sysId.triggerSF_hadTau_option;
     if(weights_tauTriggerEff_.count(triggerSF_option))
     {
       continue;
@@ -1027,9 +1185,9 @@ EvtWeightRecorder::record_tauTriggerEff(const Data_to_MC_CorrectionInterface_1l_
 {
   assert(isMC_);
   weights_tauTriggerEff_.clear();
-  for(const std::string & central_or_shift: central_or_shifts_)
+  for(const SysId & sysId: central_or_shifts_)
   {
-    const TriggerSFsys triggerSF_option = getTriggerSF_option(central_or_shift, TriggerSFsysChoice::hadTauOnly);
+    const TriggerSFsys triggerSF_option = sysId.triggerSF_hadTau_option;
     if(weights_tauTriggerEff_.count(triggerSF_option))
     {
       continue;
@@ -1043,9 +1201,9 @@ EvtWeightRecorder::record_tauTriggerEff(const Data_to_MC_CorrectionInterface_1l_
 {
   assert(isMC_);
   weights_tauTriggerEff_.clear();
-  for(const std::string & central_or_shift: central_or_shifts_)
+  for(const SysId & sysId: central_or_shifts_)
   {
-    const TriggerSFsys triggerSF_option = getTriggerSF_option(central_or_shift, TriggerSFsysChoice::hadTauOnly);
+    const TriggerSFsys triggerSF_option = sysId.triggerSF_hadTau_option;
     if(weights_tauTriggerEff_.count(triggerSF_option))
     {
       continue;
@@ -1059,9 +1217,9 @@ EvtWeightRecorder::record_hadTauID_and_Iso(const Data_to_MC_CorrectionInterface_
 {
   assert(isMC_);
   weights_hadTauID_and_Iso_.clear();
-  for(const std::string & central_or_shift: central_or_shifts_)
+  for(const SysId & sysId: central_or_shifts_)
   {
-    const TauIDSFsys tauIDSF_option = getTauIDSFsys_option(central_or_shift);
+    const TauIDSFsys tauIDSF_option = sysId.tauIDSF_option;
     if(weights_hadTauID_and_Iso_.count(tauIDSF_option))
     {
       continue;
@@ -1075,9 +1233,9 @@ EvtWeightRecorder::record_eToTauFakeRate(const Data_to_MC_CorrectionInterface_Ba
 {
   assert(isMC_);
   weights_eToTauFakeRate_.clear();
-  for(const std::string & central_or_shift: central_or_shifts_)
+  for(const SysId & sysId: central_or_shifts_)
   {
-    const FRet eToTauFakeRate_option = getEToTauFR_option(central_or_shift);
+    const FRet eToTauFakeRate_option = sysId.eToTauFR_option;
     if(weights_eToTauFakeRate_.count(eToTauFakeRate_option))
     {
       continue;
@@ -1091,9 +1249,9 @@ EvtWeightRecorder::record_muToTauFakeRate(const Data_to_MC_CorrectionInterface_B
 {
   assert(isMC_);
   weights_muToTauFakeRate_.clear();
-  for(const std::string & central_or_shift: central_or_shifts_)
+  for(const SysId & sysId: central_or_shifts_)
   {
-    const FRmt muToTauFakeRate_option = getMuToTauFR_option(central_or_shift);
+    const FRmt muToTauFakeRate_option = sysId.muToTauFR_option;
     if(weights_muToTauFakeRate_.count(muToTauFakeRate_option))
     {
       continue;
@@ -1108,9 +1266,9 @@ EvtWeightRecorder::record_jetToTauFakeRate(const HadTauFakeRateInterface * const
 {
   assert(hadTauFakeRateInterface);
   weights_jetToTauFakeRate_.clear();
-  for ( auto central_or_shift : central_or_shifts_ )
+  for ( const SysId & sysId : central_or_shifts_ )
   {
-    const int jetToTauFakeRate_option = getJetToTauFR_option(central_or_shift);
+    const int jetToTauFakeRate_option = sysId.jetToTauFR_option;
     if ( weights_jetToTauFakeRate_.count(jetToTauFakeRate_option) )
     {
       continue;
@@ -1138,9 +1296,9 @@ EvtWeightRecorder::record_jetToTauSF(const HadTauFakeRateInterface * const hadTa
 {
   assert(hadTauFakeRateInterface);
   weights_jetToTauSF_.clear();
-  for ( auto central_or_shift : central_or_shifts_ )
+  for ( const SysId & sysId : central_or_shifts_ )
   {
-    const int jetToTauFakeRate_option = getJetToTauFR_option(central_or_shift);
+    const int jetToTauFakeRate_option = sysId.jetToTauFR_option;
     if ( weights_jetToTauSF_.count(jetToTauFakeRate_option) )
     {
       continue;
@@ -1168,9 +1326,9 @@ EvtWeightRecorder::record_jetToLeptonFakeRate(const LeptonFakeRateInterface * co
 {
   assert(leptonFakeRateInterface);
   weights_jetToLeptonFakeRate_.clear();
-  for ( auto central_or_shift : central_or_shifts_ )
+  for ( const SysId & sysId : central_or_shifts_ )
   {
-    const int jetToLeptonFakeRate_option = getJetToLeptonFR_option(central_or_shift);
+    const int jetToLeptonFakeRate_option = sysId.jetToLeptonFR_option;
     if ( weights_jetToLeptonFakeRate_.count(jetToLeptonFakeRate_option) )
     {
       continue;
@@ -1220,18 +1378,19 @@ EvtWeightRecorder::compute_FR()
   assert(! weights_jetToLeptonFakeRate_.empty());
   assert(! weights_jetToTauFakeRate_.empty());
   weights_FR_.clear();
-  for(const std::string & central_or_shift: central_or_shifts_)
+  for(std::size_t shiftIdx = 0; shiftIdx < central_or_shifts_.size(); ++shiftIdx)
   {
-    const int jetToLeptonFakeRate_option = getJetToLeptonFR_option(central_or_shift);
-    const int jetToTauFakeRate_option = getJetToTauFR_option(central_or_shift);
+    const SysId & sysId = central_or_shifts_[shiftIdx];
+    const int jetToLeptonFakeRate_option = sysId.jetToLeptonFR_option;
+    const int jetToTauFakeRate_option = sysId.jetToTauFR_option;
     assert(weights_jetToLeptonFakeRate_.count(jetToLeptonFakeRate_option));
     assert(weights_jetToTauFakeRate_.count(jetToTauFakeRate_option));
-    const std::string weightKey = jetToLeptonFakeRate_option == kFRl_central && jetToTauFakeRate_option == kFRjt_central ? "central" : central_or_shift;
-    if(weights_FR_.count(weightKey))
+    const int weightIdx = sysId.isCentral_FR ? central_FR_idx : static_cast<int>(shiftIdx) + 1;
+    if(weights_FR_.count(weightIdx))
     {
       continue;
     }
-    weights_FR_[weightKey] = weights_jetToLeptonFakeRate_.at(jetToLeptonFakeRate_option)*weights_jetToTauFakeRate_.at(jetToTauFakeRate_option);
+    weights_FR_[weightIdx] = weights_jetToLeptonFakeRate_.at(jetToLeptonFakeRate_option)*weights_jetToTauFakeRate_.at(jetToTauFakeRate_option);
   }
 }
 
@@ -1239,45 +1398,45 @@ std::ostream &
 operator<<(std::ostream & os,
            const EvtWeightRecorder & evtWeightRecorder)
 {
-  for(const std::string & central_or_shift: evtWeightRecorder.central_or_shifts_)
+  for(const SysId & sysId: evtWeightRecorder.central_or_shifts_)
   {
-    os << "central_or_shift = " << central_or_shift                                                       << "\n"
-          "  genWeight             = " << evtWeightRecorder.get_genWeight()                               << "\n"
-          "  HH weight (LO)        = " << evtWeightRecorder.get_hhWeight_lo()                             << "\n"
-          "  HH weight (LO to NLO) = " << evtWeightRecorder.get_hhWeight_nlo()                            << "\n"
-          "  stitching weight      = " << evtWeightRecorder.get_auxWeight(central_or_shift)               << "\n"
-          "  lumiScale             = " << evtWeightRecorder.get_lumiScale(central_or_shift)               << "\n"
-          "  prescale weight       = " << evtWeightRecorder.get_prescaleWeight()                          << "\n"
-          "  btag SF ratio         = " << evtWeightRecorder.get_btagSFRatio(central_or_shift)             << "\n"
-          "  nominal tH weight     = " << evtWeightRecorder.get_nom_tH_weight(central_or_shift)           << "\n"
-          "  PU weight             = " << evtWeightRecorder.get_puWeight(central_or_shift)                << "\n"
-          "  L1 prefiring weight   = " << evtWeightRecorder.get_l1PreFiringWeight(central_or_shift)       << "\n"
-          "  LHE scale weight      = " << evtWeightRecorder.get_lheScaleWeight(central_or_shift)          << "\n"
-          "  parton shower weight  = " << evtWeightRecorder.get_psWeight(central_or_shift)                << "\n"
-          "  DY reweighting weight = " << evtWeightRecorder.get_dy_rwgt(central_or_shift)                 << "\n"
-          "  inclusive weight      = " << evtWeightRecorder.get_inclusive(central_or_shift)               << "\n"
-          "  trigger eff SF        = " << evtWeightRecorder.get_sf_triggerEff(central_or_shift)           << "\n"
-          "  lepton SF             = " << evtWeightRecorder.get_leptonSF()                                << "\n"
-          "  lepton ID SF (loose)  = " << evtWeightRecorder.get_leptonIDSF_recoToLoose(central_or_shift)  << "\n"
-          "  lepton ID SF (tight)  = " << evtWeightRecorder.get_leptonIDSF_looseToTight(central_or_shift) << "\n"
-          "  lepton ID SF          = " << evtWeightRecorder.get_leptonIDSF(central_or_shift)              << "\n"
-          "  tau SF                = " << evtWeightRecorder.get_tauSF(central_or_shift)                   << "\n"
-          "  DY norm weight        = " << evtWeightRecorder.get_dy_norm(central_or_shift)                 << "\n"
-          "  TT pT weight          = " << evtWeightRecorder.get_toppt_rwgt(central_or_shift)              << "\n"
-          "  btag weight           = " << evtWeightRecorder.get_btag(central_or_shift)                    << "\n"
-          "  PU jet ID SF          = " << evtWeightRecorder.get_pileupJetIDSF(central_or_shift)           << "\n"
-          "  EWK jet weight        = " << evtWeightRecorder.get_ewk_jet(central_or_shift)                 << "\n"
-          "  EWK bjet weight       = " << evtWeightRecorder.get_ewk_bjet(central_or_shift)                << "\n"
-          "  data/MC correction    = " << evtWeightRecorder.get_data_to_MC_correction(central_or_shift)   << "\n"
-          "  FR weight             = " << evtWeightRecorder.get_FR(central_or_shift)                      << "\n"
-          "  rescaling             = " << evtWeightRecorder.get_rescaling()                               << "\n"
-          "  charge mis-ID prob    = " << evtWeightRecorder.get_chargeMisIdProb()                         << "\n"
-          "  DY bgr weight         = " << evtWeightRecorder.get_dyBgrWeight()                             << "\n"
-          "  PDF evnelope weight   = " << evtWeightRecorder.get_pdfWeight(central_or_shift)               << "\n"
-          "  PDF member weight     = " << evtWeightRecorder.get_pdfMemberWeight(central_or_shift)         << "\n"
-          "  LHE Vpt weight        = " << evtWeightRecorder.get_LHEVpt(central_or_shift)                  << "\n"
-          "  subjet b-tagging SF   = " << evtWeightRecorder.get_subjetBtagSF(central_or_shift)            << "\n"
-          "  final weight          = " << evtWeightRecorder.get(central_or_shift)                         << '\n'
+    os << "central_or_shift = " << sysId.central_or_shift                                           << "\n"
+          "  genWeight             = " << evtWeightRecorder.get_genWeight()                         << "\n"
+          "  HH weight (LO)        = " << evtWeightRecorder.get_hhWeight_lo()                       << "\n"
+          "  HH weight (LO to NLO) = " << evtWeightRecorder.get_hhWeight_nlo()                      << "\n"
+          "  stitching weight      = " << evtWeightRecorder.get_auxWeight(sysId)                    << "\n"
+          "  lumiScale             = " << evtWeightRecorder.get_lumiScale(sysId)                    << "\n"
+          "  prescale weight       = " << evtWeightRecorder.get_prescaleWeight()                    << "\n"
+          "  btag SF ratio         = " << evtWeightRecorder.get_btagSFRatio(sysId)                  << "\n"
+          "  nominal tH weight     = " << evtWeightRecorder.get_nom_tH_weight(sysId)                << "\n"
+          "  PU weight             = " << evtWeightRecorder.get_puWeight(sysId)                     << "\n"
+          "  L1 prefiring weight   = " << evtWeightRecorder.get_l1PreFiringWeight(sysId)            << "\n"
+          "  LHE scale weight      = " << evtWeightRecorder.get_lheScaleWeight(sysId)               << "\n"
+          "  parton shower weight  = " << evtWeightRecorder.get_psWeight(sysId)                     << "\n"
+          "  DY reweighting weight = " << evtWeightRecorder.get_dy_rwgt(sysId)                      << "\n"
+          "  inclusive weight      = " << evtWeightRecorder.get_inclusive(sysId)                    << "\n"
+          "  trigger eff SF        = " << evtWeightRecorder.get_sf_triggerEff(sysId)                << "\n"
+          "  lepton SF             = " << evtWeightRecorder.get_leptonSF()                          << "\n"
+          "  lepton ID SF (loose)  = " << evtWeightRecorder.get_leptonIDSF_recoToLoose(sysId)       << "\n"
+          "  lepton ID SF (tight)  = " << evtWeightRecorder.get_leptonIDSF_looseToTight(sysId)      << "\n"
+          "  lepton ID SF          = " << evtWeightRecorder.get_leptonIDSF(sysId)                   << "\n"
+          "  tau SF                = " << evtWeightRecorder.get_tauSF(sysId)                        << "\n"
+          "  DY norm weight        = " << evtWeightRecorder.get_dy_norm(sysId)                      << "\n"
+          "  TT pT weight          = " << evtWeightRecorder.get_toppt_rwgt(sysId)                   << "\n"
+          "  btag weight           = " << evtWeightRecorder.get_btag(sysId)                         << "\n"
+          "  PU jet ID SF          = " << evtWeightRecorder.get_pileupJetIDSF(sysId)                << "\n"
+          "  EWK jet weight        = " << evtWeightRecorder.get_ewk_jet(sysId)                      << "\n"
+          "  EWK bjet weight       = " << evtWeightRecorder.get_ewk_bjet(sysId)                     << "\n"
+          "  data/MC correction    = " << evtWeightRecorder.get_data_to_MC_correction(sysId)        << "\n"
+          "  FR weight             = " << evtWeightRecorder.get_FR(sysId)                           << "\n"
+          "  rescaling             = " << evtWeightRecorder.get_rescaling()                         << "\n"
+          "  charge mis-ID prob    = " << evtWeightRecorder.get_chargeMisIdProb()                   << "\n"
+          "  DY bgr weight         = " << evtWeightRecorder.get_dyBgrWeight()                       << "\n"
+          "  PDF evnelope weight   = " << evtWeightRecorder.get_pdfWeight(sysId)                    << "\n"
+          "  PDF member weight     = " << evtWeightRecorder.get_pdfMemberWeight(sysId)              << "\n"
+          "  LHE Vpt weight        = " << evtWeightRecorder.get_LHEVpt(sysId)                       << "\n"
+          "  subjet b-tagging SF   = " << evtWeightRecorder.get_subjetBtagSF(sysId)                 << "\n"
+          "  final weight          = " << evtWeightRecorder.get(sysId)                              << '\n'
    ;
   }
   return os;
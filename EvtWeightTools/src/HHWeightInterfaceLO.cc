@@ -6,58 +6,49 @@
 
 #include <TH2.h>                                                                       // TH2
 
+#include <boost/algorithm/string/trim.hpp>                                             // boost::trim_copy()
+
+#include <algorithm>                                                                   // std::min(), std::max()
+#include <cmath>                                                                       // std::fabs()
 #include <fstream>                                                                     // std::ifstream
 #include <iostream>                                                                    // std::cerr, std::fixed
+#include <sstream>                                                                     // std::istringstream
 #include <streambuf>                                                                   // std::istreambuf_iterator
 
+namespace
+{
+  double
+  dot(const double * monomials,
+      const double * coefs,
+      int numCoefs)
+  {
+    double sum = 0.;
+    for(int idxCoef = 0; idxCoef < numCoefs; ++idxCoef)
+    {
+      sum += monomials[idxCoef] * coefs[idxCoef];
+    }
+    return sum;
+  }
+}
+
 HHWeightInterfaceLO::HHWeightInterfaceLO(const HHWeightInterfaceCouplings * const couplings,
                                          const edm::ParameterSet & cfg)
   : couplings_(couplings)
+  , usePython_(cfg.exists("usePython") ? cfg.getParameter<bool>("usePython") : false)
+  , numBinsX_(0)
+  , numBinsY_(0)
   , modeldata_(nullptr)
   , moduleMainString_(nullptr)
   , moduleMain_(nullptr)
   , func_Weight_(nullptr)
+  , func_norm_(nullptr)
   , nof_sumEvt_entries_(0)
   , sumEvt_(nullptr)
 {
   assert(couplings_);
 
-  // AC: limit number of threads running in python to one
-  setenv("OMP_NUM_THREADS", "1", 0);
-
   const std::string coefFile = cfg.getParameter<std::string>("coefFile");
-
-  // read the python file that we're about to execute
-  const std::string applicationLoadPath = get_fullpath("hhAnalysis/multilepton/python/do_weight.py");
-  std::ifstream applicationLoadFile(applicationLoadPath);
-  std::string applicationLoadStr;
-
-  applicationLoadFile.seekg(0, std::ios::end);
-  applicationLoadStr.reserve(applicationLoadFile.tellg());
-  applicationLoadFile.seekg(0, std::ios::beg);
-  applicationLoadStr.assign(std::istreambuf_iterator<char>(applicationLoadFile), std::istreambuf_iterator<char>());
-
-  // https://ubuntuforums.org/archive/index.php/t-324544.html
-  // https://stackoverflow.com/questions/4060221/how-to-reliably-open-a-file-in-the-same-directory-as-a-python-script
-  // https://gist.github.com/rjzak/5681680
-  Py_SetProgramName((wchar_t*)("do_weight"));
-  moduleMainString_ = PyUnicode_FromString("__main__");
-  Py_Initialize();
-  moduleMain_ = PyImport_Import(moduleMainString_);
-  PyRun_SimpleString(applicationLoadStr.c_str());
-
-  // General: Load the class with the functions to calculate the different parts of the weights
-  PyObject * func_load = PyObject_GetAttrString(moduleMain_, "load");
   const std::string coefFilePath = get_fullpath(coefFile);
-  PyObject * coef_path = PyUnicode_FromString(coefFilePath.c_str());
-  PyObject * args_load = PyTuple_Pack(1, coef_path);
-  modeldata_ = PyObject_CallObject(func_load, args_load);
-
-  // function to calculate and return parts of the weights
-  func_Weight_ = PyObject_GetAttrString(moduleMain_, "evaluate_weight");
-
-  // function to compute normalization constant
-  func_norm_ = PyObject_GetAttrString(moduleMain_, "get_norm");
 
   sumEvt_ = HHWeightInterfaceCouplings::loadDenominatorHist(
     couplings_->denominator_file_lo(), couplings_->histtitle()
@@ -65,9 +56,50 @@ HHWeightInterfaceLO::HHWeightInterfaceLO(const HHWeightInterfaceCouplings * cons
   nof_sumEvt_entries_ = static_cast<int>(sumEvt_->Integral());
   assert(nof_sumEvt_entries_ > 0);
 
-  Py_XDECREF(coef_path);
-  Py_XDECREF(args_load);
-  Py_XDECREF(func_load);
+  if(usePython_)
+  {
+    // AC: limit number of threads running in python to one
+    setenv("OMP_NUM_THREADS", "1", 0);
+
+    // read the python file that we're about to execute
+    const std::string applicationLoadPath = get_fullpath("hhAnalysis/multilepton/python/do_weight.py");
+    std::ifstream applicationLoadFile(applicationLoadPath);
+    std::string applicationLoadStr;
+
+    applicationLoadFile.seekg(0, std::ios::end);
+    applicationLoadStr.reserve(applicationLoadFile.tellg());
+    applicationLoadFile.seekg(0, std::ios::beg);
+    applicationLoadStr.assign(std::istreambuf_iterator<char>(applicationLoadFile), std::istreambuf_iterator<char>());
+
+    // https://ubuntuforums.org/archive/index.php/t-324544.html
+    // https://stackoverflow.com/questions/4060221/how-to-reliably-open-a-file-in-the-same-directory-as-a-python-script
+    // https://gist.github.com/rjzak/5681680
+    Py_SetProgramName((wchar_t*)("do_weight"));
+    moduleMainString_ = PyUnicode_FromString("__main__");
+    Py_Initialize();
+    moduleMain_ = PyImport_Import(moduleMainString_);
+    PyRun_SimpleString(applicationLoadStr.c_str());
+
+    // General: Load the class with the functions to calculate the different parts of the weights
+    PyObject * func_load = PyObject_GetAttrString(moduleMain_, "load");
+    PyObject * coef_path = PyUnicode_FromString(coefFilePath.c_str());
+    PyObject * args_load = PyTuple_Pack(1, coef_path);
+    modeldata_ = PyObject_CallObject(func_load, args_load);
+
+    // function to calculate and return parts of the weights
+    func_Weight_ = PyObject_GetAttrString(moduleMain_, "evaluate_weight");
+
+    // function to compute normalization constant
+    func_norm_ = PyObject_GetAttrString(moduleMain_, "get_norm");
+
+    Py_XDECREF(coef_path);
+    Py_XDECREF(args_load);
+    Py_XDECREF(func_load);
+  }
+  else
+  {
+    loadCoefficients(coefFilePath);
+  }
 
   const std::map<std::string, HHCoupling> couplingArray = couplings_->getCouplings();
   norm_.clear();
@@ -76,6 +108,26 @@ HHWeightInterfaceLO::HHWeightInterfaceLO(const HHWeightInterfaceCouplings * cons
     assert(kv.first == kv.second.name());
     norm_[kv.first] = getNorm(&kv.second);
   }
+
+  // CV: precompute the coupling monomials of all coupling scenarios, divided by the normalization,
+  //     so that the weights for one event reduce to a dot product with the coefficients of the (gen_mHH, cos(theta*)) bin
+  bmNames_ = couplings_->get_bm_names();
+  if(! usePython_)
+  {
+    bmMonomials_.assign(bmNames_.size() * numCoefs_, 0.);
+    for(std::size_t idxBM = 0; idxBM < bmNames_.size(); ++idxBM)
+    {
+      const std::string & bmName = bmNames_[idxBM];
+      bmIdx_[bmName] = idxBM;
+      double * monomials = &bmMonomials_[idxBM * numCoefs_];
+      getMonomials(couplings_->getCoupling(bmName), monomials);
+      const double norm = norm_.at(bmName);
+      for(int idxCoef = 0; idxCoef < numCoefs_; ++idxCoef)
+      {
+        monomials[idxCoef] = norm > 0. ? monomials[idxCoef] / norm : 0.;
+      }
+    }
+  }
 }
 
 HHWeightInterfaceLO::~HHWeightInterfaceLO()
@@ -88,6 +140,97 @@ HHWeightInterfaceLO::~HHWeightInterfaceLO()
   delete sumEvt_;
 }
 
+void
+HHWeightInterfaceLO::loadCoefficients(const std::string & coefFilePath)
+{
+  numBinsX_ = sumEvt_->GetNbinsX();
+  numBinsY_ = sumEvt_->GetNbinsY();
+  denoms_.assign(numBinsX_ * numBinsY_, 0.);
+  for(int idxBinX = 0; idxBinX < numBinsX_; ++idxBinX)
+  {
+    for(int idxBinY = 0; idxBinY < numBinsY_; ++idxBinY)
+    {
+      denoms_[idxBinX * numBinsY_ + idxBinY] = sumEvt_->GetBinContent(idxBinX + 1, idxBinY + 1);
+    }
+  }
+
+  // CV: each line of the file holds the coefficients A1..A15 in the last 15 columns;
+  //     the lines are ordered by gen_mHH bin first and by |cos(theta*)| bin second
+  std::ifstream inFile_coefs(coefFilePath);
+  if(! inFile_coefs)
+  {
+    throw cmsException(this, __func__, __LINE__) << "Error on opening file " << coefFilePath;
+  }
+  coefs_.clear();
+  coefs_.reserve(denoms_.size() * numCoefs_);
+  for(std::string line; std::getline(inFile_coefs, line); )
+  {
+    const std::size_t comment_pos = line.find_first_of("#");
+    const std::string line_before_comment = boost::trim_copy(comment_pos != std::string::npos ? line.substr(0, comment_pos) : line);
+    if(line_before_comment.empty())
+    {
+      continue;
+    }
+    std::istringstream line_stream(line_before_comment);
+    std::vector<double> values;
+    double value;
+    while(line_stream >> value)
+    {
+      values.push_back(value);
+    }
+    if(! line_stream.eof() || values.size() < static_cast<std::size_t>(numCoefs_))
+    {
+      throw cmsException(this, __func__, __LINE__)
+        << "Invalid line in file " << coefFilePath << ": '" << line << "'"
+      ;
+    }
+    coefs_.insert(coefs_.end(), values.end() - numCoefs_, values.end());
+  }
+  if(coefs_.size() != denoms_.size() * numCoefs_)
+  {
+    throw cmsException(this, __func__, __LINE__)
+      << "Number of bins in file " << coefFilePath << " = " << coefs_.size() / numCoefs_ << " does not match "
+         "number of bins in denominator histogram = " << denoms_.size() << " !!"
+    ;
+  }
+}
+
+int
+HHWeightInterfaceLO::getBin(double mHH,
+                            double cosThetaStar) const
+{
+  // CV: events outside of the histogram range are assigned to the first or last bin
+  const int idxBinX = std::min(std::max(sumEvt_->GetXaxis()->FindBin(mHH), 1), numBinsX_) - 1;
+  const int idxBinY = std::min(std::max(sumEvt_->GetYaxis()->FindBin(std::fabs(cosThetaStar)), 1), numBinsY_) - 1;
+  return idxBinX * numBinsY_ + idxBinY;
+}
+
+void
+HHWeightInterfaceLO::getMonomials(const HHCoupling & coupling,
+                                  double * monomials)
+{
+  const double kl = coupling.kl();
+  const double kt = coupling.kt();
+  const double c2 = coupling.c2();
+  const double cg = coupling.cg();
+  const double c2g = coupling.c2g();
+  monomials[0]  = kt*kt*kt*kt;
+  monomials[1]  = c2*c2;
+  monomials[2]  = kt*kt*kl*kl;
+  monomials[3]  = cg*cg*kl*kl;
+  monomials[4]  = c2g*c2g;
+  monomials[5]  = c2*kt*kt;
+  monomials[6]  = kl*kt*kt*kt;
+  monomials[7]  = kt*kl*c2;
+  monomials[8]  = cg*kl*c2;
+  monomials[9]  = c2*c2g;
+  monomials[10] = cg*kl*kt*kt;
+  monomials[11] = c2g*kt*kt;
+  monomials[12] = kl*kl*cg*kt;
+  monomials[13] = c2g*kt*kl;
+  monomials[14] = cg*c2g*kl;
+}
+
 double
 HHWeightInterfaceLO::getDenom(double mHH, double cosThetaStar) const
 {
@@ -99,6 +242,38 @@ HHWeightInterfaceLO::getWeight(const std::string & bmName,
                                double mHH,
                                double cosThetaStar,
                                bool isDEBUG) const
+{
+  double weight = 0.;
+  if(usePython_)
+  {
+    weight = getWeight_python(bmName, mHH, cosThetaStar);
+  }
+  else
+  {
+    const auto bmIdx = bmIdx_.find(bmName);
+    if(bmIdx == bmIdx_.end())
+    {
+      throw cmsException(this, __func__, __LINE__) << "No such coupling booked: " << bmName;
+    }
+    const int idxBin = getBin(mHH, cosThetaStar);
+    const double denominator = denoms_[idxBin];
+    if(denominator > 0.)
+    {
+      weight = dot(&bmMonomials_[bmIdx->second * numCoefs_], &coefs_[idxBin * numCoefs_], numCoefs_) * nof_sumEvt_entries_ / denominator;
+    }
+  }
+
+  if(isDEBUG)
+  {
+    std::cout << "denominator = " << getDenom(mHH, cosThetaStar) << "\nbmName = " << bmName << ") = " << weight << '\n';
+  }
+  return weight;
+}
+
+double
+HHWeightInterfaceLO::getWeight_python(const std::string & bmName,
+                                      double mHH,
+                                      double cosThetaStar) const
 {
   const HHCoupling coupling = couplings_->getCoupling(bmName);
   const double denominator = getDenom(mHH, cosThetaStar);
@@ -139,10 +314,6 @@ HHWeightInterfaceLO::getWeight(const std::string & bmName,
   Py_XDECREF(args_BM_list);
   Py_XDECREF(weight_ptr);
 
-  if(isDEBUG)
-  {
-    std::cout << "denominator = " << denominator << "\nbmName = " << bmName << ") = " << weight << '\n';
-  }
   return weight;
 }
 
@@ -166,6 +337,61 @@ HHWeightInterfaceLO::getRelativeWeight(const std::string & bmName,
   return reWeight;
 }
 
+void
+HHWeightInterfaceLO::getWeights(double mHH,
+                                double cosThetaStar,
+                                std::vector<double> & weights) const
+{
+  weights.resize(bmNames_.size());
+  if(usePython_)
+  {
+    for(std::size_t idxBM = 0; idxBM < bmNames_.size(); ++idxBM)
+    {
+      weights[idxBM] = getWeight_python(bmNames_[idxBM], mHH, cosThetaStar);
+    }
+    return;
+  }
+  const int idxBin = getBin(mHH, cosThetaStar);
+  const double * coefs = &coefs_[idxBin * numCoefs_];
+  const double denominator = denoms_[idxBin];
+  const double factor = denominator > 0. ? nof_sumEvt_entries_ / denominator : 0.;
+  for(std::size_t idxBM = 0; idxBM < bmNames_.size(); ++idxBM)
+  {
+    weights[idxBM] = dot(&bmMonomials_[idxBM * numCoefs_], coefs, numCoefs_) * factor;
+  }
+}
+
+void
+HHWeightInterfaceLO::getRelativeWeights(double mHH,
+                                        double cosThetaStar,
+                                        std::vector<double> & reWeights) const
+{
+  reWeights.resize(bmNames_.size());
+  if(usePython_)
+  {
+    for(std::size_t idxBM = 0; idxBM < bmNames_.size(); ++idxBM)
+    {
+      reWeights[idxBM] = getRelativeWeight(bmNames_[idxBM], mHH, cosThetaStar);
+    }
+    return;
+  }
+  // CV: the factor nof_sumEvt_entries/denominator is common to all coupling scenarios and cancels in the ratio
+  const int idxBin = getBin(mHH, cosThetaStar);
+  const double * coefs = &coefs_[idxBin * numCoefs_];
+  const double smWeight = dot(&bmMonomials_[bmIdx_.at("SM") * numCoefs_], coefs, numCoefs_);
+  for(std::size_t idxBM = 0; idxBM < bmNames_.size(); ++idxBM)
+  {
+    if(bmNames_[idxBM] == "SM" || ! (smWeight > 0.))
+    {
+      reWeights[idxBM] = 1.;
+    }
+    else
+    {
+      reWeights[idxBM] = dot(&bmMonomials_[idxBM * numCoefs_], coefs, numCoefs_) / smWeight;
+    }
+  }
+}
+
 std::map<std::string, double>
 HHWeightInterfaceLO::getNorm() const
 {
@@ -174,6 +400,28 @@ HHWeightInterfaceLO::getNorm() const
 
 double
 HHWeightInterfaceLO::getNorm(const HHCoupling * const coupling) const
+{
+  if(usePython_)
+  {
+    return getNorm_python(coupling);
+  }
+  // CV: sum of cross sections over all (gen_mHH, cos(theta*)) bins that are populated in the denominator histogram,
+  //     so that the weights sum up to the number of entries in the denominator histogram
+  double monomials[numCoefs_];
+  getMonomials(*coupling, monomials);
+  double norm = 0.;
+  for(std::size_t idxBin = 0; idxBin < denoms_.size(); ++idxBin)
+  {
+    if(denoms_[idxBin] > 0.)
+    {
+      norm += dot(monomials, &coefs_[idxBin * numCoefs_], numCoefs_);
+    }
+  }
+  return norm;
+}
+
+double
+HHWeightInterfaceLO::getNorm_python(const HHCoupling * const coupling) const
 {
   PyObject* kl_py = PyFloat_FromDouble(static_cast<double>(coupling->kl()));
   PyObject* kt_py = PyFloat_FromDouble(static_cast<double>(coupling->kt()));
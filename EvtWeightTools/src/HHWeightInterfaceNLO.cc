@@ -12,10 +12,12 @@
 #include <TMath.h>                                                                     // TMath::Nint()
 #include <TString.h>                                                                   // Form()
 
-#include <algorithm>                                                                   // std::min(), std::sort()
+#include <algorithm>                                                                   // std::min(), std::sort(), std::find()
 #include <assert.h>                                                                    // assert
+#include <cmath>                                                                       // std::fabs()
 #include <fstream>                                                                     // std::ifstream
 #include <iostream>                                                                    // std::cout, std::endl
+#include <iterator>                                                                    // std::distance()
 #include <set>                                                                         // std::set
 #include <stdlib.h>                                                                    // atof()
 #include <sstream>                                                                     // std::istringstream
@@ -385,6 +387,11 @@ HHWeightInterfaceNLO::HHWeightInterfaceNLO(const HHWeightInterfaceCouplings * co
   , xsecFileName_V2_nlo_("tthAnalysis/HiggsToTauTau/data/HHWeightInterfaceNLO/pm_pw_NLO-Ais-13TeV_V2.txt")
   , sumEvt_(nullptr)
   , nof_sumEvt_entries_(0)
+  , bmNames_(couplings_->get_bm_names())
+  , idxSM_(0)
+  , weightTable_xAxis_(nullptr)
+  , weightTable_yAxis_(nullptr)
+  , weightTable_numBinsY_(0)
   , era_(era)
   , apply_coupling_fix_CMS_(apply_coupling_fix_CMS)
   , max_weight_(max_weight)
@@ -535,6 +542,8 @@ HHWeightInterfaceNLO::HHWeightInterfaceNLO(const HHWeightInterfaceCouplings * co
       weights_NLOtoNLO_V2_[bmName] = histogram_NLOtoNLO_V2_weights;
     }
   }
+
+  initWeightTable_LOtoNLO();
 }
 
 HHWeightInterfaceNLO::~HHWeightInterfaceNLO()
@@ -578,6 +587,142 @@ namespace
   }
 }
 
+void
+HHWeightInterfaceNLO::initWeightTable_LOtoNLO()
+{
+  const std::vector<std::string>::const_iterator sm_iter = std::find(bmNames_.begin(), bmNames_.end(), "SM");
+  if ( sm_iter == bmNames_.end() )
+  {
+    throw cmsException(this, __func__, __LINE__) << "No SM coupling scenario defined";
+  }
+  idxSM_ = std::distance(bmNames_.cbegin(), sm_iter);
+  const std::size_t numBMs = bmNames_.size();
+
+  // CV: the weights of all coupling scenarios are computed for the same binning,
+  //     so the binning of the SM histogram can be used to locate the bin for all of them
+  switch(mode_)
+  {
+    case HHWeightInterfaceNLOMode::v1:
+    {
+      weightTable_xAxis_ = weights_LOtoNLO_V1_.at("SM")->GetXaxis();
+      weightTable_yAxis_ = nullptr;
+      weightTable_numBinsY_ = 1;
+      const int numBinsX = weightTable_xAxis_->GetNbins();
+      weightTable_LOtoNLO_.assign(numBinsX * numBMs, 0.);
+      for ( std::size_t idxBM = 0; idxBM < numBMs; ++idxBM )
+      {
+        const TH1 * histogram_weight = weights_LOtoNLO_V1_.at(bmNames_[idxBM]);
+        if ( histogram_weight->GetNbinsX() != numBinsX )
+        {
+          throw cmsException(this, __func__, __LINE__) << "Binning of histogram '" << histogram_weight->GetName() << "' does not match SM";
+        }
+        for ( int idxBinX = 1; idxBinX <= numBinsX; ++idxBinX )
+        {
+          weightTable_LOtoNLO_[(idxBinX - 1) * numBMs + idxBM] = histogram_weight->GetBinContent(idxBinX);
+        }
+      }
+      break;
+    }
+    case HHWeightInterfaceNLOMode::v2:
+    case HHWeightInterfaceNLOMode::v3:
+    {
+      // CV: getWeight_LOtoNLO_V2 clamps (gen_mHH, cos(theta*)) to the histogram range,
+      //     while getWeight_LOtoNLO_V3 looks up cos(theta*) by its absolute value and includes under- and overflow bins;
+      //     in mode v3, the table hence covers the under- and overflow bins, too
+      const bool isV3 = mode_ == HHWeightInterfaceNLOMode::v3;
+      const std::map<std::string, const TH2 *> & histograms = isV3 ? dXsec_V2_nlo_ : weights_LOtoNLO_V2_;
+      const TH2 * histogram_SM = histograms.at("SM");
+      weightTable_xAxis_ = histogram_SM->GetXaxis();
+      weightTable_yAxis_ = histogram_SM->GetYaxis();
+      const int offset = isV3 ? 0 : 1;
+      const int numBinsX = histogram_SM->GetNbinsX() + (isV3 ? 2 : 0);
+      weightTable_numBinsY_ = histogram_SM->GetNbinsY() + (isV3 ? 2 : 0);
+      weightTable_LOtoNLO_.assign(numBinsX * weightTable_numBinsY_ * numBMs, 0.);
+      for ( std::size_t idxBM = 0; idxBM < numBMs; ++idxBM )
+      {
+        const TH2 * histogram_weight = histograms.at(bmNames_[idxBM]);
+        if ( histogram_weight->GetNbinsX() != histogram_SM->GetNbinsX() || histogram_weight->GetNbinsY() != histogram_SM->GetNbinsY() )
+        {
+          throw cmsException(this, __func__, __LINE__) << "Binning of histogram '" << histogram_weight->GetName() << "' does not match SM";
+        }
+        for ( int idxBinX = 0; idxBinX < numBinsX; ++idxBinX )
+        {
+          for ( int idxBinY = 0; idxBinY < weightTable_numBinsY_; ++idxBinY )
+          {
+            const int idxBin = idxBinX * weightTable_numBinsY_ + idxBinY;
+            weightTable_LOtoNLO_[idxBin * numBMs + idxBM] = histogram_weight->GetBinContent(idxBinX + offset, idxBinY + offset);
+          }
+        }
+      }
+      break;
+    }
+    case HHWeightInterfaceNLOMode::none:
+    default:
+      break;
+  }
+}
+
+const double *
+HHWeightInterfaceNLO::getWeightTableRow_LOtoNLO(double mHH,
+                                                double cosThetaStar,
+                                                double & factor) const
+{
+  int idxBin = -1;
+  factor = 1.;
+  switch(mode_)
+  {
+    case HHWeightInterfaceNLOMode::v1:
+    {
+      idxBin = getIdxBin(weightTable_xAxis_, mHH) - 1;
+      break;
+    }
+    case HHWeightInterfaceNLOMode::v2:
+    {
+      idxBin = (getIdxBin(weightTable_xAxis_, mHH) - 1) * weightTable_numBinsY_ + (getIdxBin(weightTable_yAxis_, cosThetaStar) - 1);
+      break;
+    }
+    case HHWeightInterfaceNLOMode::v3:
+    {
+      idxBin = weightTable_xAxis_->FindBin(mHH) * weightTable_numBinsY_ + weightTable_yAxis_->FindBin(std::fabs(cosThetaStar));
+      const double dXsec_lo = getDenom(mHH, cosThetaStar) / nof_sumEvt_entries_;
+      factor = dXsec_lo > 0. ? 1. / dXsec_lo : 0.;
+      break;
+    }
+    case HHWeightInterfaceNLOMode::none:
+    default:                             throw cmsException(this, __func__, __LINE__) << "Mode unspecfied";
+  }
+  return &weightTable_LOtoNLO_[idxBin * bmNames_.size()];
+}
+
+void
+HHWeightInterfaceNLO::getWeights_LOtoNLO(double mHH,
+                                         double cosThetaStar,
+                                         std::vector<double> & weights) const
+{
+  double factor = 1.;
+  const double * row = getWeightTableRow_LOtoNLO(mHH, cosThetaStar, factor);
+  weights.resize(bmNames_.size());
+  for ( std::size_t idxBM = 0; idxBM < bmNames_.size(); ++idxBM )
+  {
+    weights[idxBM] = factor * row[idxBM];
+  }
+}
+
+void
+HHWeightInterfaceNLO::getRelativeWeights_LOtoNLO(double mHH,
+                                                 double cosThetaStar,
+                                                 std::vector<double> & reWeights) const
+{
+  double factor = 1.;
+  const double * row = getWeightTableRow_LOtoNLO(mHH, cosThetaStar, factor);
+  const double smWeight = factor * row[idxSM_];
+  reWeights.resize(bmNames_.size());
+  for ( std::size_t idxBM = 0; idxBM < bmNames_.size(); ++idxBM )
+  {
+    reWeights[idxBM] = compRelativeWeight_LOtoNLO(bmNames_[idxBM], smWeight, factor * row[idxBM]);
+  }
+}
+
 double
 HHWeightInterfaceNLO::getWeight_LOtoNLO(const std::string & bmName,
                                         double mHH,
@@ -154,15 +154,23 @@ HadTauFakeRateInterface::getWeight_or_SF(double hadTauPt,
                                          int order,
                                          int central_or_shift) const
 {
+  // CV: weights and SFs of the same tau are memoized separately
+  const int idxMemo = 2 * order + mode;
+  double weight_cached = 1.;
+  if(fakeRateMemo_.get(idxMemo, hadTauPt, hadTauAbsEta, central_or_shift, weight_cached))
+  {
+    return weight_cached;
+  }
+
   std::string name;
   bool isInitialized = false;
-  std::vector<HadTauFakeRateWeightEntry *> j2tFRweights;
+  const std::vector<HadTauFakeRateWeightEntry *> * j2tFRweights = nullptr;
   switch(order)
   {
-    case 0: name = "leading";    isInitialized = isInitialized_lead_;    j2tFRweights = hadTauFakeRateWeights_lead_.at(central_or_shift);    break;
-    case 1: name = "subleading"; isInitialized = isInitialized_sublead_; j2tFRweights = hadTauFakeRateWeights_sublead_.at(central_or_shift); break;
-    case 2: name = "third";      isInitialized = isInitialized_third_;   j2tFRweights = hadTauFakeRateWeights_third_.at(central_or_shift);   break;
-    case 3: name = "fourth";     isInitialized = isInitialized_fourth_;  j2tFRweights = hadTauFakeRateWeights_fourth_.at(central_or_shift);  break;
+    case 0: name = "leading";    isInitialized = isInitialized_lead_;    j2tFRweights = &hadTauFakeRateWeights_lead_.at(central_or_shift);    break;
+    case 1: name = "subleading"; isInitialized = isInitialized_sublead_; j2tFRweights = &hadTauFakeRateWeights_sublead_.at(central_or_shift); break;
+    case 2: name = "third";      isInitialized = isInitialized_third_;   j2tFRweights = &hadTauFakeRateWeights_third_.at(central_or_shift);   break;
+    case 3: name = "fourth";     isInitialized = isInitialized_fourth_;  j2tFRweights = &hadTauFakeRateWeights_fourth_.at(central_or_shift);  break;
     default: assert(0);
   }
 
@@ -171,7 +179,7 @@ HadTauFakeRateInterface::getWeight_or_SF(double hadTauPt,
       << "Jet->tau fake-rate weights for '" << name << "' tau requested, but not initialized";
 
   double weight = 1.;
-  for(const HadTauFakeRateWeightEntry * const hadTauFakeRateWeightEntry: j2tFRweights)
+  for(const HadTauFakeRateWeightEntry * const hadTauFakeRateWeightEntry: *j2tFRweights)
   {
     if(hadTauAbsEta >= hadTauFakeRateWeightEntry->absEtaMin() &&
        hadTauAbsEta < hadTauFakeRateWeightEntry->absEtaMax())
@@ -185,5 +193,6 @@ HadTauFakeRateInterface::getWeight_or_SF(double hadTauPt,
       break;
     }
   }
+  fakeRateMemo_.set(idxMemo, hadTauPt, hadTauAbsEta, central_or_shift, weight);
   return weight;
 }
@@ -43,13 +43,13 @@ LHEVpt_LOtoNLO::IdParams::down(double pt) const
   return (intercept_ - intercept_err_) - (slope_ + slope_err_) * pt / 1e3;
 }
 
-std::map<UChar_t, LHEVpt_LOtoNLO::IdParams> LHEVpt_LOtoNLO::wjets_ = {
+const std::map<UChar_t, LHEVpt_LOtoNLO::IdParams> LHEVpt_LOtoNLO::wjets_ = {
   { 0, { 1.339, 0.020, 1.628, 0.005 } },
   { 1, { 1.531, 0.112, 1.586, 0.027 } },
   { 2, { 0.925, 0.203, 1.440, 0.048 } },
 };
 
-std::map<UChar_t, LHEVpt_LOtoNLO::IdParams> LHEVpt_LOtoNLO::dy_ = {
+const std::map<UChar_t, LHEVpt_LOtoNLO::IdParams> LHEVpt_LOtoNLO::dy_ = {
   { 0, { 1.707, 0.020, 1.650, 0.002 } },
   { 1, { 1.485, 0.080, 1.534, 0.010 } },
   { 2, { 1.916, 0.140, 1.519, 0.019 } },
@@ -137,6 +137,11 @@ LeptonFakeRateInterface::getWeight_e(double electronPt,
                                      double electronAbsEta,
                                      int central_or_shift) const
 {
+  double jetToEleFakeRate_cached = 1.;
+  if(! isDEBUG_ && fakeRateMemo_e_.get(0, electronPt, electronAbsEta, central_or_shift, jetToEleFakeRate_cached))
+  {
+    return jetToEleFakeRate_cached;
+  }
   if(! applyNonClosureCorrection_ && (central_or_shift == kFRe_shape_corrUp || central_or_shift == kFRe_shape_corrDown))
   {
     throw cmsException(this, __func__, __LINE__) << "Requested non-closure systematics while non-closure corrections disabled";
@@ -171,6 +176,7 @@ LeptonFakeRateInterface::getWeight_e(double electronPt,
       << " @ central_or_shift = " << central_or_shift_e << " => FR(jet->e) = " << jetToEleFakeRate_final << '\n';
     ;
   }
+  fakeRateMemo_e_.set(0, electronPt, electronAbsEta, central_or_shift, jetToEleFakeRate_final);
   return jetToEleFakeRate_final;
 }
 
@@ -179,6 +185,11 @@ LeptonFakeRateInterface::getWeight_mu(double muonPt,
                                       double muonAbsEta,
                                       int central_or_shift) const
 {
+  double jetToMuFakeRate_cached = 1.;
+  if(! isDEBUG_ && fakeRateMemo_mu_.get(0, muonPt, muonAbsEta, central_or_shift, jetToMuFakeRate_cached))
+  {
+    return jetToMuFakeRate_cached;
+  }
   if(! applyNonClosureCorrection_ && (central_or_shift == kFRm_shape_corrUp || central_or_shift == kFRm_shape_corrDown))
   {
     throw cmsException(this, __func__, __LINE__) << "Requested non-closure systematics while non-closure corrections disabled";
@@ -213,5 +224,6 @@ LeptonFakeRateInterface::getWeight_mu(double muonPt,
       << " @ central_or_shift = " << central_or_shift_m << " => FR(jet->mu) = " << jetToMuFakeRate_final << '\n';
     ;
   }
+  fakeRateMemo_mu_.set(0, muonPt, muonAbsEta, central_or_shift, jetToMuFakeRate_final);
   return jetToMuFakeRate_final;
 }
@@ -0,0 +1,47 @@
+#include "TallinnNtupleProducer/EvtWeightTools/interface/ScaleFactorMemo.h"
+
+ScaleFactorMemo::ScaleFactorMemo()
+  : numEntries_(0)
+  , nextEntry_(0)
+{}
+
+bool
+ScaleFactorMemo::get(int idx,
+                     double pt,
+                     double absEta,
+                     int central_or_shift,
+                     double & sf) const
+{
+  for(std::size_t idxEntry = 0; idxEntry < numEntries_; ++idxEntry)
+  {
+    const Entry & entry = entries_[idxEntry];
+    if(entry.idx_ == idx && entry.central_or_shift_ == central_or_shift && entry.pt_ == pt && entry.absEta_ == absEta)
+    {
+      sf = entry.sf_;
+      return true;
+    }
+  }
+  return false;
+}
+
+void
+ScaleFactorMemo::set(int idx,
+                     double pt,
+                     double absEta,
+                     int central_or_shift,
+                     double sf)
+{
+  entries_[nextEntry_] = { idx, central_or_shift, pt, absEta, sf };
+  nextEntry_ = (nextEntry_ + 1) % kCapacity;
+  if(numEntries_ < kCapacity)
+  {
+    ++numEntries_;
+  }
+}
+
+void
+ScaleFactorMemo::clear()
+{
+  numEntries_ = 0;
+  nextEntry_ = 0;
+}
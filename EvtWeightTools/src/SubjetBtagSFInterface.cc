@@ -24,7 +24,7 @@ operator "" _size(unsigned long long arg) noexcept
   return static_cast<std::size_t>(arg);
 }
 
-std::map<int, BTagEntry::JetFlavor> SubjetBtagSFInterface::flavorMap_ = {
+const std::map<int, BTagEntry::JetFlavor> SubjetBtagSFInterface::flavorMap_ = {
   { 0, BTagEntry::JetFlavor::FLAV_UDSG },
   { 4, BTagEntry::JetFlavor::FLAV_C    },
   { 5, BTagEntry::JetFlavor::FLAV_B    },
@@ -10,7 +10,9 @@
 #include <TH1.h>                                                                      // TH1
 #include <TH2.h>                                                                      // TH2
 
+#include <algorithm>                                                                  // std::sort()
 #include <assert.h>                                                                   // assert()
+#include <utility>                                                                    // std::pair
 
 using namespace lut;
 
@@ -205,6 +207,168 @@ getSF_from_TGraph(TGraph * lut,
   return lut->Eval(x);
 }
 
+//-------------------------------------------------------------------------------
+CompiledLut::CompiledLut()
+  : type_(Type::kUndefined)
+  , numBinsY_(0)
+  , xMin_(0.)
+  , xMax_(0.)
+{}
+
+CompiledLut::CompiledLut(const TH1 * lut)
+  : CompiledLut()
+{
+  if(lut->GetDimension() != 1)
+  {
+    throw cmsException(__func__, __LINE__)
+      << " Histogram = " << lut->GetName() << " is not one-dimensional";
+  }
+  type_ = Type::kTH1;
+  const TAxis * const xAxis = lut->GetXaxis();
+  const int numBinsX = xAxis->GetNbins();
+  xEdges_.reserve(numBinsX + 1);
+  for(int idxBin_x = 1; idxBin_x <= numBinsX; ++idxBin_x)
+  {
+    xEdges_.push_back(xAxis->GetBinLowEdge(idxBin_x));
+    contents_.push_back(lut->GetBinContent(idxBin_x));
+    errors_.push_back(lut->GetBinError(idxBin_x));
+  }
+  xEdges_.push_back(xAxis->GetBinUpEdge(numBinsX));
+  numBinsY_ = 1;
+}
+
+CompiledLut::CompiledLut(const TH2 * lut)
+  : CompiledLut()
+{
+  type_ = Type::kTH2;
+  const TAxis * const xAxis = lut->GetXaxis();
+  const TAxis * const yAxis = lut->GetYaxis();
+  const int numBinsX = xAxis->GetNbins();
+  numBinsY_ = yAxis->GetNbins();
+  for(int idxBin_x = 1; idxBin_x <= numBinsX + 1; ++idxBin_x)
+  {
+    xEdges_.push_back(xAxis->GetBinLowEdge(idxBin_x));
+  }
+  for(int idxBin_y = 1; idxBin_y <= numBinsY_ + 1; ++idxBin_y)
+  {
+    yEdges_.push_back(yAxis->GetBinLowEdge(idxBin_y));
+  }
+  contents_.reserve(numBinsX * numBinsY_);
+  errors_.reserve(numBinsX * numBinsY_);
+  for(int idxBin_x = 1; idxBin_x <= numBinsX; ++idxBin_x)
+  {
+    for(int idxBin_y = 1; idxBin_y <= numBinsY_; ++idxBin_y)
+    {
+      contents_.push_back(lut->GetBinContent(idxBin_x, idxBin_y));
+      errors_.push_back(lut->GetBinError(idxBin_x, idxBin_y));
+    }
+  }
+}
+
+CompiledLut::CompiledLut(const TGraph * lut)
+  : CompiledLut()
+{
+  type_ = Type::kTGraph;
+  const int numPoints = lut->GetN();
+  std::vector<std::pair<double, double>> points;
+  for(int idxPoint = 0; idxPoint < numPoints; ++idxPoint)
+  {
+    points.push_back({ lut->GetX()[idxPoint], lut->GetY()[idxPoint] });
+  }
+  std::sort(
+    points.begin(), points.end(),
+    [](const std::pair<double, double> & lhs, const std::pair<double, double> & rhs) -> bool
+    {
+      return lhs.first < rhs.first;
+    }
+  );
+  for(const std::pair<double, double> & point: points)
+  {
+    xEdges_.push_back(point.first);
+    contents_.push_back(point.second);
+  }
+  const TAxis * const xAxis = lut->GetXaxis();
+  xMin_ = xAxis->GetXmin();
+  xMax_ = xAxis->GetXmax();
+}
+
+bool
+CompiledLut::isValid() const
+{
+  return type_ != Type::kUndefined;
+}
+
+bool
+CompiledLut::is1D() const
+{
+  return type_ == Type::kTH1 || type_ == Type::kTGraph;
+}
+
+int
+CompiledLut::findBin(const std::vector<double> & edges,
+                     double x)
+{
+  // CV: find index of the last edge <= x (or of the first edge if x is below the range),
+  //     using a binary search that the compiler turns into conditional moves instead of branches
+  const double * base = edges.data();
+  std::size_t numEdges = edges.size();
+  while(numEdges > 1)
+  {
+    const std::size_t half = numEdges / 2;
+    base = base[half] <= x ? base + half : base;
+    numEdges -= half;
+  }
+  const int idxBin = base - edges.data();
+  const int lastBin = static_cast<int>(edges.size()) - 2;
+  return idxBin < lastBin ? idxBin : lastBin;
+}
+
+double
+CompiledLut::getSF_graph(double x) const
+{
+  // CV: same linear interpolation (resp. extrapolation) as in TGraph::Eval()
+  const int numPoints = xEdges_.size();
+  if(numPoints == 0) return 0.;
+  if(numPoints == 1) return contents_[0];
+  x = constrainValue(x, xMin_, xMax_);
+  int idxLow = findBin(xEdges_, x);
+  if(xEdges_[idxLow] == x) return contents_[idxLow];
+  int idxUp = idxLow + 1;
+  if(idxUp > numPoints - 1)
+  {
+    idxLow = numPoints - 2;
+    idxUp = numPoints - 1;
+  }
+  if(xEdges_[idxLow] == xEdges_[idxUp]) return contents_[idxLow];
+  return contents_[idxUp] + (x - xEdges_[idxUp]) * (contents_[idxLow] - contents_[idxUp]) / (xEdges_[idxLow] - xEdges_[idxUp]);
+}
+
+double
+CompiledLut::getSF(double x,
+                   double y,
+                   int error_shift) const
+{
+  switch(type_)
+  {
+    case Type::kTH1:
+    {
+      const int idxBin = findBin(xEdges_, x);
+      return contents_[idxBin] + error_shift * errors_[idxBin];
+    }
+    case Type::kTH2:
+    {
+      const int idxBin = findBin(xEdges_, x) * numBinsY_ + findBin(yEdges_, y);
+      return contents_[idxBin] + error_shift * errors_[idxBin];
+    }
+    case Type::kTGraph: return getSF_graph(x);
+    case Type::kUndefined:
+    default:
+      throw cmsException(__func__, __LINE__) << " Look-up table not initialized";
+  }
+}
+//-------------------------------------------------------------------------------
+
+
 //-------------------------------------------------------------------------------
 lutWrapperBase::lutWrapperBase()
   : inputFile_(nullptr)
@@ -328,7 +492,29 @@ lutWrapperBase::getSF(double pt,
     if(yMin_ != -1. && y < yMin_) return 1.;
     if(yMax_ != -1. && y > yMax_) return 1.;
   }
-  return getSF_private(x, y, error_shift);
+  return compiledLut_.isValid() ? getSF_compiled(x, y, error_shift) : getSF_private(x, y, error_shift);
+}
+
+double
+lutWrapperBase::getSF_compiled(double x,
+                               double y,
+                               int error_shift) const
+{
+  if(compiledLut_.is1D())
+  {
+    if(! ((y >= yMin_ || yMin_ == -1.) && (y < yMax_ || yMax_ == -1.)))
+    {
+      return 1.;
+    }
+  }
+  else
+  {
+    if(yMin_ != -1. && y < yMin_) y = yMin_;
+    if(yMax_ != -1. && y > yMax_) y = yMax_;
+  }
+  if(xMin_ != -1. && x < xMin_) x = xMin_;
+  if(xMax_ != -1. && x > xMax_) x = xMax_;
+  return compiledLut_.getSF(x, y, error_shift);
 }
 
 const std::string &
@@ -425,6 +611,7 @@ lutWrapperTH1::lutWrapperTH1(std::map<std::string, TFile *> & inputFiles,
     ;
   }
   lut_ = loadTH1(inputFile_, lutName_);
+  compiledLut_ = CompiledLut(lut_);
 }
 
 double
@@ -432,14 +619,7 @@ lutWrapperTH1::getSF_private(double x,
                              double y,
                              int error_shift)
 {
-  double sf = 1.;
-  if((y >= yMin_ || yMin_ == -1.) && (y < yMax_ || yMax_ == -1.))
-  {
-    if(xMin_ != -1. && x < xMin_) x = xMin_;
-    if(xMax_ != -1. && x > xMax_) x = xMax_;
-    sf = getSF_from_TH1(lut_, x, error_shift);
-  }
-  return sf;
+  return getSF_compiled(x, y, error_shift);
 }
 //-------------------------------------------------------------------------------
 
@@ -458,6 +638,7 @@ lutWrapperTH2::lutWrapperTH2(std::map<std::string, TFile *> & inputFiles,
   : lutWrapperBase(inputFiles, inputFileName, lutName, lutType, xMin, xMax, xAction, yMin, yMax, yAction)
 {
   lut_ = loadTH2(inputFile_, lutName_);
+  compiledLut_ = CompiledLut(lut_);
 }
 
 double
@@ -465,12 +646,7 @@ lutWrapperTH2::getSF_private(double x,
                              double y,
                              int error_shift)
 {
-  if(xMin_ != -1. && x < xMin_) x = xMin_;
-  if(xMax_ != -1. && x > xMax_) x = xMax_;
-  if(yMin_ != -1. && y < yMin_) y = yMin_;
-  if(yMax_ != -1. && y > yMax_) y = yMax_;
-  double sf = getSF_from_TH2(lut_, x, y, error_shift);
-  return sf;
+  return getSF_compiled(x, y, error_shift);
 }
 //-------------------------------------------------------------------------------
 
@@ -526,6 +702,7 @@ lutWrapperTGraph::lutWrapperTGraph(std::map<std::string, TFile *> & inputFiles,
     ;
   }
   lut_ = loadTGraph(inputFile_, lutName_);
+  compiledLut_ = CompiledLut(lut_);
 }
 
 double
@@ -533,14 +710,7 @@ lutWrapperTGraph::getSF_private(double x,
                                 double y,
                                 int error_shift)
 {
-  double sf = 1.;
-  if((y >= yMin_ || yMin_ == -1.) && (y < yMax_ || yMax_ == -1.))
-  {
-    if(xMin_ != -1. && x < xMin_) x = xMin_;
-    if(xMax_ != -1. && x > xMax_) x = xMax_;
-    sf = getSF_from_TGraph(lut_, x, error_shift);
-  }
-  return sf;
+  return getSF_compiled(x, y, error_shift);
 }
 //-------------------------------------------------------------------------------
 
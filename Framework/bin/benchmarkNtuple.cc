@@ -0,0 +1,802 @@
+/** \executable benchmarkNtuple
+ *
+ * Measure the time and the number of memory allocations per event of the individual stages of the Ntuple production
+ * (EventReader::read, ParticleCollectionCleaner, ParticleCollectionGenMatcher, lutWrapper look-ups and writer plugins)
+ * on a synthetic NanoAOD-like input tree, so that the numbers can be compared across releases.
+ *
+ * The branches of the synthetic tree are exactly those that the readers configured by the 'produceNtuple' PSet bind,
+ * with random values and with object multiplicities configured by the 'benchmarkNtuple' PSet.
+ *
+ */
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"                                         // edm::ParameterSet
+#include "FWCore/ParameterSetReader/interface/ParameterSetReader.h"                             // edm::readPSetsFrom()
+#include "FWCore/PluginManager/interface/PluginManager.h"                                       // edmplugin::PluginManager::configure()
+#include "FWCore/PluginManager/interface/standard.h"                                            // edmplugin::standard::config()
+
+#include "TallinnNtupleProducer/Cleaners/interface/ParticleCollectionCleaner.h"                 // RecoElectronCollectionCleaner, RecoHadTauCollectionCleaner, RecoJetCollectionCleanerAK4
+#include "TallinnNtupleProducer/CommonTools/interface/cmsException.h"                           // cmsException
+#include "TallinnNtupleProducer/CommonTools/interface/merge_systematic_shifts.h"                // merge_systematic_shifts()
+#include "TallinnNtupleProducer/CommonTools/interface/SysIdRegistry.h"                          // SysId, SysIdRegistry
+#include "TallinnNtupleProducer/CommonTools/interface/TTreeWrapper.h"                           // TTreeWrapper
+#include "TallinnNtupleProducer/EvtWeightTools/interface/EvtWeightRecorder.h"                   // EvtWeightRecorder
+#include "TallinnNtupleProducer/EvtWeightTools/interface/lutAuxFunctions.h"                     // lutWrapperBase, lutWrapperTH1, lutWrapperTH2, lutWrapperTGraph
+#include "TallinnNtupleProducer/Objects/interface/Event.h"                                      // Event
+#include "TallinnNtupleProducer/Readers/interface/EventReader.h"                                // EventReader
+#include "TallinnNtupleProducer/Readers/interface/GenHadTauReader.h"                            // GenHadTauReader
+#include "TallinnNtupleProducer/Readers/interface/GenJetReader.h"                               // GenJetReader
+#include "TallinnNtupleProducer/Readers/interface/GenLeptonReader.h"                            // GenLeptonReader
+#include "TallinnNtupleProducer/Readers/interface/GenPhotonReader.h"                            // GenPhotonReader
+#include "TallinnNtupleProducer/Readers/interface/L1PreFiringWeightReader.h"                    // L1PreFiringWeightReader
+#include "TallinnNtupleProducer/Readers/interface/LHEInfoReader.h"                              // LHEInfoReader
+#include "TallinnNtupleProducer/Readers/interface/ParticleCollectionGenMatcher.h"               // RecoMuonCollectionGenMatcher, RecoElectronCollectionGenMatcher, ...
+#include "TallinnNtupleProducer/Readers/interface/PSWeightReader.h"                             // PSWeightReader
+#include "TallinnNtupleProducer/Writers/interface/WriterBase.h"                                 // WriterBase, WriterPluginFactory
+
+#include <TDataType.h>                                                                          // EDataType
+#include <TError.h>                                                                             // gErrorAbortLevel, kError
+#include <TFile.h>                                                                              // TFile
+#include <TH1.h>                                                                                // TH1
+#include <TMath.h>                                                                              // TMath::Pi()
+#include <TRandom3.h>                                                                           // TRandom3
+#include <TString.h>                                                                            // Form()
+#include <TTree.h>                                                                              // TTree
+
+#include <boost/algorithm/string/predicate.hpp>                                                 // boost::starts_with(), boost::ends_with()
+
+#include <algorithm>                                                                            // std::min(), std::max()
+#include <assert.h>                                                                             // assert()
+#include <atomic>                                                                               // std::atomic
+#include <chrono>                                                                               // std::chrono::steady_clock
+#include <cstdlib>                                                                              // EXIT_SUCCESS, EXIT_FAILURE, std::malloc(), std::free()
+#include <fstream>                                                                              // std::ofstream
+#include <iomanip>                                                                              // std::setw(), std::setprecision()
+#include <iostream>                                                                             // std::cout
+#include <map>                                                                                  // std::map
+#include <new>                                                                                  // std::bad_alloc
+#include <string>                                                                               // std::string
+#include <vector>                                                                               // std::vector
+
+//--- count the memory allocations of the whole executable;
+//    operator new[] and operator delete[] forward to the functions below by default
+namespace
+{
+  std::atomic<unsigned long long> gNumAllocations(0);
+}
+
+void *
+operator new(std::size_t size)
+{
+  gNumAllocations.fetch_add(1, std::memory_order_relaxed);
+  if ( void * ptr = std::malloc(size > 0 ? size : 1) )
+  {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void
+operator delete(void * ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void
+operator delete(void * ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+/**
+ * @brief TTree that does not read anything, but records the name and type of each branch for which SetBranchAddress is called,
+ *        so that the schema of the input tree expected by the readers can be determined without an input file
+ */
+class BranchSchemaRecorder : public TTree
+{
+ public:
+  BranchSchemaRecorder()
+    : TTree("BranchSchemaRecorder", "BranchSchemaRecorder")
+  {}
+
+  using TTree::SetBranchAddress;
+  Int_t
+  SetBranchAddress(const char * bname, void *, TBranch **, TClass *, EDataType datatype, Bool_t) override
+  {
+    branchTypes_[bname] = datatype;
+    return 0;
+  }
+
+  std::map<std::string, EDataType> branchTypes_; ///< type of each branch, by branch name
+};
+
+/**
+ * @brief Buffer of one branch of the synthetic input tree
+ */
+struct SyntheticBranch
+{
+  std::string name_;       ///< branch name
+  std::string prefix_;     ///< name of the collection (e.g. "Muon"), or empty if the branch is not an array
+  std::string variable_;   ///< name of the branch without the collection prefix (e.g. "pt" for "Muon_pt")
+  EDataType type_;
+  std::vector<double> buffer_;
+  std::vector<char> data_; ///< values converted to the type of the branch, with the address given to TTree::Branch
+};
+
+/**
+ * @brief Return the type code used in the leaf list of TTree::Branch and the size in bytes of the given data type
+ */
+std::pair<char, std::size_t>
+getLeafType(EDataType type)
+{
+  switch ( type )
+  {
+    case kChar_t:     return { 'B', sizeof(Char_t)    };
+    case kUChar_t:    return { 'b', sizeof(UChar_t)   };
+    case kShort_t:    return { 'S', sizeof(Short_t)   };
+    case kUShort_t:   return { 's', sizeof(UShort_t)  };
+    case kInt_t:      return { 'I', sizeof(Int_t)     };
+    case kUInt_t:     return { 'i', sizeof(UInt_t)    };
+    case kFloat_t:    return { 'F', sizeof(Float_t)   };
+    case kDouble_t:   return { 'D', sizeof(Double_t)  };
+    case kLong64_t:   return { 'L', sizeof(Long64_t)  };
+    case kULong64_t:  return { 'l', sizeof(ULong64_t) };
+    case kBool_t:     return { 'O', sizeof(Bool_t)    };
+    default: throw cmsException("benchmarkNtuple", __LINE__) << "Unsupported branch type = " << static_cast<int>(type) << " !!";
+  }
+}
+
+/**
+ * @brief Convert the values in the buffer of the given branch to the type of the branch
+ */
+void
+convertBuffer(SyntheticBranch & branch)
+{
+  const std::size_t numValues = branch.buffer_.size();
+  for ( std::size_t idxValue = 0; idxValue < numValues; ++idxValue )
+  {
+    const double value = branch.buffer_[idxValue];
+    char * data = branch.data_.data();
+    switch ( branch.type_ )
+    {
+      case kChar_t:    reinterpret_cast<Char_t *>(data)[idxValue]    = static_cast<Char_t>(value);    break;
+      case kUChar_t:   reinterpret_cast<UChar_t *>(data)[idxValue]   = static_cast<UChar_t>(value);   break;
+      case kShort_t:   reinterpret_cast<Short_t *>(data)[idxValue]   = static_cast<Short_t>(value);   break;
+      case kUShort_t:  reinterpret_cast<UShort_t *>(data)[idxValue]  = static_cast<UShort_t>(value);  break;
+      case kInt_t:     reinterpret_cast<Int_t *>(data)[idxValue]     = static_cast<Int_t>(value);     break;
+      case kUInt_t:    reinterpret_cast<UInt_t *>(data)[idxValue]    = static_cast<UInt_t>(value);    break;
+      case kFloat_t:   reinterpret_cast<Float_t *>(data)[idxValue]   = static_cast<Float_t>(value);   break;
+      case kDouble_t:  reinterpret_cast<Double_t *>(data)[idxValue]  = value;                         break;
+      case kLong64_t:  reinterpret_cast<Long64_t *>(data)[idxValue]  = static_cast<Long64_t>(value);  break;
+      case kULong64_t: reinterpret_cast<ULong64_t *>(data)[idxValue] = static_cast<ULong64_t>(value); break;
+      case kBool_t:    reinterpret_cast<Bool_t *>(data)[idxValue]    = value != 0.;                   break;
+      default: assert(0);
+    }
+  }
+}
+
+/**
+ * @brief Return a random value that is typical for a NanoAOD branch of the given name and type
+ */
+double
+generateValue(const SyntheticBranch & branch,
+              TRandom3 & rnd)
+{
+  const std::string & variable = branch.variable_;
+  if ( branch.type_ == kFloat_t || branch.type_ == kDouble_t )
+  {
+    if ( variable == "pt" || boost::starts_with(variable, "pt_") ) return 5. + rnd.Exp(30.);
+    if ( variable == "eta"                                       ) return rnd.Uniform(-2.5, +2.5);
+    if ( variable == "phi"                                       ) return rnd.Uniform(-TMath::Pi(), +TMath::Pi());
+    if ( variable == "mass" || boost::starts_with(variable, "mass_") || boost::starts_with(variable, "msoftdrop") ) return rnd.Exp(10.);
+    if ( boost::ends_with(variable, "Weight") || boost::ends_with(variable, "XWGTUP") || variable == "Nom" ) return 1.;
+    return rnd.Rndm();
+  }
+  if ( branch.type_ == kBool_t )
+  {
+    // CV: MET filters pass, triggers and identification flags fire in half of the cases
+    return boost::starts_with(branch.name_, "Flag_") ? 1. : static_cast<double>(rnd.Rndm() < 0.5);
+  }
+  if ( variable == "charge" ) return rnd.Rndm() < 0.5 ? -1. : +1.;
+  if ( variable == "pdgId" )
+  {
+    const double sign = rnd.Rndm() < 0.5 ? -1. : +1.;
+    if ( branch.prefix_ == "Electron" ) return sign*11.;
+    if ( branch.prefix_ == "Muon"     ) return sign*13.;
+    if ( branch.prefix_ == "GenPhoton") return 22.;
+    return sign*(rnd.Rndm() < 0.5 ? 11. : 13.);
+  }
+  if ( variable == "status"                      ) return 1.;
+  if ( boost::ends_with(variable, "Idx")         ) return -1.;
+  if ( boost::starts_with(variable, "genPartIdx") ) return -1.;
+  if ( branch.type_ == kUChar_t                   ) return rnd.Integer(256);
+  return rnd.Integer(8);
+}
+
+/**
+ * @brief Write a synthetic NanoAOD-like tree with the given branches to the given file
+ * @param multiplicities      Mean number of objects per event, by name of the count branch (e.g. "nMuon"), used if no fixed multiplicity is given
+ * @param fixedMultiplicities Number of entries per event, by name of the count branch (e.g. "nLHEScaleWeight")
+ */
+void
+generateSyntheticTree(const std::string & fileName,
+                      const std::string & treeName,
+                      const std::map<std::string, EDataType> & branchTypes,
+                      unsigned numEvents,
+                      const edm::ParameterSet & multiplicities,
+                      const edm::ParameterSet & fixedMultiplicities,
+                      double defaultMultiplicity,
+                      unsigned maxMultiplicity,
+                      unsigned seed)
+{
+//--- the branches named n<Prefix> are count branches of the collections whose branches are named <Prefix>_<variable>
+//    (or <Prefix> in case of weight vectors such as LHEScaleWeight)
+  std::vector<SyntheticBranch> countBranches;
+  std::vector<SyntheticBranch> branches;
+  for ( const auto & branchType : branchTypes )
+  {
+    const std::string & branchName = branchType.first;
+    SyntheticBranch branch;
+    branch.name_ = branchName;
+    branch.type_ = branchType.second;
+    branch.variable_ = branchName;
+    if ( branchName.size() > 1 && branchName[0] == 'n' )
+    {
+      const std::string prefix = branchName.substr(1);
+      const auto other = branchTypes.lower_bound(prefix + "_");
+      const bool isCountBranch = branchTypes.count(prefix) > 0 ||
+        (other != branchTypes.end() && boost::starts_with(other->first, prefix + "_"));
+      if ( isCountBranch )
+      {
+        countBranches.push_back(branch);
+        continue;
+      }
+    }
+    const std::size_t pos = branchName.find('_');
+    if ( branchTypes.count("n" + branchName) )
+    {
+      branch.prefix_ = branchName;
+    }
+    else if ( pos != std::string::npos && branchTypes.count("n" + branchName.substr(0, pos)) )
+    {
+      branch.prefix_ = branchName.substr(0, pos);
+      branch.variable_ = branchName.substr(pos + 1);
+    }
+    else if ( pos != std::string::npos )
+    {
+      branch.variable_ = branchName.substr(pos + 1);
+    }
+    branches.push_back(branch);
+  }
+
+  TFile * outputFile = new TFile(fileName.data(), "RECREATE");
+  TTree * outputTree = new TTree(treeName.data(), treeName.data());
+  std::map<std::string, SyntheticBranch *> countBranchesByPrefix;
+  for ( SyntheticBranch & countBranch : countBranches )
+  {
+    const std::pair<char, std::size_t> leafType = getLeafType(countBranch.type_);
+    countBranch.buffer_.resize(1);
+    countBranch.data_.resize(leafType.second);
+    outputTree->Branch(countBranch.name_.data(), countBranch.data_.data(), Form("%s/%c", countBranch.name_.data(), leafType.first));
+    countBranchesByPrefix[countBranch.name_.substr(1)] = &countBranch;
+  }
+  for ( SyntheticBranch & branch : branches )
+  {
+    const std::pair<char, std::size_t> leafType = getLeafType(branch.type_);
+    if ( branch.prefix_.empty() )
+    {
+      branch.buffer_.resize(1);
+      branch.data_.resize(leafType.second);
+      outputTree->Branch(branch.name_.data(), branch.data_.data(), Form("%s/%c", branch.name_.data(), leafType.first));
+    }
+    else
+    {
+      branch.buffer_.resize(maxMultiplicity);
+      branch.data_.resize(maxMultiplicity*leafType.second);
+      outputTree->Branch(branch.name_.data(), branch.data_.data(), Form("%s[n%s]/%c", branch.name_.data(), branch.prefix_.data(), leafType.first));
+    }
+  }
+  std::cout << "Generating " << numEvents << " events with " << countBranches.size() << " collection(s) and " << branches.size() << " other branch(es)\n";
+
+  TRandom3 rnd(seed);
+  for ( unsigned idxEvent = 0; idxEvent < numEvents; ++idxEvent )
+  {
+    for ( SyntheticBranch & countBranch : countBranches )
+    {
+      unsigned multiplicity = 0;
+      if ( fixedMultiplicities.exists(countBranch.name_) )
+      {
+        multiplicity = fixedMultiplicities.getParameter<unsigned>(countBranch.name_);
+      }
+      else
+      {
+        const double mean = multiplicities.exists(countBranch.name_) ? multiplicities.getParameter<double>(countBranch.name_) : defaultMultiplicity;
+        multiplicity = rnd.Poisson(mean);
+      }
+      countBranch.buffer_[0] = std::min(multiplicity, maxMultiplicity);
+      convertBuffer(countBranch);
+    }
+    for ( SyntheticBranch & branch : branches )
+    {
+      if ( branch.prefix_.empty() )
+      {
+        if      ( branch.name_ == "run"             ) branch.buffer_[0] = 1.;
+        else if ( branch.name_ == "luminosityBlock" ) branch.buffer_[0] = 1 + idxEvent/1000;
+        else if ( branch.name_ == "event"           ) branch.buffer_[0] = 1 + idxEvent;
+        else                                          branch.buffer_[0] = generateValue(branch, rnd);
+      }
+      else
+      {
+        const unsigned multiplicity = countBranchesByPrefix[branch.prefix_]->buffer_[0];
+        for ( unsigned idxObject = 0; idxObject < multiplicity; ++idxObject )
+        {
+          branch.buffer_[idxObject] = generateValue(branch, rnd);
+        }
+      }
+      convertBuffer(branch);
+    }
+    outputTree->Fill();
+  }
+  outputFile->Write();
+  outputFile->Close();
+  delete outputFile;
+}
+
+/**
+ * @brief Time and number of memory allocations of one stage
+ */
+struct BenchmarkStage
+{
+  BenchmarkStage(const std::string & name,
+                 unsigned numRepetitions = 1)
+    : name_(name)
+    , numRepetitions_(numRepetitions)
+    , calls_(0)
+    , time_(0)
+    , allocations_(0)
+  {}
+
+  std::string name_;
+  unsigned numRepetitions_;        ///< number of times the stage is repeated for each event
+  unsigned long long calls_;
+  long long time_;                 ///< total time spent in the stage, in nanoseconds
+  unsigned long long allocations_; ///< total number of memory allocations in the stage
+};
+
+/**
+ * @brief Add the time elapsed and the number of memory allocations between its construction and its destruction to the given stage
+ */
+class BenchmarkTimer
+{
+ public:
+  BenchmarkTimer(BenchmarkStage & stage)
+    : stage_(&stage)
+    , allocations_start_(gNumAllocations.load(std::memory_order_relaxed))
+    , start_(std::chrono::steady_clock::now())
+  {}
+  ~BenchmarkTimer()
+  {
+    stop();
+  }
+
+  void
+  stop()
+  {
+    if ( stage_ )
+    {
+      stage_->time_ += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count();
+      stage_->allocations_ += gNumAllocations.load(std::memory_order_relaxed) - allocations_start_;
+      ++stage_->calls_;
+      stage_ = nullptr;
+    }
+  }
+
+ private:
+  BenchmarkStage * stage_;
+  unsigned long long allocations_start_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * @brief The EventReader, the readers of event weights and generator level particles and the writer plugins configured by the 'produceNtuple' PSet,
+ *        registered with the given TTreeWrapper
+ */
+struct ReadersAndWriters
+{
+  ReadersAndWriters(const edm::ParameterSet & cfg_produceNtuple,
+                    TTreeWrapper * inputTree,
+                    bool isMC)
+    : eventReader_(nullptr)
+    , genLeptonReader_(nullptr)
+    , genHadTauReader_(nullptr)
+    , genPhotonReader_(nullptr)
+    , genJetReader_(nullptr)
+  {
+    eventReader_ = new EventReader(cfg_produceNtuple);
+    eventReader_->read_systematics(isMC);
+    inputTree->registerReader(eventReader_);
+    if ( cfg_produceNtuple.getParameter<bool>("apply_l1PreFireWeight") )
+    {
+      weightReaders_.push_back(new L1PreFiringWeightReader(cfg_produceNtuple));
+    }
+    if ( isMC )
+    {
+      weightReaders_.push_back(new LHEInfoReader(cfg_produceNtuple));
+      weightReaders_.push_back(new PSWeightReader(cfg_produceNtuple));
+      // CV: the gen-matching is disabled in the EventReader (see main below), so that it can be benchmarked separately
+      genLeptonReader_ = new GenLeptonReader(make_cfg(cfg_produceNtuple, "branchName_genLeptons"));
+      genHadTauReader_ = new GenHadTauReader(make_cfg(cfg_produceNtuple, "branchName_genHadTaus"));
+      genPhotonReader_ = new GenPhotonReader(make_cfg(cfg_produceNtuple, "branchName_genPhotons"));
+      genJetReader_ = new GenJetReader(make_cfg(cfg_produceNtuple, "branchName_genJets"));
+      inputTree->registerReader(genLeptonReader_);
+      inputTree->registerReader(genHadTauReader_);
+      inputTree->registerReader(genPhotonReader_);
+      inputTree->registerReader(genJetReader_);
+    }
+    inputTree->registerReader(weightReaders_);
+    for ( edm::ParameterSet cfg_writer : cfg_produceNtuple.getParameterSetVector("writerPlugins") )
+    {
+      const std::string pluginType = cfg_writer.getParameter<std::string>("pluginType");
+      cfg_writer.addParameter<unsigned int>("numNominalLeptons", cfg_produceNtuple.getParameter<unsigned int>("numNominalLeptons"));
+      cfg_writer.addParameter<unsigned int>("numNominalHadTaus", cfg_produceNtuple.getParameter<unsigned int>("numNominalHadTaus"));
+      cfg_writer.addParameter<std::string>("process", cfg_produceNtuple.getParameter<std::string>("process"));
+      cfg_writer.addParameter<bool>("isMC", isMC);
+      WriterBase * writer = WriterPluginFactory::get()->create(pluginType, cfg_writer).release();
+      writer->registerReaders(inputTree);
+      writers_.push_back(writer);
+      writerNames_.push_back(pluginType);
+    }
+  }
+  ~ReadersAndWriters()
+  {
+    for ( WriterBase * writer : writers_ )
+    {
+      delete writer;
+    }
+    delete genLeptonReader_;
+    delete genHadTauReader_;
+    delete genPhotonReader_;
+    delete genJetReader_;
+    for ( ReaderBase * reader : weightReaders_ )
+    {
+      delete reader;
+    }
+    delete eventReader_;
+  }
+
+  static
+  edm::ParameterSet
+  make_cfg(const edm::ParameterSet & cfg,
+           const std::string & attr_branchName)
+  {
+    edm::ParameterSet cfg_modified(cfg);
+    cfg_modified.addParameter<std::string>("branchName", cfg.getParameter<std::string>(attr_branchName));
+    return cfg_modified;
+  }
+
+  EventReader * eventReader_;
+  std::vector<ReaderBase *> weightReaders_;
+  GenLeptonReader * genLeptonReader_;
+  GenHadTauReader * genHadTauReader_;
+  GenPhotonReader * genPhotonReader_;
+  GenJetReader * genJetReader_;
+  std::vector<WriterBase *> writers_;
+  std::vector<std::string> writerNames_;
+};
+
+/**
+ * @brief Create the lutWrapper of given class ("TH1", "TH2" or "TGraph") and type (e.g. "XptYabsEta")
+ */
+lutWrapperBase *
+createLut(std::map<std::string, TFile *> & inputFiles,
+          const edm::ParameterSet & cfg_lut)
+{
+  const std::string inputFileName = cfg_lut.getParameter<std::string>("inputFileName");
+  const std::string lutName = cfg_lut.getParameter<std::string>("lutName");
+  const std::string lutClass = cfg_lut.getParameter<std::string>("lutClass");
+  const std::string lutType_string = cfg_lut.getParameter<std::string>("lutType");
+  const std::map<std::string, int> lutTypes = {
+    { "Xpt",        lut::kXpt        }, { "Xeta",       lut::kXeta       }, { "XabsEta",    lut::kXabsEta    },
+    { "XptYpt",     lut::kXptYpt     }, { "XptYeta",    lut::kXptYeta    }, { "XptYabsEta", lut::kXptYabsEta },
+    { "XetaYpt",    lut::kXetaYpt    }, { "XabsEtaYpt", lut::kXabsEtaYpt },
+  };
+  if ( ! lutTypes.count(lutType_string) )
+  {
+    throw cmsException("benchmarkNtuple", __LINE__) << "Invalid Configuration parameter 'lutType' = " << lutType_string << " !!";
+  }
+  const int lutType = lutTypes.at(lutType_string);
+  if ( lutClass == "TH1"    ) return new lutWrapperTH1(inputFiles, inputFileName, lutName, lutType);
+  if ( lutClass == "TH2"    ) return new lutWrapperTH2(inputFiles, inputFileName, lutName, lutType);
+  if ( lutClass == "TGraph" ) return new lutWrapperTGraph(inputFiles, inputFileName, lutName, lutType);
+  throw cmsException("benchmarkNtuple", __LINE__) << "Invalid Configuration parameter 'lutClass' = " << lutClass << " !!";
+}
+
+/**
+ * @brief Benchmark the individual stages of the Ntuple production on a synthetic input tree.
+ */
+int main(int argc, char* argv[])
+{
+//--- throw an exception in case ROOT encounters an error
+  gErrorAbortLevel = kError;
+
+//--- stop ROOT from keeping track of all histograms
+  TH1::AddDirectory(false);
+
+//--- parse command-line arguments
+  if ( argc < 2 ) {
+    std::cout << "Usage: " << argv[0] << " [parameters.py]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "<benchmarkNtuple>:" << std::endl;
+
+//--- read python configuration parameters
+  if ( !edm::readPSetsFrom(argv[1])->existsAs<edm::ParameterSet>("process") )
+    throw cmsException("benchmarkNtuple", __LINE__) << "No ParameterSet 'process' found in configuration file = " << argv[1] << " !!";
+  edm::ParameterSet cfg = edm::readPSetsFrom(argv[1])->getParameter<edm::ParameterSet>("process");
+  edm::ParameterSet cfg_produceNtuple = cfg.getParameter<edm::ParameterSet>("produceNtuple");
+  const edm::ParameterSet cfg_benchmarkNtuple = cfg.getParameter<edm::ParameterSet>("benchmarkNtuple");
+  const bool isMC = cfg_produceNtuple.getParameter<bool>("isMC");
+  const std::string treeName = cfg_produceNtuple.getParameter<std::string>("treeName");
+  // CV: disable the gen-matching in the EventReader, so that it can be benchmarked separately
+  cfg_produceNtuple.addParameter<bool>("redoGenMatching", true);
+
+  const std::string syntheticFileName = cfg_benchmarkNtuple.getParameter<std::string>("syntheticFileName");
+  const unsigned numEvents = cfg_benchmarkNtuple.getParameter<unsigned>("numEvents");
+  const unsigned numRepetitions = std::max(1u, cfg_benchmarkNtuple.getParameter<unsigned>("numRepetitions"));
+  const bool benchmarkSystematics = cfg_benchmarkNtuple.getParameter<bool>("benchmarkSystematics");
+  const std::string reportFileName = cfg_benchmarkNtuple.getParameter<std::string>("reportFileName");
+
+  std::vector<std::string> systematic_shifts;
+  merge_systematic_shifts(systematic_shifts, { "central"});
+  if ( isMC && benchmarkSystematics )
+  {
+    merge_systematic_shifts(systematic_shifts, EventReader::get_supported_systematics());
+  }
+  const SysIdRegistry sysIdRegistry(systematic_shifts, isMC);
+  const std::vector<const SysId *> sysIds = sysIdRegistry.get_sysIds();
+  const SysId & sysId_central = sysIdRegistry.get("central");
+
+  edmplugin::PluginManager::Config config;
+  edmplugin::PluginManager::configure(edmplugin::standard::config());
+
+//--- determine the branches read by the EventReader, the readers of event weights and the writer plugins
+//    and generate the synthetic input tree;
+//    the objects used to determine the branches are deleted before the objects used for the benchmark are created,
+//    as each branch can be bound by only one reader instance
+  {
+    TTreeWrapper schemaTree(treeName, { syntheticFileName });
+    const ReadersAndWriters readersAndWriters(cfg_produceNtuple, &schemaTree, isMC);
+    BranchSchemaRecorder schemaRecorder;
+    for ( ReaderBase * reader : schemaTree.getReaders() )
+    {
+      reader->setBranchAddresses(&schemaRecorder);
+    }
+    generateSyntheticTree(
+      syntheticFileName, treeName, schemaRecorder.branchTypes_, numEvents,
+      cfg_benchmarkNtuple.getParameter<edm::ParameterSet>("multiplicities"),
+      cfg_benchmarkNtuple.getParameter<edm::ParameterSet>("fixedMultiplicities"),
+      cfg_benchmarkNtuple.getParameter<double>("defaultMultiplicity"),
+      cfg_benchmarkNtuple.getParameter<unsigned>("maxMultiplicity"),
+      cfg_benchmarkNtuple.getParameter<unsigned>("seed")
+    );
+  }
+
+//--- create the objects to be benchmarked
+  TTreeWrapper * inputTree = new TTreeWrapper(treeName, { syntheticFileName });
+  ReadersAndWriters * readersAndWriters = new ReadersAndWriters(cfg_produceNtuple, inputTree, isMC);
+  EventReader * eventReader = readersAndWriters->eventReader_;
+  const std::vector<WriterBase *> & writers = readersAndWriters->writers_;
+  TTree * outputTree = new TTree("events", "events");
+  outputTree->SetDirectory(nullptr);
+  for ( WriterBase * writer : writers )
+  {
+    writer->setBranches(outputTree);
+  }
+
+  const RecoElectronCollectionCleaner electronCleaner(0.3);
+  const RecoHadTauCollectionCleaner hadTauCleaner(0.3);
+  const RecoJetCollectionCleanerAK4 jetCleanerAK4(0.4);
+  const RecoMuonCollectionGenMatcher muonGenMatcher;
+  const RecoElectronCollectionGenMatcher electronGenMatcher;
+  const RecoHadTauCollectionGenMatcher hadTauGenMatcher;
+  const RecoJetCollectionGenMatcherAK4 jetGenMatcherAK4;
+
+  std::map<std::string, TFile *> lutInputFiles;
+  std::vector<lutWrapperBase *> luts;
+  for ( const edm::ParameterSet & cfg_lut : cfg_benchmarkNtuple.getParameterSetVector("luts") )
+  {
+    luts.push_back(createLut(lutInputFiles, cfg_lut));
+  }
+
+//--- define the stages;
+//    the stages that do not modify the event are repeated numRepetitions times for each event, to reduce the effect of the timer overhead
+  std::vector<BenchmarkStage> stages;
+  stages.reserve(9 + writers.size() + luts.size());
+  BenchmarkStage & stage_getEntry = *stages.emplace(stages.end(), "TTreeWrapper::hasNextEvent");
+  BenchmarkStage & stage_eventReader = *stages.emplace(stages.end(), "EventReader::read");
+  BenchmarkStage & stage_eventReader_systematics = *stages.emplace(stages.end(), "EventReader::read (systematic shifts)");
+  BenchmarkStage & stage_genReaders = *stages.emplace(stages.end(), "Gen*Reader::read");
+  BenchmarkStage & stage_electronCleaner = *stages.emplace(stages.end(), "RecoElectronCollectionCleaner", numRepetitions);
+  BenchmarkStage & stage_hadTauCleaner = *stages.emplace(stages.end(), "RecoHadTauCollectionCleaner", numRepetitions);
+  BenchmarkStage & stage_jetCleanerAK4 = *stages.emplace(stages.end(), "RecoJetCollectionCleanerAK4", numRepetitions);
+  BenchmarkStage & stage_genMatchers = *stages.emplace(stages.end(), "ParticleCollectionGenMatcher");
+  std::vector<BenchmarkStage *> stages_luts;
+  for ( const lutWrapperBase * lut : luts )
+  {
+    stages_luts.push_back(&*stages.emplace(stages.end(), "lutWrapper " + lut->lutName(), numRepetitions));
+  }
+  std::vector<BenchmarkStage *> stages_writers;
+  for ( const std::string & writerName : readersAndWriters->writerNames_ )
+  {
+    stages_writers.push_back(&*stages.emplace(stages.end(), writerName, numRepetitions));
+  }
+
+  std::vector<GenLepton> genLeptons;
+  std::vector<GenLepton> genElectrons;
+  std::vector<GenLepton> genMuons;
+  std::vector<GenHadTau> genHadTaus;
+  std::vector<GenPhoton> genPhotons;
+  std::vector<GenJet> genJets;
+  EvtWeightRecorder evtWeightRecorder({ &sysId_central }, sysId_central, isMC);
+  double sum = 0.; // CV: accumulate the results, so that the compiler cannot optimize the repeated stages away
+  long long numEventsProcessed = 0;
+  while ( true )
+  {
+    bool hasNextEvent = false;
+    {
+      BenchmarkTimer timer(stage_getEntry);
+      hasNextEvent = inputTree->hasNextEvent();
+    }
+    if ( ! hasNextEvent )
+    {
+      break;
+    }
+    ++numEventsProcessed;
+
+//--- read the systematic shifts first, as each call to EventReader::read invalidates the objects returned by the previous call
+    for ( const SysId * sysId : sysIds )
+    {
+      if ( sysId->isCentral )
+      {
+        continue;
+      }
+      BenchmarkTimer timer(stage_eventReader_systematics);
+      eventReader->set_central_or_shift(*sysId);
+      const Event event = eventReader->read();
+      sum += event.selJetsAK4().size();
+    }
+    eventReader->set_central_or_shift(sysId_central);
+    // CV: the Event object is constructed in place by EventReader::read,
+    //     so that only the call to EventReader::read is timed and its allocations are counted
+    BenchmarkTimer timer_eventReader(stage_eventReader);
+    const Event event = eventReader->read();
+    timer_eventReader.stop();
+
+    for ( unsigned idxRepetition = 0; idxRepetition < numRepetitions; ++idxRepetition )
+    {
+      BenchmarkTimer timer(stage_electronCleaner);
+      sum += electronCleaner(event.looseElectrons(), event.looseMuons()).size();
+    }
+    for ( unsigned idxRepetition = 0; idxRepetition < numRepetitions; ++idxRepetition )
+    {
+      BenchmarkTimer timer(stage_hadTauCleaner);
+      sum += hadTauCleaner(event.fakeableHadTaus(), event.looseMuons(), event.looseElectrons()).size();
+    }
+    for ( unsigned idxRepetition = 0; idxRepetition < numRepetitions; ++idxRepetition )
+    {
+      BenchmarkTimer timer(stage_jetCleanerAK4);
+      sum += jetCleanerAK4(event.selJetsAK4(), event.fakeableLeptons(), event.fakeableHadTaus()).size();
+    }
+
+//--- the gen-matching modifies the reconstructed objects and is therefore run only once per event
+    if ( isMC )
+    {
+      {
+        BenchmarkTimer timer(stage_genReaders);
+        readersAndWriters->genLeptonReader_->read(genLeptons);
+        genElectrons.clear();
+        genMuons.clear();
+        for ( const GenLepton & genLepton : genLeptons )
+        {
+          if ( std::abs(genLepton.pdgId()) == 11 ) genElectrons.push_back(genLepton);
+          else                                     genMuons.push_back(genLepton);
+        }
+        readersAndWriters->genHadTauReader_->read(genHadTaus);
+        readersAndWriters->genPhotonReader_->read(genPhotons);
+        readersAndWriters->genJetReader_->read(genJets);
+      }
+      BenchmarkTimer timer(stage_genMatchers);
+      muonGenMatcher.addGenLeptonMatch(event.looseMuons(), genMuons);
+      muonGenMatcher.addGenHadTauMatch(event.looseMuons(), genHadTaus);
+      muonGenMatcher.addGenJetMatch(event.looseMuons(), genJets);
+      electronGenMatcher.addGenLeptonMatch(event.looseElectrons(), genElectrons);
+      electronGenMatcher.addGenPhotonMatch(event.looseElectrons(), genPhotons);
+      electronGenMatcher.addGenHadTauMatch(event.looseElectrons(), genHadTaus);
+      electronGenMatcher.addGenJetMatch(event.looseElectrons(), genJets);
+      hadTauGenMatcher.addGenLeptonMatch(event.fakeableHadTaus(), genLeptons);
+      hadTauGenMatcher.addGenHadTauMatch(event.fakeableHadTaus(), genHadTaus);
+      hadTauGenMatcher.addGenJetMatch(event.fakeableHadTaus(), genJets);
+      jetGenMatcherAK4.addGenLeptonMatch(event.selJetsAK4(), genLeptons);
+      jetGenMatcherAK4.addGenHadTauMatch(event.selJetsAK4(), genHadTaus);
+      jetGenMatcherAK4.addGenJetMatch(event.selJetsAK4(), genJets);
+    }
+
+    for ( std::size_t idxLut = 0; idxLut < luts.size(); ++idxLut )
+    {
+      for ( unsigned idxRepetition = 0; idxRepetition < numRepetitions; ++idxRepetition )
+      {
+        BenchmarkTimer timer(*stages_luts[idxLut]);
+        for ( const RecoLepton * lepton : event.fakeableLeptons() )
+        {
+          sum += luts[idxLut]->getSF(lepton->pt(), lepton->eta());
+        }
+      }
+    }
+
+    evtWeightRecorder.reset();
+    for ( std::size_t idxWriter = 0; idxWriter < writers.size(); ++idxWriter )
+    {
+      for ( unsigned idxRepetition = 0; idxRepetition < numRepetitions; ++idxRepetition )
+      {
+        BenchmarkTimer timer(*stages_writers[idxWriter]);
+        writers[idxWriter]->set_central_or_shift(sysId_central);
+        writers[idxWriter]->write(event, evtWeightRecorder);
+      }
+    }
+  }
+
+//--- report the time and the number of memory allocations per event;
+//    the numbers of repeated stages are divided by the number of repetitions
+  std::cout << "benchmarked " << numEventsProcessed << " events (numRepetitions = " << numRepetitions << ", checksum = " << sum << ")\n";
+  std::ofstream * reportFile = reportFileName.empty() ? nullptr : new std::ofstream(reportFileName);
+  if ( reportFile )
+  {
+    *reportFile << "stage,calls,ns/event,allocations/event\n";
+  }
+  std::cout << std::left << std::setw(40) << "stage" << std::right
+            << std::setw(14) << "calls"
+            << std::setw(14) << "ns/event"
+            << std::setw(20) << "allocations/event" << '\n';
+  for ( const BenchmarkStage & stage : stages )
+  {
+    if ( stage.calls_ == 0 )
+    {
+      continue;
+    }
+    const double norm = numEventsProcessed > 0 ? 1./(numEventsProcessed*stage.numRepetitions_) : 0.;
+    const double time_per_event = stage.time_*norm;
+    const double allocations_per_event = stage.allocations_*norm;
+    std::cout << std::left << std::setw(40) << stage.name_ << std::right
+              << std::setw(14) << stage.calls_
+              << std::fixed << std::setprecision(1)
+              << std::setw(14) << time_per_event
+              << std::setprecision(2)
+              << std::setw(20) << allocations_per_event << '\n';
+    std::cout.unsetf(std::ios_base::floatfield);
+    if ( reportFile )
+    {
+      *reportFile << stage.name_ << ',' << stage.calls_ << ',' << time_per_event << ',' << allocations_per_event << '\n';
+    }
+  }
+  if ( reportFile )
+  {
+    std::cout << "wrote benchmark results to " << reportFileName << '\n';
+  }
+  std::cout << std::flush;
+
+//--- memory clean-up
+  delete reportFile;
+  for ( lutWrapperBase * lut : luts )
+  {
+    delete lut;
+  }
+  for ( auto & kv : lutInputFiles )
+  {
+    delete kv.second;
+  }
+  delete readersAndWriters;
+  delete outputTree;
+  delete inputTree;
+
+  return EXIT_SUCCESS;
+}
@@ -19,7 +19,10 @@
 #include "TallinnNtupleProducer/CommonTools/interface/Era.h"                                    // Era, get_era()
 #include "TallinnNtupleProducer/CommonTools/interface/hadTauDefinitions.h"                      // get_tau_id_wp_int()
 #include "TallinnNtupleProducer/CommonTools/interface/merge_systematic_shifts.h"                // merge_systematic_shifts()
+#include "TallinnNtupleProducer/CommonTools/interface/StageProfiler.h"                          // StageProfiler, PROFILE_*
+#include "TallinnNtupleProducer/CommonTools/interface/SysIdRegistry.h"                          // SysId, SysIdRegistry
 #include "TallinnNtupleProducer/CommonTools/interface/tH_auxFunctions.h"                        // get_tH_SM_str()
+#include "TallinnNtupleProducer/CommonTools/interface/TTreeEntryIndex.h"                        // TTreeEntryIndex
 #include "TallinnNtupleProducer/CommonTools/interface/TTreeWrapper.h"                           // TTreeWrapper
 #include "TallinnNtupleProducer/EvtWeightTools/interface/BtagSFRatioInterface.h"                // BtagSFRatioInterface
 #include "TallinnNtupleProducer/EvtWeightTools/interface/ChargeMisIdRateInterface.h"            // ChargeMisIdRateInterface
@@ -52,57 +55,109 @@
 #include "TallinnNtupleProducer/Selectors/interface/RunLumiEventSelector.h"                     // RunLumiEventSelector
 #include "TallinnNtupleProducer/Writers/interface/WriterBase.h"                                 // WriterBase, WriterPluginFactory
 
+#include <Compression.h>                                                                        // ROOT::CompressionSettings(), ROOT::RCompressionSetting
 #include <TBenchmark.h>                                                                         // TBenchmark
+#include <TChain.h>                                                                             // TChain
+#include <TDirectory.h>                                                                         // TDirectory, TDirectory::TContext
 #include <TError.h>                                                                             // gErrorAbortLevel, kError
+#include <TFile.h>                                                                              // TFile
+#include <TROOT.h>                                                                              // ROOT::EnableThreadSafety(), ROOT::EnableImplicitMT()
 #include <TString.h>                                                                            // TString, Form()
 #include <TTree.h>                                                                              // TTree
+#include <TTreeFormula.h>                                                                       // TTreeFormula
      
 #include <boost/algorithm/string/replace.hpp>                                                   // boost::replace_all_copy()
-#include <boost/algorithm/string/predicate.hpp>                                                 // boost::starts_with()
+#include <boost/algorithm/string/predicate.hpp>                                                 // boost::starts_with(), boost::ends_with()
 
+#include <algorithm>                                                                            // std::min(), std::max()
 #include <assert.h>                                                                             // assert
+#include <cstdio>                                                                               // std::remove()
 #include <cstdlib>                                                                              // EXIT_SUCCESS, EXIT_FAILURE
+#include <exception>                                                                            // std::exception_ptr, std::current_exception(), std::rethrow_exception()
 #include <fstream>                                                                              // std::ofstream
 #include <iostream>                                                                             // std::cerr, std::fixed
 #include <iomanip>                                                                              // std::setprecision(), std::setw()
+#include <mutex>                                                                                // std::mutex, std::unique_lock
 #include <string>                                                                               // std::string
+#include <thread>                                                                               // std::thread
 #include <vector>                                                                               // std::vector
 
 typedef std::vector<std::string> vstring;
 
 /**
- * @brief Produce "plain" Ntuple, which is used for final event selection & histogram filling.
+ * @brief Return the compression settings of the output file, as configured by the parameters 'compressionAlgorithm' and 'compressionLevel'
+ *        of the fwliteOutput PSet, or -1 if the compression algorithm is not configured
  */
-int main(int argc, char* argv[])
+int
+getCompressionSettings(const edm::ParameterSet & cfg_fwliteOutput)
 {
-//--- throw an exception in case ROOT encounters an error
-  gErrorAbortLevel = kError;
-
-//--- stop ROOT from keeping track of all histograms
-  TH1::AddDirectory(false);
-
-//--- parse command-line arguments
-  if ( argc < 2 ) {
-    std::cout << "Usage: " << argv[0] << " [parameters.py]" << std::endl;
-    return EXIT_FAILURE;
+  if ( !cfg_fwliteOutput.exists("compressionAlgorithm") )
+  {
+    return -1;
+  }
+  const std::string compressionAlgorithm_str = cfg_fwliteOutput.getParameter<std::string>("compressionAlgorithm");
+  ROOT::RCompressionSetting::EAlgorithm::EValues compressionAlgorithm = ROOT::RCompressionSetting::EAlgorithm::kUseGlobal;
+  if      ( compressionAlgorithm_str == "ZLIB" ) compressionAlgorithm = ROOT::RCompressionSetting::EAlgorithm::kZLIB;
+  else if ( compressionAlgorithm_str == "LZMA" ) compressionAlgorithm = ROOT::RCompressionSetting::EAlgorithm::kLZMA;
+  else if ( compressionAlgorithm_str == "LZ4"  ) compressionAlgorithm = ROOT::RCompressionSetting::EAlgorithm::kLZ4;
+  else if ( compressionAlgorithm_str == "ZSTD" ) compressionAlgorithm = ROOT::RCompressionSetting::EAlgorithm::kZSTD;
+  else throw cmsException("produceNtuple", __LINE__) << "Invalid Configuration parameter 'compressionAlgorithm' = " << compressionAlgorithm_str << " !!";
+  const int compressionLevel = cfg_fwliteOutput.exists("compressionLevel") ? cfg_fwliteOutput.getParameter<int>("compressionLevel") : 4;
+  if ( compressionLevel < 0 || compressionLevel > 9 )
+  {
+    throw cmsException("produceNtuple", __LINE__) << "Invalid Configuration parameter 'compressionLevel' = " << compressionLevel << " !!";
   }
+  return ROOT::CompressionSettings(compressionAlgorithm, compressionLevel);
+}
 
-  std::cout << "<produceNtuple>:" << std::endl;
+/**
+ * @brief Event counters of one call to the processInputFiles function
+ */
+struct WorkerResult
+{
+  WorkerResult()
+    : analyzedEntries_(0)
+    , selectedEntries_(0)
+    , selectedEntries_weighted_(0.)
+    , cumulativeMaxEventCount_(0)
+    , processedFileCount_(0)
+    , fileCount_(0)
+  {}
 
-//--- keep track of time it takes the macro to execute
-  TBenchmark clock;
-  clock.Start("produceNtuple");
-std::cout << "break-point 1 reached" << std::endl;
-//--- read python configuration parameters
-  if ( !edm::readPSetsFrom(argv[1])->existsAs<edm::ParameterSet>("process") )
-    throw cmsException("produceNtuple", __LINE__) << "No ParameterSet 'process' found in configuration file = " << argv[1] << " !!";
-std::cout << "break-point 2 reached" << std::endl;
-  edm::ParameterSet cfg = edm::readPSetsFrom(argv[1])->getParameter<edm::ParameterSet>("process");
-std::cout << "break-point 3 reached" << std::endl;
-  edm::ParameterSet cfg_produceNtuple = cfg.getParameter<edm::ParameterSet>("produceNtuple");
+  int analyzedEntries_;
+  int selectedEntries_;
+  double selectedEntries_weighted_;
+  long long cumulativeMaxEventCount_;
+  int processedFileCount_;
+  int fileCount_;
+  std::exception_ptr exception_; ///< exception thrown while processing the input files, rethrown by the main thread
+};
+
+/**
+ * @brief Process the given input files and fill the selected entries into a new output tree, which is written to the given directory.
+ *        The selection is applied before each entry is filled, so that the output tree is streamed to disk
+ *        and its memory footprint does not grow with the number of analyzed entries.
+ *        Each call creates its own TTreeWrapper, EventReader, correction interfaces and writer plugins,
+ *        so that the input files can be split among several threads, each of which calls this function.
+ *        The construction of these objects is serialized by the mutex given as function argument,
+ *        while the event loops of the different threads run concurrently.
+ *        If an entry index is given, only the entries in the range [firstEntry, lastEntry), counted across all input files, are processed.
+ */
+WorkerResult
+processInputFiles(const edm::ParameterSet & cfg_produceNtuple,
+                  const vstring & inputFileNames,
+                  int maxEvents,
+                  const TTreeEntryIndex * entryIndex,
+                  long long firstEntry,
+                  long long lastEntry,
+                  TDirectory * outputDir,
+                  unsigned reportEvery,
+                  const SysIdRegistry & sysIdRegistry,
+                  std::mutex & mutex_init)
+{
+  std::unique_lock<std::mutex> lock_init(mutex_init);
   AnalysisConfig analysisConfig("produceNtuple", cfg_produceNtuple);
   std::string process = cfg_produceNtuple.getParameter<std::string>("process");
-std::cout << "break-point 4 reached" << std::endl;
   std::string treeName = cfg_produceNtuple.getParameter<std::string>("treeName");
 
   std::string era_string = cfg_produceNtuple.getParameter<std::string>("era");
@@ -115,7 +170,6 @@ std::cout << "break-point 4 reached" << std::endl;
   bool apply_topPtReweighting = ! apply_topPtReweighting_str.empty();
   bool apply_l1PreFireWeight = cfg_produceNtuple.getParameter<bool>("apply_l1PreFireWeight");
   bool apply_btagSFRatio = cfg_produceNtuple.getParameter<bool>("apply_btagSFRatio");
-std::cout << "break-point 5 reached" << std::endl;
   unsigned int numNominalLeptons = cfg_produceNtuple.getParameter<unsigned int>("numNominalLeptons");
   unsigned int numNominalHadTaus = cfg_produceNtuple.getParameter<unsigned int>("numNominalHadTaus");
 
@@ -123,36 +177,24 @@ std::cout << "break-point 5 reached" << std::endl;
   std::string hadTauWP_againstElectrons = cfg_produceNtuple.getParameter<std::string>("hadTauWP_againstElectrons");
   std::string hadTauWP_againstMuons = cfg_produceNtuple.getParameter<std::string>("hadTauWP_againstMuons");
   std::string lep_mva_wp = cfg_produceNtuple.getParameter<std::string>("lep_mva_wp");
-std::cout << "break-point 6 reached" << std::endl;
   bool apply_chargeMisIdRate = cfg_produceNtuple.getParameter<bool>("apply_chargeMisIdRate");
 
-  std::string selection = cfg_produceNtuple.getParameter<std::string>("selection");
-
   bool isDEBUG = cfg_produceNtuple.getParameter<bool>("isDEBUG");
-std::cout << "break-point 7 reached" << std::endl;
-  std::vector<std::string> systematic_shifts;
-  // CV: process all systematic uncertainties supported by EventReader class (only for MC)
-  if ( isMC )
-  {
-    merge_systematic_shifts(systematic_shifts, EventReader::get_supported_systematics());
-  }
-  // CV: add central value (for data and MC)
-  merge_systematic_shifts(systematic_shifts, { "central"});
-std::cout << "break-point 8 reached" << std::endl;
+  const std::vector<const SysId *> sysIds = sysIdRegistry.get_sysIds();
   edm::ParameterSet cfg_dataToMCcorrectionInterface;
   cfg_dataToMCcorrectionInterface.addParameter<std::string>("era", era_string);
   cfg_dataToMCcorrectionInterface.addParameter<std::string>("hadTauSelection_againstJets", hadTauWP_againstJets);
-std::cout << "break-point 8.1 reached" << std::endl;
-std::cout << "hadTauWP_againstJets = " << hadTauWP_againstJets << std::endl;
   cfg_dataToMCcorrectionInterface.addParameter<int>("hadTauSelection_againstElectrons", get_tau_id_wp_int(hadTauWP_againstElectrons));
-std::cout << "break-point 8.2 reached" << std::endl;
-std::cout << "hadTauWP_againstElectrons = " << get_tau_id_wp_int(hadTauWP_againstElectrons) << std::endl;
   cfg_dataToMCcorrectionInterface.addParameter<int>("hadTauSelection_againstMuons", get_tau_id_wp_int(hadTauWP_againstMuons));
-std::cout << "break-point 8.3 reached" << std::endl;
-std::cout << "hadTauWP_againstMuons = " << get_tau_id_wp_int(hadTauWP_againstMuons) << std::endl;
   cfg_dataToMCcorrectionInterface.addParameter<std::string>("lep_mva_wp", lep_mva_wp);
-std::cout << "lep_mva_wp = " << lep_mva_wp << std::endl;
   cfg_dataToMCcorrectionInterface.addParameter<bool>("isDEBUG", isDEBUG);
+  if ( isDEBUG )
+  {
+    std::cout << "hadTauWP_againstJets = " << hadTauWP_againstJets << '\n'
+              << "hadTauWP_againstElectrons = " << get_tau_id_wp_int(hadTauWP_againstElectrons) << '\n'
+              << "hadTauWP_againstMuons = " << get_tau_id_wp_int(hadTauWP_againstMuons) << '\n'
+              << "lep_mva_wp = " << lep_mva_wp << '\n';
+  }
   Data_to_MC_CorrectionInterface_Base * dataToMCcorrectionInterface = nullptr;
   switch ( era )
   {
@@ -162,15 +204,12 @@ std::cout << "lep_mva_wp = " << lep_mva_wp << std::endl;
     default: throw cmsException("produceNtuple", __LINE__) << "Invalid era = " << static_cast<int>(era);
   }
   const ChargeMisIdRateInterface chargeMisIdRateInterface(era);
-std::cout << "break-point 9 reached" << std::endl;
   edm::ParameterSet cfg_leptonFakeRateWeight = cfg_produceNtuple.getParameter<edm::ParameterSet>("leptonFakeRateWeight");
   cfg_leptonFakeRateWeight.addParameter<std::string>("era", era_string);
   LeptonFakeRateInterface* jetToLeptonFakeRateInterface = new LeptonFakeRateInterface(cfg_leptonFakeRateWeight);
-std::cout << "break-point 10 reached" << std::endl;
   edm::ParameterSet cfg_hadTauFakeRateWeight = cfg_produceNtuple.getParameter<edm::ParameterSet>("hadTauFakeRateWeight");
   cfg_hadTauFakeRateWeight.addParameter<std::string>("hadTauSelection", hadTauWP_againstJets);
   HadTauFakeRateInterface* jetToHadTauFakeRateInterface = new HadTauFakeRateInterface(cfg_hadTauFakeRateWeight);
-std::cout << "break-point 11 reached" << std::endl;
   std::string selEventsFileName = cfg_produceNtuple.getParameter<std::string>("selEventsFileName");
   std::cout << "selEventsFileName = " << selEventsFileName << std::endl;
   RunLumiEventSelector* run_lumi_eventSelector = 0;
@@ -180,23 +219,44 @@ std::cout << "break-point 11 reached" << std::endl;
     cfg_run_lumi_eventSelector.addParameter<std::string>("separator", ":");
     run_lumi_eventSelector = new RunLumiEventSelector(cfg_run_lumi_eventSelector);
   }
-std::cout << "break-point 12 reached" << std::endl;
-  fwlite::InputSource inputFiles(cfg);
-  int maxEvents = inputFiles.maxEvents();
-  std::cout << " maxEvents = " << maxEvents << std::endl;
-  unsigned reportEvery = inputFiles.reportAfter();
-std::cout << "break-point 13 reached" << std::endl;
-  fwlite::OutputFiles outputFile(cfg);
-  fwlite::TFileService fs = fwlite::TFileService(outputFile.file().data());
-std::cout << "break-point 14 reached" << std::endl;
-  TTreeWrapper* inputTree = new TTreeWrapper(treeName.data(), inputFiles.files(), maxEvents);
+  TTreeWrapper* inputTree = new TTreeWrapper(treeName.data(), inputFileNames, maxEvents);
   std::cout << "Loaded " << inputTree->getFileCount() << " file(s).\n";
-std::cout << "break-point 15 reached" << std::endl;
+  if ( entryIndex )
+  {
+    inputTree->setEntryRange(entryIndex, firstEntry, lastEntry);
+  }
+  if ( cfg_produceNtuple.exists("prefetchNextFile") )
+  {
+    inputTree->setPrefetch(cfg_produceNtuple.getParameter<bool>("prefetchNextFile"));
+  }
+  // CV: the TTreeCache is trained on exactly the branches bound by the readers,
+  //     and all other branches are disabled
+  if ( cfg_produceNtuple.exists("cacheSize") )
+  {
+    inputTree->setCacheSize(cfg_produceNtuple.getParameter<int>("cacheSize"));
+  }
+  if ( cfg_produceNtuple.exists("setBranchStatus") )
+  {
+    inputTree->setBranchStatus(cfg_produceNtuple.getParameter<bool>("setBranchStatus"));
+  }
   EventReader* eventReader = new EventReader(cfg_produceNtuple);
+  // CV: bind the branches for all systematic shifts at once,
+  //     so that each entry is read from the input files only once
+  eventReader->read_systematics(isMC);
   inputTree->registerReader(eventReader);
-std::cout << "break-point 16 reached" << std::endl;
+  // CV: read the multiplicity branches of muons, electrons, and hadronic taus first
+  //     and read all other branches only for events that contain enough leptons and hadronic taus
+  const bool applyPreselection = cfg_produceNtuple.exists("applyPreselection") ? cfg_produceNtuple.getParameter<bool>("applyPreselection") : false;
+  if ( applyPreselection )
+  {
+    inputTree->setPreselectionBranches(eventReader->get_preselectionBranchNames());
+  }
   TTree* outputTree = new TTree("events", "events");
-std::cout << "break-point 17 reached" << std::endl;
+  // CV: attach the output tree to the output file, so that the baskets are written to disk as they are filled;
+  //     the flush and autosave intervals are given in bytes if negative, or in entries if positive
+  outputTree->SetDirectory(outputDir);
+  outputTree->SetAutoFlush(cfg_produceNtuple.exists("outputAutoFlush") ? cfg_produceNtuple.getParameter<long long>("outputAutoFlush") : -30000000);
+  outputTree->SetAutoSave(cfg_produceNtuple.exists("outputAutoSave") ? cfg_produceNtuple.getParameter<long long>("outputAutoSave") : -300000000);
   const edm::ParameterSet additionalEvtWeight = cfg_produceNtuple.getParameter<edm::ParameterSet>("evtWeight");
   const bool applyAdditionalEvtWeight = additionalEvtWeight.getParameter<bool>("apply");
   EvtWeightManager* eventWeightManager = nullptr;
@@ -206,14 +266,12 @@ std::cout << "break-point 17 reached" << std::endl;
     eventWeightManager->set_central_or_shift("central");
     inputTree->registerReader(eventWeightManager);
   }
-std::cout << "break-point 18 reached" << std::endl;
   L1PreFiringWeightReader* l1PreFiringWeightReader = nullptr;
   if ( apply_l1PreFireWeight )
   {
     l1PreFiringWeightReader = new L1PreFiringWeightReader(cfg_produceNtuple);
     inputTree->registerReader(l1PreFiringWeightReader);
   }
-std::cout << "break-point 19 reached" << std::endl;
   LHEInfoReader* lheInfoReader = nullptr;
   PSWeightReader* psWeightReader = nullptr;
   if ( isMC )
@@ -223,51 +281,84 @@ std::cout << "break-point 19 reached" << std::endl;
     psWeightReader = new PSWeightReader(cfg_produceNtuple);
     inputTree->registerReader(psWeightReader);
   }
-std::cout << "break-point 20 reached" << std::endl;
   BtagSFRatioInterface* btagSFRatioInterface = nullptr;
   if ( apply_btagSFRatio )
   {
     const edm::ParameterSet btagSFRatio = cfg_produceNtuple.getParameterSet("btagSFRatio");
     btagSFRatioInterface = new BtagSFRatioInterface(btagSFRatio);
   }
-std::cout << "break-point 21 reached" << std::endl;
-  edmplugin::PluginManager::Config config;
-  edmplugin::PluginManager::configure(edmplugin::standard::config());
   edm::VParameterSet cfg_writers = cfg_produceNtuple.getParameterSetVector("writerPlugins");
   std::vector<WriterBase*> writers;
+  std::vector<std::string> writerNames; // CV: names of the writer plugins, used to label the per-stage timing information
   for ( auto cfg_writer : cfg_writers )
   {
-std::cout << "break-point 21.1 reached" << std::endl;
     std::string pluginType = cfg_writer.getParameter<std::string>("pluginType");
-std::cout << "pluginType = " << pluginType << std::endl;
     cfg_writer.addParameter<unsigned int>("numNominalLeptons", numNominalLeptons);
     cfg_writer.addParameter<unsigned int>("numNominalHadTaus", numNominalHadTaus);
     cfg_writer.addParameter<std::string>("process", process);
     cfg_writer.addParameter<bool>("isMC", isMC);
-std::cout << "break-point 21.2 reached" << std::endl;
-    WriterBase* writer = WriterPluginFactory::get()->create(pluginType, cfg_writer).get();
-std::cout << "break-point 21.3 reached" << std::endl;
+    WriterBase* writer = WriterPluginFactory::get()->create(pluginType, cfg_writer).release();
     writer->registerReaders(inputTree);
-std::cout << "break-point 21.4 reached" << std::endl;
     writer->setBranches(outputTree);
-std::cout << "break-point 21.5 reached" << std::endl;
     writers.push_back(writer);
-std::cout << "break-point 21.6 reached" << std::endl;
+    writerNames.push_back(pluginType);
+  }
+  // CV: compile the selection once, after the branches of all writer plugins have been booked;
+  //     the quick-load mode makes the formula use the values in the branch buffers of the writer plugins,
+  //     instead of reading the current entry back from the output tree
+  std::string selection = cfg_produceNtuple.getParameter<std::string>("selection");
+  TTreeFormula* selectionFormula = nullptr;
+  if ( selection != "" )
+  {
+    selectionFormula = new TTreeFormula("selection", selection.data(), outputTree);
+    if ( selectionFormula->GetNdim() == 0 )
+    {
+      throw cmsException("produceNtuple", __LINE__) << "Invalid Configuration parameter 'selection' = " << selection << " !!";
+    }
+    selectionFormula->SetQuickLoad(true);
   }
-std::cout << "break-point 22 reached" << std::endl;
+  // CV: the weights are recorded for one systematic shift at a time, reusing the same EvtWeightRecorder object for all entries and systematic shifts
+  EvtWeightRecorder evtWeightRecorder({ sysIds.front() }, *sysIds.front(), isMC);
+  lock_init.unlock();
   int analyzedEntries = 0;
-  TH1* histogram_analyzedEntries = fs.make<TH1D>("analyzedEntries", "analyzedEntries", 1, -0.5, +0.5);
-  for ( auto central_or_shift : systematic_shifts )
+  int selectedEntries = 0;
+  double selectedEntries_weighted = 0.;
+  while ( inputTree->hasNextEvent() && (!run_lumi_eventSelector || (run_lumi_eventSelector && !run_lumi_eventSelector->areWeDone())) )
   {
-std::cout << "break-point 23 reached" << std::endl;
-    inputTree->reset();
-std::cout << "break-point 24 reached" << std::endl;
-    while ( inputTree->hasNextEvent() && (!run_lumi_eventSelector || (run_lumi_eventSelector && !run_lumi_eventSelector->areWeDone())) )
+    if ( applyPreselection )
     {
-std::cout << "break-point 25 reached" << std::endl;
-      eventReader->set_central_or_shift(central_or_shift);
+      if ( !eventReader->passesPreselection() )
+      {
+        ++analyzedEntries;
+        continue;
+      }
+      PROFILE_COUNT("events passing preselection", 1);
+      PROFILE_SCOPE("TTreeWrapper::getEntry_remaining");
+      inputTree->getEntry_remaining();
+    }
+    // CV: the run, luminosity section and event numbers do not depend on the systematic shift,
+    //     so the event selection by run, luminosity section and event number is applied once per entry
+    //     (RunLumiEventSelector selects each event only on its first match)
+    if ( run_lumi_eventSelector && !(*run_lumi_eventSelector)(eventReader->read_eventInfo()) )
+    {
+      ++analyzedEntries;
+      continue;
+    }
+    if ( isMC )
+    {
+      // CV: LHE and parton-shower weights do not depend on the systematic shift
+      lheInfoReader->read();
+      psWeightReader->read();
+    }
+    // CV: each entry is read from the input files only once and all systematic shifts are evaluated on the same branch buffers;
+    //     the writer plugins keep separate branches for each systematic shift, so the output tree is filled once per entry
+    bool isSelected = true;
+    double evtWeight = 1.;
+    for ( const SysId * sysId : sysIds )
+    {
+      eventReader->set_central_or_shift(*sysId);
       Event event = eventReader->read();
-      if ( central_or_shift == "central" )
+      if ( sysId->isCentral )
       {
         if ( inputTree->canReport(reportEvery) )
         {
@@ -278,64 +369,54 @@ std::cout << "break-point 25 reached" << std::endl;
                     << ") file\n";
         }
         ++analyzedEntries;
-        histogram_analyzedEntries->Fill(0.);
       }
-std::cout << "break-point 26 reached" << std::endl;
-      if ( run_lumi_eventSelector )
-      { 
-        if ( !(*run_lumi_eventSelector)(event.eventInfo()) )
-        {
-          continue;
-        }
-        if ( central_or_shift == "central" )
+      if ( run_lumi_eventSelector && sysId->isCentral )
+      {
+        std::cout << "processing Entry " << inputTree->getCurrentMaxEventIdx() << ": " << event.eventInfo() << '\n';
+        if ( inputTree->isOpen() )
         {
-          std::cout << "processing Entry " << inputTree->getCurrentMaxEventIdx() << ": " << event.eventInfo() << '\n';
-          if ( inputTree->isOpen() )
-          {
-            std::cout << "input File = " << inputTree->getCurrentFileName() << '\n';
-          }
+          std::cout << "input File = " << inputTree->getCurrentFileName() << '\n';
         }
       }
-std::cout << "break-point 27 reached" << std::endl;
-      if ( central_or_shift == "central"  && isDEBUG )
+      if ( sysId->isCentral && isDEBUG )
       {
         std::cout << "event #" << inputTree->getCurrentMaxEventIdx() << ' ' << event.eventInfo() << '\n';
       }
 
-      EvtWeightRecorder evtWeightRecorder({ central_or_shift }, central_or_shift, isMC);
+      evtWeightRecorder.reset(*sysId);
       if ( isMC )
       {
+        PROFILE_START(timer_evtWeights, "EvtWeightRecorder::record_*Weight");
         if ( apply_genWeight         ) evtWeightRecorder.record_genWeight(event.eventInfo());
         if ( eventWeightManager      )
         { 
-          eventWeightManager->set_central_or_shift(central_or_shift);
+          eventWeightManager->set_central_or_shift(sysId->central_or_shift);
           evtWeightRecorder.record_auxWeight(eventWeightManager);
         }
         if ( l1PreFiringWeightReader ) evtWeightRecorder.record_l1PrefireWeight(l1PreFiringWeightReader);
         if ( apply_topPtReweighting  ) evtWeightRecorder.record_toppt_rwgt(event.eventInfo().topPtRwgtSF);
-        lheInfoReader->read();
-        psWeightReader->read();
         evtWeightRecorder.record_lheScaleWeight(lheInfoReader);
         evtWeightRecorder.record_psWeight(psWeightReader);
         evtWeightRecorder.record_puWeight(&event.eventInfo());
         evtWeightRecorder.record_nom_tH_weight(&event.eventInfo());
         evtWeightRecorder.record_lumiScale(lumiScale);
-std::cout << "break-point 28 reached" << std::endl;
+        PROFILE_STOP(timer_evtWeights);
 //--- compute event-level weight for data/MC correction of b-tagging efficiency and mistag rate
 //   (using the method "Event reweighting using scale factors calculated with a tag and probe method",
 //    described on the BTV POG twiki https://twiki.cern.ch/twiki/bin/view/CMS/BTagShapeCalibration )
+        PROFILE_START(timer_btagWeights, "EvtWeightRecorder::record_btag*");
         evtWeightRecorder.record_btagWeight(event.selJetsAK4());
         if ( btagSFRatioInterface )
         {
           evtWeightRecorder.record_btagSFRatio(btagSFRatioInterface, event.selJetsAK4().size());
         }
-std::cout << "break-point 29 reached" << std::endl;
         if ( analysisConfig.isMC_EWK() )
         {
           evtWeightRecorder.record_ewk_jet(event.selJetsAK4());
           evtWeightRecorder.record_ewk_bjet(event.selJetsAK4_btagMedium());
         }
-std::cout << "break-point 30 reached" << std::endl;
+        PROFILE_STOP(timer_btagWeights);
+        PROFILE_START(timer_leptonSFs, "EvtWeightRecorder::record_lepton*");
         dataToMCcorrectionInterface->setLeptons(event.fakeableLeptons(), true);
 
 //--- apply data/MC corrections for trigger efficiency
@@ -347,20 +428,25 @@ std::cout << "break-point 30 reached" << std::endl;
 //--- apply data/MC corrections for efficiencies of leptons passing the loose identification and isolation criteria
 //    to also pass the fakeable and/or tight identification and isolation criteria
         evtWeightRecorder.record_leptonIDSF_looseToTight(dataToMCcorrectionInterface, false);
+        PROFILE_STOP(timer_leptonSFs);
 
 //--- apply data/MC corrections for hadronic tau identification efficiency
 //    and for e->tau and mu->tau misidentification rates
+        PROFILE_START(timer_hadTauSFs, "EvtWeightRecorder::record_hadTau*");
         dataToMCcorrectionInterface->setHadTaus(event.fakeableHadTaus());
         evtWeightRecorder.record_hadTauID_and_Iso(dataToMCcorrectionInterface);
         evtWeightRecorder.record_eToTauFakeRate(dataToMCcorrectionInterface);
         evtWeightRecorder.record_muToTauFakeRate(dataToMCcorrectionInterface);
+        PROFILE_STOP(timer_hadTauSFs);
 
+        PROFILE_START(timer_fakeRates, "EvtWeightRecorder::record_jetTo*FakeRate");
         evtWeightRecorder.record_jetToLeptonFakeRate(jetToLeptonFakeRateInterface, event.fakeableLeptons());
         evtWeightRecorder.record_jetToTauFakeRate(jetToHadTauFakeRateInterface, event.fakeableHadTaus());
         evtWeightRecorder.compute_FR();
-std::cout << "break-point 31 reached" << std::endl;
+        PROFILE_STOP(timer_fakeRates);
         if ( apply_chargeMisIdRate )
         {
+          PROFILE_SCOPE("EvtWeightRecorder::record_chargeMisIdProb");
           if ( numNominalLeptons == 2 && numNominalHadTaus == 0 )
           {
             double prob_chargeMisId_sum = 1.;
@@ -382,7 +468,13 @@ std::cout << "break-point 31 reached" << std::endl;
                             << "(leading lepton: charge = " << fakeableLepton_lead->charge() << ", pdgId = " << fakeableLepton_lead->pdgId() << "; "
                             << " subleading lepton: charge = " << fakeableLepton_sublead->charge() << ", pdgId = " << fakeableLepton_sublead->pdgId() << ")\n";
                 }
-                continue;
+                // CV: the central value decides whether the event is written to the output tree;
+                //     for systematic shifts, the event is kept with an event weight of zero
+                if ( sysId->isCentral )
+                {
+                  isSelected = false;
+                  break;
+                }
               }
             }
             evtWeightRecorder.record_chargeMisIdProb(prob_chargeMisId_sum);
@@ -423,7 +515,11 @@ std::cout << "break-point 31 reached" << std::endl;
                             << " subleading lepton: charge = " << fakeableLepton_sublead->charge() << ", pdgId = " << fakeableLepton_sublead->pdgId() << ";" 
                             << " hadTau: charge = " << fakeableHadTau->charge() << ")\n";
                 }
-                continue;
+                if ( sysId->isCentral )
+                {
+                  isSelected = false;
+                  break;
+                }
               }
             }
             evtWeightRecorder.record_chargeMisIdProb(prob_chargeMisId);
@@ -436,66 +532,356 @@ std::cout << "break-point 31 reached" << std::endl;
           }
         }
       }
-std::cout << "break-point 32 reached" << std::endl;
-      for ( auto writer : writers )
+      if ( sysId->isCentral )
       {
-        writer->set_central_or_shift(central_or_shift);
-        writer->write(event, evtWeightRecorder);
+        evtWeight = evtWeightRecorder.get(*sysId);
       }
+      for ( std::size_t idxWriter = 0; idxWriter < writers.size(); ++idxWriter )
+      {
+        PROFILE_SCOPE_DYNAMIC(writerNames[idxWriter]);
+        writers[idxWriter]->set_central_or_shift(*sysId);
+        writers[idxWriter]->write(event, evtWeightRecorder);
+      }
+    }
+    if ( isSelected && selectionFormula )
+    {
+      PROFILE_SCOPE("selection");
+      selectionFormula->GetNdata();
+      isSelected = selectionFormula->EvalInstance() != 0.;
+    }
+    if ( isSelected )
+    {
+      PROFILE_SCOPE("TTree::Fill");
+      outputTree->Fill();
+      PROFILE_COUNT("selected events", 1);
+      ++selectedEntries;
+      selectedEntries_weighted += evtWeight;
     }
-std::cout << "break-point 33 reached" << std::endl;
-    outputTree->Fill();
   }
-std::cout << "break-point 34 reached" << std::endl;
-  TFileDirectory outputDir = fs.mkdir("events");
-  outputDir.cd();
-std::cout << "break-point 35 reached" << std::endl;
-  TTree* outputTree_selected = outputTree->CopyTree(selection.data());
-  Float_t evtWeight;
-  outputTree_selected->SetBranchAddress("evtWeight", &evtWeight);
-  int selectedEntries = 0;
-  double selectedEntries_weighted = 0.;
-  TH1* histogram_selectedEntries = fs.make<TH1D>("selectedEntries", "selectedEntries", 1, -0.5, +0.5);
-  int numEntries = outputTree_selected->GetEntries();
-  for ( int idxEntry = 0; idxEntry < numEntries; ++idxEntry )
+  WorkerResult result;
+  result.analyzedEntries_ = analyzedEntries;
+  result.selectedEntries_ = selectedEntries;
+  result.selectedEntries_weighted_ = selectedEntries_weighted;
+  result.cumulativeMaxEventCount_ = inputTree->getCumulativeMaxEventCount();
+  result.processedFileCount_ = inputTree->getProcessedFileCount();
+  result.fileCount_ = inputTree->getFileCount();
+  // CV: write the remaining baskets and the tree header to the output file
   {
-    outputTree_selected->GetEntry(idxEntry);
-    ++selectedEntries;
-    selectedEntries_weighted += evtWeight;
-    histogram_selectedEntries->Fill(0.);
+    TDirectory::TContext context(outputDir);
+    outputTree->Write();
   }
-  outputTree_selected->Write();
-std::cout << "break-point 36 reached" << std::endl;
-  std::cout << "max num. Entries = " << inputTree->getCumulativeMaxEventCount()
-            << " (limited by " << maxEvents << ") processed in "
-            << inputTree->getProcessedFileCount() << " file(s) (out of "
-            << inputTree->getFileCount() << ")\n"
-            << " analyzed = " << analyzedEntries << '\n'
-            << " selected = " << selectedEntries << " (weighted = " << selectedEntries_weighted << ")" << std::endl;
-std::cout << "break-point 37 reached" << std::endl;
 //--- memory clean-up
+  delete selectionFormula;
+  delete outputTree;
   delete run_lumi_eventSelector;
-std::cout << "break-point 38 reached" << std::endl;
   delete eventReader;
   delete l1PreFiringWeightReader;
   delete lheInfoReader;
   delete psWeightReader;
-std::cout << "break-point 39 reached" << std::endl;
   delete dataToMCcorrectionInterface;
   delete jetToLeptonFakeRateInterface;
   delete jetToHadTauFakeRateInterface;
   delete btagSFRatioInterface;
-std::cout << "break-point 40 reached" << std::endl;
   for ( auto writer : writers )
   {
     delete writer;
   }
-std::cout << "break-point 41 reached" << std::endl;
   delete inputTree;
-  delete outputTree;
-  delete outputTree_selected;
-std::cout << "break-point 42 reached" << std::endl;
+  return result;
+}
+
+/**
+ * @brief Produce "plain" Ntuple, which is used for final event selection & histogram filling.
+ */
+int main(int argc, char* argv[])
+{
+//--- throw an exception in case ROOT encounters an error
+  gErrorAbortLevel = kError;
+
+//--- stop ROOT from keeping track of all histograms
+  TH1::AddDirectory(false);
+
+//--- parse command-line arguments
+  if ( argc < 2 ) {
+    std::cout << "Usage: " << argv[0] << " [parameters.py]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "<produceNtuple>:" << std::endl;
+
+//--- keep track of time it takes the macro to execute
+  TBenchmark clock;
+  clock.Start("produceNtuple");
+//--- read python configuration parameters
+  if ( !edm::readPSetsFrom(argv[1])->existsAs<edm::ParameterSet>("process") )
+    throw cmsException("produceNtuple", __LINE__) << "No ParameterSet 'process' found in configuration file = " << argv[1] << " !!";
+  edm::ParameterSet cfg = edm::readPSetsFrom(argv[1])->getParameter<edm::ParameterSet>("process");
+  edm::ParameterSet cfg_produceNtuple = cfg.getParameter<edm::ParameterSet>("produceNtuple");
+  bool isMC = cfg_produceNtuple.getParameter<bool>("isMC");
+
+  unsigned nThreads = cfg_produceNtuple.exists("nThreads") ? cfg_produceNtuple.getParameter<unsigned>("nThreads") : 1;
+  if ( nThreads < 1 )
+  {
+    throw cmsException("produceNtuple", __LINE__) << "Invalid Configuration parameter 'nThreads' = " << nThreads << " !!";
+  }
+  std::vector<std::string> systematic_shifts;
+  // CV: add central value (for data and MC);
+  //     the central value needs to be processed first, as it decides whether or not an event is written to the output tree
+  merge_systematic_shifts(systematic_shifts, { "central"});
+  // CV: process all systematic uncertainties supported by EventReader class (only for MC)
+  if ( isMC )
+  {
+    merge_systematic_shifts(systematic_shifts, EventReader::get_supported_systematics());
+  }
+  // CV: resolve the options for all systematic shifts once, instead of parsing the names of the systematic shifts for every event
+  const SysIdRegistry sysIdRegistry(systematic_shifts, isMC);
+  fwlite::InputSource inputFiles(cfg);
+  int maxEvents = inputFiles.maxEvents();
+  std::cout << " maxEvents = " << maxEvents << std::endl;
+  unsigned reportEvery = inputFiles.reportAfter();
+  fwlite::OutputFiles outputFile(cfg);
+  fwlite::TFileService fs = fwlite::TFileService(outputFile.file().data());
+//--- set the compression algorithm and level of the output file;
+//    with implicit multi-threading enabled, the baskets of the output tree are compressed and written in parallel by the ROOT thread pool
+//    whenever the output tree is flushed, instead of sequentially in the thread that calls TTree::Fill
+  const edm::ParameterSet cfg_fwliteOutput = cfg.getParameter<edm::ParameterSet>("fwliteOutput");
+  const int compressionSettings = getCompressionSettings(cfg_fwliteOutput);
+  if ( compressionSettings >= 0 )
+  {
+    fs.getBareDirectory()->GetFile()->SetCompressionSettings(compressionSettings);
+  }
+  const unsigned nCompressionThreads = cfg_fwliteOutput.exists("nCompressionThreads") ? cfg_fwliteOutput.getParameter<unsigned>("nCompressionThreads") : 0;
+  if ( nCompressionThreads > 0 )
+  {
+    ROOT::EnableImplicitMT(nCompressionThreads);
+  }
+  edmplugin::PluginManager::Config config;
+  edmplugin::PluginManager::configure(edmplugin::standard::config());
+
+//--- process only the entries in the range [firstEntry, lastEntry), counted across all input files, if requested;
+//    the number of entries and cluster boundaries of each input file are read from the index file or, if it does not exist yet, determined once and written to it,
+//    so that the input files preceding the entry range do not need to be opened
+  long long firstEntry = cfg_produceNtuple.exists("firstEntry") ? cfg_produceNtuple.getParameter<long long>("firstEntry") : 0;
+  long long lastEntry = cfg_produceNtuple.exists("lastEntry") ? cfg_produceNtuple.getParameter<long long>("lastEntry") : -1;
+  const bool processEntryRange = firstEntry > 0 || lastEntry >= 0;
+//--- split the input files among threads;
+//    each thread processes its share of the input files with its own reader, writer and correction-interface instances
+  const vstring & inputFileNames = inputFiles.files();
+  if ( ! processEntryRange )
+  {
+    // CV: in entry-range mode, each thread processes a share of the entries (reading all input files),
+    //     otherwise each thread processes a share of the input files
+    nThreads = std::max(1u, std::min(nThreads, static_cast<unsigned>(inputFileNames.size())));
+  }
+  if ( nThreads > 1 )
+  {
+    for ( const edm::ParameterSet & cfg_writer : cfg_produceNtuple.getParameterSetVector("writerPlugins") )
+    {
+      // CV: the python implementation of the LO HH reweighting uses an embedded python interpreter,
+      //     which must not be called from multiple threads
+      if ( cfg_writer.getParameter<std::string>("pluginType") == "EvtReweightWriter_HH" &&
+           cfg_writer.exists("usePython") && cfg_writer.getParameter<bool>("usePython") )
+      {
+        throw cmsException("produceNtuple", __LINE__) << "Writer plugin 'EvtReweightWriter_HH' does not support Configuration parameter 'nThreads' > 1 if 'usePython' is enabled !!";
+      }
+    }
+  }
+  // CV: the input files are opened in a background thread if the Configuration parameter 'prefetchNextFile' is enabled
+  const bool prefetchNextFile = cfg_produceNtuple.exists("prefetchNextFile") ? cfg_produceNtuple.getParameter<bool>("prefetchNextFile") : false;
+  if ( nThreads > 1 || prefetchNextFile )
+  {
+    ROOT::EnableThreadSafety();
+  }
+  std::cout << "processing " << inputFileNames.size() << " input file(s) in " << nThreads << " thread(s)" << std::endl;
+  const std::string entryIndexFile = cfg_produceNtuple.exists("entryIndexFile") ? cfg_produceNtuple.getParameter<std::string>("entryIndexFile") : "";
+  const bool alignEntryRangeToClusters = cfg_produceNtuple.exists("alignEntryRangeToClusters") ? cfg_produceNtuple.getParameter<bool>("alignEntryRangeToClusters") : false;
+  TTreeEntryIndex* entryIndex = nullptr;
+  std::vector<vstring> inputFileNames_per_thread(nThreads);
+  std::vector<long long> firstEntry_per_thread(nThreads, 0);
+  std::vector<long long> lastEntry_per_thread(nThreads, -1);
+  if ( processEntryRange )
+  {
+    entryIndex = new TTreeEntryIndex(cfg_produceNtuple.getParameter<std::string>("treeName"), inputFileNames, entryIndexFile);
+    if ( lastEntry < 0 || lastEntry > entryIndex->getEntryCount() )
+    {
+      lastEntry = entryIndex->getEntryCount();
+    }
+    if ( alignEntryRangeToClusters )
+    {
+      firstEntry = entryIndex->alignToCluster(firstEntry);
+      lastEntry = entryIndex->alignToCluster(lastEntry);
+    }
+    std::cout << "processing entries [" << firstEntry << ", " << lastEntry << ") out of " << entryIndex->getEntryCount() << std::endl;
+    // CV: split the entry range evenly among threads, each of which reads the input files that contain its share of the entries
+    for ( unsigned idxThread = 0; idxThread < nThreads; ++idxThread )
+    {
+      inputFileNames_per_thread[idxThread] = inputFileNames;
+      firstEntry_per_thread[idxThread] = firstEntry + ((lastEntry - firstEntry)*idxThread)/nThreads;
+      lastEntry_per_thread[idxThread] = firstEntry + ((lastEntry - firstEntry)*(idxThread + 1))/nThreads;
+      if ( alignEntryRangeToClusters )
+      {
+        firstEntry_per_thread[idxThread] = entryIndex->alignToCluster(firstEntry_per_thread[idxThread]);
+        lastEntry_per_thread[idxThread] = entryIndex->alignToCluster(lastEntry_per_thread[idxThread]);
+      }
+    }
+  }
+  else
+  {
+    for ( size_t idxInputFile = 0; idxInputFile < inputFileNames.size(); ++idxInputFile )
+    {
+      inputFileNames_per_thread[idxInputFile % nThreads].push_back(inputFileNames[idxInputFile]);
+    }
+  }
+  std::vector<int> maxEvents_per_thread(nThreads, maxEvents);
+  if ( maxEvents >= 0 )
+  {
+    // CV: split maxEvents evenly among threads, as each thread counts processed events separately
+    for ( int idxThread = 0; idxThread < static_cast<int>(nThreads); ++idxThread )
+    {
+      maxEvents_per_thread[idxThread] = maxEvents/static_cast<int>(nThreads) + (idxThread < maxEvents % static_cast<int>(nThreads) ? 1 : 0);
+    }
+  }
+//--- each thread streams its output tree into a separate file, as a TFile must not be written by multiple threads;
+//    in case only one thread is used, the output tree is written directly into the output file
+  TFileDirectory outputDir = fs.mkdir("events");
+  std::vector<TFile*> outputFiles_per_thread;
+  std::vector<TDirectory*> outputDirs_per_thread(1, outputDir.getBareDirectory());
+  if ( nThreads > 1 )
+  {
+    outputDirs_per_thread.clear();
+    for ( unsigned idxThread = 0; idxThread < nThreads; ++idxThread )
+    {
+      // CV: only a trailing ".root" is replaced, so that all threads write to different files, whatever the name of the output file
+      std::string outputFileName_thread = outputFile.file();
+      if ( boost::ends_with(outputFileName_thread, ".root") )
+      {
+        outputFileName_thread.erase(outputFileName_thread.size() - std::string(".root").size());
+      }
+      outputFileName_thread += Form("_thread%u.root", idxThread);
+      if ( outputFileName_thread == outputFile.file() )
+      {
+        throw cmsException("produceNtuple", __LINE__) << "Output file of thread #" << idxThread << " must not be the output file = '" << outputFile.file() << "' !!";
+      }
+      TFile* outputFile_thread = new TFile(outputFileName_thread.data(), "RECREATE");
+      if ( compressionSettings >= 0 )
+      {
+        outputFile_thread->SetCompressionSettings(compressionSettings);
+      }
+      outputFiles_per_thread.push_back(outputFile_thread);
+      outputDirs_per_thread.push_back(outputFile_thread);
+    }
+  }
+  std::mutex mutex_init;
+  std::vector<WorkerResult> results(nThreads);
+  auto processInputFiles_thread = [&](unsigned idxThread)
+  {
+    try
+    {
+      results[idxThread] = processInputFiles(
+        cfg_produceNtuple, inputFileNames_per_thread[idxThread], maxEvents_per_thread[idxThread],
+        entryIndex, firstEntry_per_thread[idxThread], lastEntry_per_thread[idxThread], outputDirs_per_thread[idxThread],
+        reportEvery, sysIdRegistry, mutex_init
+      );
+    }
+    catch ( ... )
+    {
+      results[idxThread].exception_ = std::current_exception();
+    }
+  };
+  if ( nThreads == 1 )
+  {
+    processInputFiles_thread(0);
+  }
+  else
+  {
+    std::vector<std::thread> threads;
+    for ( unsigned idxThread = 0; idxThread < nThreads; ++idxThread )
+    {
+      threads.push_back(std::thread(processInputFiles_thread, idxThread));
+    }
+    for ( std::thread & thread : threads )
+    {
+      thread.join();
+    }
+  }
+  int analyzedEntries = 0;
+  int selectedEntries = 0;
+  double selectedEntries_weighted = 0.;
+  long long cumulativeMaxEventCount = 0;
+  int processedFileCount = 0;
+  int fileCount = 0;
+  for ( const WorkerResult & result : results )
+  {
+    if ( result.exception_ )
+    {
+      std::rethrow_exception(result.exception_);
+    }
+    analyzedEntries += result.analyzedEntries_;
+    selectedEntries += result.selectedEntries_;
+    selectedEntries_weighted += result.selectedEntries_weighted_;
+    cumulativeMaxEventCount += result.cumulativeMaxEventCount_;
+    processedFileCount += result.processedFileCount_;
+    // CV: in entry-range mode, each thread receives all input files, which are counted only once
+    fileCount = processEntryRange ? result.fileCount_ : fileCount + result.fileCount_;
+  }
+  TH1* histogram_analyzedEntries = fs.make<TH1D>("analyzedEntries", "analyzedEntries", 1, -0.5, +0.5);
+  histogram_analyzedEntries->SetBinContent(1, analyzedEntries);
+  histogram_analyzedEntries->SetEntries(analyzedEntries);
+  TH1* histogram_selectedEntries = fs.make<TH1D>("selectedEntries", "selectedEntries", 1, -0.5, +0.5);
+  histogram_selectedEntries->SetBinContent(1, selectedEntries);
+  histogram_selectedEntries->SetEntries(selectedEntries);
+//--- store the number of calls and the time spent in each stage of the event processing,
+//    if the instrumentation has been compiled in (-DTALLINN_ENABLE_PROFILING)
+  if ( StageProfiler::isEnabled() )
+  {
+    StageProfiler::print(std::cout, analyzedEntries);
+    const std::vector<StageProfiler::Stage> stages = StageProfiler::getStages();
+    const int numStages = stages.size();
+    TH1* histogram_profiling_calls = fs.make<TH1D>("profiling_calls", "profiling_calls", numStages, -0.5, numStages - 0.5);
+    TH1* histogram_profiling_time = fs.make<TH1D>("profiling_time", "profiling_time [s]", numStages, -0.5, numStages - 0.5);
+    TH1* histogram_profiling_meanTime = fs.make<TH1D>("profiling_meanTime", "profiling_meanTime [us]", numStages, -0.5, numStages - 0.5);
+    for ( int idxStage = 0; idxStage < numStages; ++idxStage )
+    {
+      const StageProfiler::Stage & stage = stages[idxStage];
+      const double time = 1.e-9*stage.time_;
+      histogram_profiling_calls->SetBinContent(idxStage + 1, stage.calls_);
+      histogram_profiling_time->SetBinContent(idxStage + 1, time);
+      histogram_profiling_meanTime->SetBinContent(idxStage + 1, stage.calls_ > 0 ? 1.e+6*time/stage.calls_ : 0.);
+      for ( TH1* histogram : { histogram_profiling_calls, histogram_profiling_time, histogram_profiling_meanTime } )
+      {
+        histogram->GetXaxis()->SetBinLabel(idxStage + 1, stage.name_.data());
+      }
+    }
+  }
+//--- merge the output trees written by the different threads into the output file;
+//    the baskets are copied without being decompressed
+  if ( nThreads > 1 )
+  {
+    TChain outputChain("events");
+    for ( TFile* outputFile_thread : outputFiles_per_thread )
+    {
+      outputChain.Add(outputFile_thread->GetName());
+      outputFile_thread->Close();
+    }
+    outputDir.cd();
+    TTree* outputTree = outputChain.CloneTree(-1, "fast");
+    outputTree->Write();
+    delete outputTree;
+    outputChain.Reset();
+    for ( TFile* outputFile_thread : outputFiles_per_thread )
+    {
+      std::remove(outputFile_thread->GetName());
+      delete outputFile_thread;
+    }
+  }
+  std::cout << "max num. Entries = " << cumulativeMaxEventCount
+            << " (limited by " << maxEvents << ") processed in "
+            << processedFileCount << " file(s) (out of "
+            << fileCount << ")\n"
+            << " analyzed = " << analyzedEntries << '\n'
+            << " selected = " << selectedEntries << " (weighted = " << selectedEntries_weighted << ")" << std::endl;
+//--- memory clean-up
+  delete entryIndex;
   clock.Show("produceNtuple");
-std::cout << "break-point 43 reached" << std::endl;
   return EXIT_SUCCESS;
 }
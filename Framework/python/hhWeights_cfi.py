@@ -12,6 +12,7 @@ hhWeights = cms.PSet(
     c2gScan_file = cms.string(''),
     extraScan_file = cms.string(''),
     coefFile = cms.string('HHStatAnalysis/AnalyticalModels/data/coefficientsByBin_extended_3M_costHHSim_19-4.txt'),
+    usePython = cms.bool(False),
     histtitle = cms.string(''),
     isDEBUG = cms.bool(False),
     apply_rwgt_lo = cms.bool(True),
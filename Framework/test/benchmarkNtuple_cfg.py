@@ -0,0 +1,53 @@
+import FWCore.ParameterSet.Config as cms
+
+import os
+
+# CV: benchmark the readers, cleaners, gen-matchers and writer plugins with the same configuration as used for the Ntuple production
+exec(open(os.path.join(os.environ['CMSSW_BASE'], 'src/TallinnNtupleProducer/Framework/test/produceNtuple_cfg.py')).read())
+
+process.benchmarkNtuple = cms.PSet(
+    # synthetic NanoAOD-like input file, generated at the start of each job
+    syntheticFileName = cms.string('benchmarkNtuple_synthetic.root'),
+    numEvents = cms.uint32(10000),
+    seed = cms.uint32(12345),
+
+    # mean number of objects per event, by name of the count branch (Poisson-distributed);
+    # collections that are not listed have defaultMultiplicity objects on average
+    multiplicities = cms.PSet(
+        nMuon = cms.double(2.),
+        nElectron = cms.double(2.),
+        nTau = cms.double(2.),
+        nJet = cms.double(8.),
+        nFatJet = cms.double(1.),
+        nSubJet = cms.double(2.),
+        nGenLep = cms.double(2.),
+        nGenVisTau = cms.double(1.),
+        nGenPhoton = cms.double(1.),
+        nGenJet = cms.double(8.),
+    ),
+    # fixed number of entries per event, e.g. for weight vectors
+    fixedMultiplicities = cms.PSet(
+        nLHEScaleWeight = cms.uint32(9),
+        nPSWeight = cms.uint32(4),
+    ),
+    defaultMultiplicity = cms.double(2.),
+    maxMultiplicity = cms.uint32(16),
+
+    # number of times the cleaners, look-up tables and writer plugins are run for each event
+    numRepetitions = cms.uint32(10),
+    # benchmark EventReader::read also for the systematic shifts
+    benchmarkSystematics = cms.bool(True),
+
+    # look-up tables of data/MC corrections, evaluated for the fakeable leptons of each event
+    luts = cms.VPSet(
+        cms.PSet(
+            inputFileName = cms.string('TallinnNtupleProducer/EvtWeightTools/data/leptonSF/2017/TnP_loose_ele_2017.root'),
+            lutName = cms.string('EGamma_SF2D'),
+            lutClass = cms.string('TH2'),
+            lutType = cms.string('XabsEtaYpt')
+        ),
+    ),
+
+    # ns/event and allocations/event of each stage are written to this file in CSV format, so that they can be compared across releases
+    reportFileName = cms.string('benchmarkNtuple.csv')
+)
@@ -25,7 +25,14 @@ process.fwliteInput = cms.PSet(
 )
 
 process.fwliteOutput = cms.PSet(
-    fileName = cms.string('')
+    fileName = cms.string(''),
+    # compression of the output file (ZLIB, LZMA, LZ4 or ZSTD, with level 0-9), ROOT's global setting is used if not given;
+    # note that LZ4 is faster than the default algorithm, but produces larger files
+    #compressionAlgorithm = cms.string('LZ4'),
+    #compressionLevel = cms.int32(4),
+    # the baskets are compressed in parallel by nCompressionThreads threads, in addition to the nThreads threads processing the input files
+    # (0: compress in the thread that fills the output tree)
+    nCompressionThreads = cms.uint32(0)
 )
 
 process.produceNtuple = cms.PSet(
@@ -172,6 +179,22 @@ process.produceNtuple = cms.PSet(
     enable_blacklist = cms.bool(False),
 
     selection = cms.string(""),
+    # flush the baskets of the output tree to disk every 30 MB and write the tree header every 300 MB (negative values: in bytes; positive values: in entries)
+    outputAutoFlush = cms.int64(-30000000),
+    outputAutoSave = cms.int64(-300000000),
+
+    nThreads = cms.uint32(1),
+    prefetchNextFile = cms.bool(True),
+    cacheSize = cms.int32(30*1024*1024),
+    setBranchStatus = cms.bool(True),
+    applyPreselection = cms.bool(True),
+
+    # process only the entries in the range [firstEntry, lastEntry), counted across all input files (lastEntry = -1: up to the last entry);
+    # the number of entries and cluster boundaries of each input file are stored in entryIndexFile, which is created on first use
+    firstEntry = cms.int64(0),
+    lastEntry = cms.int64(-1),
+    entryIndexFile = cms.string(""),
+    alignEntryRangeToClusters = cms.bool(True),
 
     isDEBUG = cms.bool(False)
 )
@@ -13,6 +13,13 @@
 #include "TallinnNtupleProducer/Objects/interface/RecoMuon.h"     // RecoMuonPtrCollection
 #include "TallinnNtupleProducer/Objects/interface/RecoVertex.h"   // RecoVertex
 
+/**
+ * @brief Collections of particles and event-level information of one event.
+ *
+ *        The collections are not copied into the Event object, but owned by the EventReader (by its EventStore),
+ *        so that no memory needs to be allocated when reading an event.
+ *        The Event object must therefore not be used after the next call to EventReader::read.
+ */
 class Event
 {
  public:
@@ -61,29 +68,29 @@ class Event
 
   const TriggerInfo & triggerInfo_;
 
-  RecoMuonPtrCollection looseMuons_;
-  RecoMuonPtrCollection fakeableMuons_;
-  RecoMuonPtrCollection tightMuons_;
+  const RecoMuonPtrCollection * looseMuons_;
+  const RecoMuonPtrCollection * fakeableMuons_;
+  const RecoMuonPtrCollection * tightMuons_;
 
-  RecoElectronPtrCollection looseElectrons_;
-  RecoElectronPtrCollection fakeableElectrons_;
-  RecoElectronPtrCollection tightElectrons_;
+  const RecoElectronPtrCollection * looseElectrons_;
+  const RecoElectronPtrCollection * fakeableElectrons_;
+  const RecoElectronPtrCollection * tightElectrons_;
 
-  RecoLeptonPtrCollection looseLeptons_;
-  RecoLeptonPtrCollection fakeableLeptons_;
-  RecoLeptonPtrCollection tightLeptons_;
+  const RecoLeptonPtrCollection * looseLeptons_;
+  const RecoLeptonPtrCollection * fakeableLeptons_;
+  const RecoLeptonPtrCollection * tightLeptons_;
 
-  RecoHadTauPtrCollection fakeableHadTaus_;
-  RecoHadTauPtrCollection tightHadTaus_;
+  const RecoHadTauPtrCollection * fakeableHadTaus_;
+  const RecoHadTauPtrCollection * tightHadTaus_;
 
-  RecoJetPtrCollectionAK4 selJetsAK4_;
-  RecoJetPtrCollectionAK4 selJetsAK4_btagLoose_;
-  RecoJetPtrCollectionAK4 selJetsAK4_btagMedium_;
+  const RecoJetPtrCollectionAK4 * selJetsAK4_;
+  const RecoJetPtrCollectionAK4 * selJetsAK4_btagLoose_;
+  const RecoJetPtrCollectionAK4 * selJetsAK4_btagMedium_;
 
-  RecoJetPtrCollectionAK8 selJetsAK8_Hbb_;
-  RecoJetPtrCollectionAK8 selJetsAK8_Wjj_;
+  const RecoJetPtrCollectionAK8 * selJetsAK8_Hbb_;
+  const RecoJetPtrCollectionAK8 * selJetsAK8_Wjj_;
 
-  RecoMEt met_;
+  const RecoMEt * met_;
   MEtFilter metFilters_;
 
   RecoVertex vertex_;
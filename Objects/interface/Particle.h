@@ -4,7 +4,7 @@
 #include "DataFormats/Math/interface/LorentzVector.h" // math::PtEtaPhiMLorentzVector
 #include "DataFormats/Math/interface/Vector3D.h"      // math::XYZVector
 
-#include <Rtypes.h>                                   // Int_t, Long64_t, Double_t
+#include <Rtypes.h>                                   // Int_t, Long64_t, Float_t, Double_t
 
 class Particle
 {
@@ -24,9 +24,9 @@ class Particle
   /**
    * @brief Funtions to access data-members
    * @return Values of data-members
-   * 
-   * NOTE: get_pt and get_p4 functions needs to be virtual, so that they can be overwritten 
-   *       to implement cone_pT logic for fakeable && !tight leptons in RecoLepton class
+   *
+   * NOTE: the accessors are not virtual; the cone_pT logic for fakeable && !tight leptons
+   *       is implemented by the separate cone_pt and cone_p4 functions of the RecoLepton class
    */
   Double_t pt() const;
   Double_t eta() const;
@@ -36,29 +36,30 @@ class Particle
 
   bool isValid() const;
 
-  const Particle::LorentzVector & p4() const;
+  /**
+   * @brief Return 4-momentum, constructed from the pT, eta, phi and mass on each call
+   *       (the 4-momentum is not stored, to keep the particle objects small)
+   */
+  Particle::LorentzVector p4() const;
 
   double deltaR(const Particle & particle) const;
   double deltaR(const Particle * const particle) const;
 
-  virtual void
+  void
   set_p4(const Particle::LorentzVector & p4);
 
-  virtual void
+  void
   set_ptEtaPhiMass(Double_t pt,
                    Double_t eta,
                    Double_t phi,
                    Double_t mass);
 
  protected:
-  Double_t pt_;   ///< pT of the particle
-  Double_t eta_;  ///< eta of the particle
-  Double_t phi_;  ///< phi of the particle
-  Double_t mass_; ///< mass of the particle
-
-  Double_t absEta_; ///< |eta| of the particle
-
-  Particle::LorentzVector p4_; ///< 4-momentum constructed from the pT, eta, phi and mass
+  // CV: the kinematic variables are stored in single precision, as they are read from Float_t branches
+  Float_t pt_;   ///< pT of the particle
+  Float_t eta_;  ///< eta of the particle
+  Float_t phi_;  ///< phi of the particle
+  Float_t mass_; ///< mass of the particle
 
   bool isValid_; ///< true if the particle is physical (meaning that its pT > 0)
 };
@@ -3,6 +3,7 @@
 
 #include "TallinnNtupleProducer/Objects/interface/RecoLepton.h" // RecoLepton
 
+#include <map>                                                  // std::map
 #include <vector>                                               // std::vector
 
 // forward declarations
@@ -3,7 +3,6 @@
 
 #include "TallinnNtupleProducer/Objects/interface/GenHadTau.h" // GenHadTau
 
-#include <memory>                                              // std::shared_ptr
 #include <map>                                                 // std::map
 
 // forward declarations
@@ -97,10 +96,10 @@ class RecoHadTau : public GenHadTau
                         ///<                                4 = tau->mu decay, 5 = hadronic tau decay, 0 = unknown/no match)
   Int_t genMatchIdx_;   ///< index to matched gen particle (-1 if no match)
 
-//--- matching to generator level particles
-  std::shared_ptr<const GenLepton> genLepton_;
-  std::shared_ptr<const GenHadTau> genHadTau_;
-  std::shared_ptr<const GenJet> genJet_;
+//--- matching to generator level particles (non-owning)
+  const GenLepton * genLepton_;
+  const GenHadTau * genHadTau_;
+  const GenJet * genJet_;
 
 //--- flags indicating whether or not lepton passes loose, fakeable and/or tight selection criteria
   mutable bool isLoose_;
@@ -10,12 +10,12 @@
  *
  */
 
-#include "TallinnNtupleProducer/Objects/interface/RecoJetBase.h" // RecoJetBase
+#include "TallinnNtupleProducer/CommonTools/interface/jetDefinitions.h"   // Btag, kNumBtags
+#include "TallinnNtupleProducer/CommonTools/interface/sysUncertOptions.h" // kBtag_*, kJetMET_*
+#include "TallinnNtupleProducer/Objects/interface/RecoJetBase.h"          // RecoJetBase
 
-#include <map>                                                   // std::map
-
-enum class Btag;
-enum class pileupJetID;
+#include <array>                                                          // std::array
+#include <bitset>                                                         // std::bitset
 
 class RecoJetAK4 : public RecoJetBase
 {
@@ -81,7 +81,18 @@ class RecoJetAK4 : public RecoJetBase
 
   friend class RecoJetReaderAK4;
 
+  static constexpr int kNumBtagShifts = kBtag_jesRelativeSample_EraDown + 1;
+  static constexpr int kNumJetMETShifts = kJetMET_jerForwardHighPtDown + 1;
+
 protected:
+  /**
+   * @brief Set b-tagging scores, b-tagging weights and jet pT & mass for a given systematic uncertainty
+   *        (called by RecoJetReaderAK4)
+   */
+  void set_BtagCSV(Btag btag, Double_t BtagCSV);
+  void set_BtagWeight(Btag btag, int central_or_shift, Double_t BtagWeight);
+  void set_systematics_ptMass(int central_or_shift, Double_t pt, Double_t mass);
+
   Double_t jetCharge_;  ///< jet charge, computed according to JME-13-006
   Double_t BtagCSV_;    ///< CSV b-tagging discriminator value
   Double_t BtagWeight_; ///< weight for data/MC correction of b-tagging efficiency and mistag rate
@@ -97,11 +108,16 @@ protected:
   Btag btag_;           ///< default b-tagging discriminant
 
   //---------------------------------------------------------
-  // CV: needed by RecoJetWriter
-  std::map<Btag, std::map<int, Double_t>> BtagWeight_systematics_;
-  std::map<Btag, Double_t> BtagCSVs_;
-  std::map<int, Double_t> pt_systematics_;
-  std::map<int, Double_t> mass_systematics_;
+  // CV: needed by RecoJetWriter;
+  //     values are stored in arrays indexed by Btag and kBtag_* resp. kJetMET_* enums,
+  //     the bitsets indicate which entries have been filled
+  std::array<std::array<Double_t, kNumBtagShifts>, kNumBtags> BtagWeight_systematics_;
+  std::array<std::bitset<kNumBtagShifts>, kNumBtags> has_BtagWeight_systematics_;
+  std::array<Double_t, kNumBtags> BtagCSVs_;
+  std::bitset<kNumBtags> has_BtagCSVs_;
+  std::array<Double_t, kNumJetMETShifts> pt_systematics_;
+  std::array<Double_t, kNumJetMETShifts> mass_systematics_;
+  std::bitset<kNumJetMETShifts> has_ptMass_systematics_;
   int default_systematics_;
   //---------------------------------------------------------
 
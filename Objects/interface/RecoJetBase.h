@@ -15,8 +15,6 @@
 
 #include "TallinnNtupleProducer/Objects/interface/GenJet.h" // GenJet
 
-#include <memory>                                           // std::shared_ptr
-
 // forward declarations
 class GenLepton;
 class GenHadTau;
@@ -53,10 +51,10 @@ class RecoJetBase : public GenJet
  protected:
   Int_t idx_; ///< index of jet in the ntuple
 
-//--- matching to generator level particles
-  std::shared_ptr<const GenLepton> genLepton_;
-  std::shared_ptr<const GenHadTau> genHadTau_;
-  std::shared_ptr<const GenJet> genJet_;
+//--- matching to generator level particles (non-owning)
+  const GenLepton * genLepton_;
+  const GenHadTau * genHadTau_;
+  const GenJet * genJet_;
 };
 
 std::ostream &
@@ -1,10 +1,11 @@
 #ifndef TallinnNtupleProducer_Objects_RecoLepton_h
 #define TallinnNtupleProducer_Objects_RecoLepton_h
 
-#include "TallinnNtupleProducer/Objects/interface/ChargedParticle.h" // ChargedParticle
+#include "TallinnNtupleProducer/CommonTools/interface/jetDefinitions.h" // Btag, kNumBtags
+#include "TallinnNtupleProducer/Objects/interface/ChargedParticle.h"    // ChargedParticle
 
-#include <memory>                                                    // std::shared_ptr
-#include <map>                                                       // std::map
+#include <array>                                                        // std::array
+#include <bitset>                                                       // std::bitset
 
 // forward declarations
 class GenLepton;
@@ -12,8 +13,6 @@ class GenHadTau;
 class GenPhoton;
 class GenJet;
 
-enum class Btag;
-
 class RecoLepton : public ChargedParticle
 {
  public:
@@ -48,6 +47,9 @@ class RecoLepton : public ChargedParticle
 
   /**
    * @brief Set links to generator level particles (matched by dR)
+   *
+   * @note The links do not own the generator level particles, which must stay valid as long as the links are used
+   *       (in the Ntuple production, the generator level particles are owned by the EventStore, like the reconstructed particles)
    */
   void set_genLepton(const GenLepton * genLepton);
   void set_genHadTau(const GenHadTau * genHadTau);
@@ -92,24 +94,28 @@ class RecoLepton : public ChargedParticle
    *     in the code that computes the fake-rates (using the assocJet_pt() instead of the cone_pt() function guarantees
    *     that the same pT definition is used in the numerator and denominator histograms, 
    *     i.e. regardless of whether leptons pass or fail the "tight" lepton selection criteria.
+   *
+   *     The decision which pT the cone_pt() function returns is taken once, when the cut on the lepton MVA is set,
+   *     so that sorting leptons by cone pT needs no virtual function calls.
+   *     The four-momenta are constructed on each call and returned by value.
    */
 
   Double_t
   lepton_pt() const;
 
-  const Particle::LorentzVector &
+  Particle::LorentzVector
   lepton_p4() const;
 
-  virtual Double_t
+  Double_t
   cone_pt() const;
 
-  virtual const Particle::LorentzVector &
+  Particle::LorentzVector
   cone_p4() const;
 
   Double_t
   assocJet_pt() const;
 
-  const Particle::LorentzVector &
+  Particle::LorentzVector
   assocJet_p4() const;
 
   /**
@@ -155,19 +161,27 @@ class RecoLepton : public ChargedParticle
 
   void set_mvaRawTTH_cut(Double_t mvaRawTTH_cut);
 
-  virtual void
-  set_p4(const Particle::LorentzVector & p4) override;
+  /**
+   * @brief Set pT, eta, phi and mass of the lepton, updating the pT of the associated jet
+   */
+  void
+  set_p4(const Particle::LorentzVector & p4);
 
-  virtual void
+  void
   set_ptEtaPhiMass(Double_t pt,
                    Double_t eta,
                    Double_t phi,
-                   Double_t mass) override;
+                   Double_t mass);
 
   friend class RecoMuonReader;
   friend class RecoElectronReader;
 
  protected:
+  /**
+   * @brief Set b-tagging discriminator value of nearby jet (called by RecoMuonReader and RecoElectronReader)
+   */
+  void set_jetBtagCSV(Btag btag, Double_t jetBtagCSV, bool doAssoc);
+
 //--- common observables for electrons and muons
   Double_t dxy_;                ///< d_{xy}, distance in the transverse plane w.r.t PV
   Double_t dz_;                 ///< d_{z}, distance on the z axis w.r.t PV
@@ -187,17 +201,21 @@ class RecoLepton : public ChargedParticle
   Int_t genMatchIdx_;           ///< index to matched gen particle (-1 if no match)
   Double_t mvaRawTTH_cut_;      ///< cut on prompt lepton MVA score
 
-  std::map<Btag, Double_t> jetBtagCSVs_; ///< CSV b-tagging discriminator values of nearby jet as used in prompt lepton MVA
-  std::map<Btag, Double_t> assocJetBtagCSVs_; ///< CSV b-tagging discriminator values of nearby jet found via jetIdx branch
+  std::array<Double_t, kNumBtags> jetBtagCSVs_;      ///< CSV b-tagging discriminator values of nearby jet as used in prompt lepton MVA, indexed by Btag
+  std::array<Double_t, kNumBtags> assocJetBtagCSVs_; ///< CSV b-tagging discriminator values of nearby jet found via jetIdx branch, indexed by Btag
+  std::bitset<kNumBtags> has_jetBtagCSVs_;           ///< flags indicating which entries of jetBtagCSVs_ have been filled
+  std::bitset<kNumBtags> has_assocJetBtagCSVs_;      ///< flags indicating which entries of assocJetBtagCSVs_ have been filled
 
   Double_t assocJet_pt_;
-  Particle::LorentzVector assocJet_p4_;
 
-//--- matching to generator level particles
-  std::shared_ptr<const GenLepton> genLepton_;
-  std::shared_ptr<const GenHadTau> genHadTau_;
-  std::shared_ptr<const GenPhoton> genPhoton_;
-  std::shared_ptr<const GenJet> genJet_;
+  bool passesConePtId_;   ///< id required for the cone pT to equal the lepton pT (medium PFMuon id for muons, always true for electrons)
+  bool isConePtLeptonPt_; ///< true if the cone pT equals the lepton pT, false if it equals the pT of the associated jet
+
+//--- matching to generator level particles (non-owning)
+  const GenLepton * genLepton_;
+  const GenHadTau * genHadTau_;
+  const GenPhoton * genPhoton_;
+  const GenJet * genJet_;
 
 //--- flags indicating whether or not lepton passes CMS POG ID, loose, fakeable and/or tight selection criteria
   mutable bool isCMSPOG_;
@@ -206,7 +224,7 @@ class RecoLepton : public ChargedParticle
   mutable bool isTight_;
 
   void
-  set_assocJet_p4();
+  set_assocJet_pt();
 
   static Double_t
   get_assocJet_pt(Double_t reco_pt,
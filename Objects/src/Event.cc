@@ -2,11 +2,29 @@
 
 #include <TString.h> // TString
 
+#include <assert.h>  // assert()
 #include <string>    // std::string
 
 Event::Event(const EventInfo& eventInfo, const TriggerInfo& triggerInfo)
   : eventInfo_(eventInfo)
   , triggerInfo_(triggerInfo)
+  , looseMuons_(nullptr)
+  , fakeableMuons_(nullptr)
+  , tightMuons_(nullptr)
+  , looseElectrons_(nullptr)
+  , fakeableElectrons_(nullptr)
+  , tightElectrons_(nullptr)
+  , looseLeptons_(nullptr)
+  , fakeableLeptons_(nullptr)
+  , tightLeptons_(nullptr)
+  , fakeableHadTaus_(nullptr)
+  , tightHadTaus_(nullptr)
+  , selJetsAK4_(nullptr)
+  , selJetsAK4_btagLoose_(nullptr)
+  , selJetsAK4_btagMedium_(nullptr)
+  , selJetsAK8_Hbb_(nullptr)
+  , selJetsAK8_Wjj_(nullptr)
+  , met_(nullptr)
 {}
 
 Event::~Event()
@@ -27,103 +45,120 @@ Event::triggerInfo() const
 const RecoMuonPtrCollection&
 Event::looseMuons() const
 {
-  return looseMuons_;
+  assert(looseMuons_);
+  return *looseMuons_;
 }
 
 const RecoMuonPtrCollection&
 Event::fakeableMuons() const
 {
-  return fakeableMuons_;
+  assert(fakeableMuons_);
+  return *fakeableMuons_;
 }
 
 const RecoMuonPtrCollection&
 Event::tightMuons()const
 {
-  return tightMuons_;
+  assert(tightMuons_);
+  return *tightMuons_;
 }
 
 const RecoElectronPtrCollection&
 Event::looseElectrons() const
 {
-  return looseElectrons_;
+  assert(looseElectrons_);
+  return *looseElectrons_;
 }
 
 const RecoElectronPtrCollection&
 Event::fakeableElectrons() const
 {
-  return fakeableElectrons_;
+  assert(fakeableElectrons_);
+  return *fakeableElectrons_;
 }
 
 const RecoElectronPtrCollection&
 Event::tightElectrons() const
 {
-  return tightElectrons_;
+  assert(tightElectrons_);
+  return *tightElectrons_;
 }
 
 const RecoLeptonPtrCollection&
 Event::looseLeptons() const
 {
-  return looseLeptons_;
+  assert(looseLeptons_);
+  return *looseLeptons_;
 }
 
 const RecoLeptonPtrCollection&
 Event::fakeableLeptons() const
 {
-  return fakeableLeptons_;
+  assert(fakeableLeptons_);
+  return *fakeableLeptons_;
 }
 
 const RecoLeptonPtrCollection&
 Event::tightLeptons() const
 {
-  return tightLeptons_;
+  assert(tightLeptons_);
+  return *tightLeptons_;
 }
 
 const RecoHadTauPtrCollection&
 Event::fakeableHadTaus() const
 {
-  return fakeableHadTaus_;
+  assert(fakeableHadTaus_);
+  return *fakeableHadTaus_;
 }
 
 const RecoHadTauPtrCollection&
 Event::tightHadTaus() const
 {
-  return tightHadTaus_;
+  assert(tightHadTaus_);
+  return *tightHadTaus_;
 }
 
 const RecoJetPtrCollectionAK4&
 Event::selJetsAK4() const
 {
-  return selJetsAK4_;
+  assert(selJetsAK4_);
+  return *selJetsAK4_;
 }
 
 const RecoJetPtrCollectionAK4&
 Event::selJetsAK4_btagLoose() const
 {
-  return selJetsAK4_btagLoose_;
+  assert(selJetsAK4_btagLoose_);
+  return *selJetsAK4_btagLoose_;
 }
 
 const RecoJetPtrCollectionAK4&
 Event::selJetsAK4_btagMedium() const
 {
-  return selJetsAK4_btagMedium_;
+  assert(selJetsAK4_btagMedium_);
+  return *selJetsAK4_btagMedium_;
 }
 
 const RecoJetPtrCollectionAK8&
 Event::selJetsAK8_Hbb() const
 {
-  return selJetsAK8_Hbb_;
+  assert(selJetsAK8_Hbb_);
+  return *selJetsAK8_Hbb_;
 }
 
 const RecoJetPtrCollectionAK8&
 Event::selJetsAK8_Wjj() const
 {
-  return selJetsAK8_Wjj_;
+  assert(selJetsAK8_Wjj_);
+  return *selJetsAK8_Wjj_;
 }
 
 const RecoMEt&
 Event::met() const
 {
-  return met_;
+  assert(met_);
+  return *met_;
 }
 
 const MEtFilter& 
@@ -16,8 +16,6 @@ Particle::Particle(Double_t pt,
   , eta_(eta)
   , phi_(phi)
   , mass_(mass)
-  , absEta_(std::fabs(eta_))
-  , p4_{pt_, eta_, phi_, mass_}
   , isValid_(pt_ > 0.)
 {}
 
@@ -26,8 +24,6 @@ Particle::Particle(const Particle::LorentzVector & p4)
   , eta_(p4.eta())
   , phi_(p4.phi())
   , mass_(p4.mass())
-  , absEta_(std::fabs(eta_))
-  , p4_(p4)
   , isValid_(true)
 {}
 
@@ -58,13 +54,13 @@ Particle::mass() const
 Double_t
 Particle::absEta() const
 {
-  return absEta_;
+  return std::fabs(eta_);
 }
 
-const Particle::LorentzVector &
+Particle::LorentzVector
 Particle::p4() const
 {
-  return p4_;
+  return { pt_, eta_, phi_, mass_ };
 }
 
 double
@@ -76,7 +72,7 @@ Particle::deltaR(const Particle & particle) const
 double
 Particle::deltaR(const Particle * const particle) const
 {
-  return ::deltaR(eta_, phi_, particle->eta(), particle->phi());
+  return ::deltaR(eta(), phi(), particle->eta(), particle->phi());
 }
 
 bool
@@ -101,8 +97,6 @@ Particle::set_ptEtaPhiMass(Double_t pt,
   eta_ = eta;
   phi_ = phi;
   mass_ = mass;
-  absEta_ = std::fabs(eta_);
-  p4_ = { pt_, eta_, phi_, mass_ };
   isValid_ = pt_ > 0.;
 }
 
@@ -4,6 +4,8 @@
 #include "TallinnNtupleProducer/CommonTools/interface/cmsException.h"   // cmsException()
 #include "TallinnNtupleProducer/CommonTools/interface/jetDefinitions.h" // Btag, pileupJetID
 
+#include <cassert>                                                      // assert()
+
 RecoJetAK4::RecoJetAK4(const GenJet & jet,
                        Double_t charge,
                        Double_t BtagCSV,
@@ -69,13 +71,13 @@ RecoJetAK4::BtagCSV() const
 Double_t
 RecoJetAK4::BtagCSV(Btag btag) const
 {
-  if(! BtagCSVs_.count(btag))
+  if(! hasBtag(btag))
   {
     throw cmsException(this, __func__, __LINE__)
       << "No such b-tagging score available: " << as_integer(btag)
     ;
   }
-  return BtagCSVs_.at(btag);
+  return BtagCSVs_[as_integer(btag)];
 }
 
 Double_t
@@ -88,7 +90,14 @@ Double_t
 RecoJetAK4::BtagWeight(Btag btag,
                        int central_or_shift) const
 {
-  return BtagWeight_systematics_.at(btag).at(central_or_shift);
+  if(central_or_shift < kBtag_central || central_or_shift >= kNumBtagShifts ||
+     ! has_BtagWeight_systematics_[as_integer(btag)].test(central_or_shift))
+  {
+    throw cmsException(this, __func__, __LINE__)
+      << "No such b-tagging weight available: " << as_integer(btag) << " (systematics = " << central_or_shift << ')'
+    ;
+  }
+  return BtagWeight_systematics_[as_integer(btag)][central_or_shift];
 }
 
 Double_t
@@ -164,11 +173,11 @@ Double_t
 RecoJetAK4::maxPt() const
 {
   double max_Pt = this->pt();
-  for(const auto & kv: pt_systematics_)
+  for(int idxShift = 0; idxShift < kNumJetMETShifts; ++idxShift)
   {
-    if(kv.second > max_Pt)
+    if(has_ptMass_systematics_.test(idxShift) && pt_systematics_[idxShift] > max_Pt)
     {
-      max_Pt = kv.second;
+      max_Pt = pt_systematics_[idxShift];
     }
   }
   return max_Pt;
@@ -177,7 +186,7 @@ RecoJetAK4::maxPt() const
 bool
 RecoJetAK4::hasBtag(Btag btag) const
 {
-  return BtagCSVs_.count(btag);
+  return has_BtagCSVs_.test(as_integer(btag));
 }
 
 bool
@@ -203,11 +212,41 @@ RecoJetAK4::get_default_systematics() const
 const Particle::LorentzVector
 RecoJetAK4::get_systematics_p4(int central_or_shift) const
 {
-  if(! pt_systematics_.count(central_or_shift) && ! mass_systematics_.count(central_or_shift))
+  if(central_or_shift < kJetMET_central_nonNominal || central_or_shift >= kNumJetMETShifts ||
+     ! has_ptMass_systematics_.test(central_or_shift))
   {
     throw cmsException(this, __func__, __LINE__) << "No such systematics available: " << central_or_shift;
   }
-  return { pt_systematics_.at(central_or_shift), eta_, phi_, mass_systematics_.at(central_or_shift) };
+  return { pt_systematics_[central_or_shift], eta_, phi_, mass_systematics_[central_or_shift] };
+}
+
+void
+RecoJetAK4::set_BtagCSV(Btag btag,
+                        Double_t BtagCSV)
+{
+  BtagCSVs_[as_integer(btag)] = BtagCSV;
+  has_BtagCSVs_.set(as_integer(btag));
+}
+
+void
+RecoJetAK4::set_BtagWeight(Btag btag,
+                           int central_or_shift,
+                           Double_t BtagWeight)
+{
+  assert(central_or_shift >= kBtag_central && central_or_shift < kNumBtagShifts);
+  BtagWeight_systematics_[as_integer(btag)][central_or_shift] = BtagWeight;
+  has_BtagWeight_systematics_[as_integer(btag)].set(central_or_shift);
+}
+
+void
+RecoJetAK4::set_systematics_ptMass(int central_or_shift,
+                                   Double_t pt,
+                                   Double_t mass)
+{
+  assert(central_or_shift >= kJetMET_central_nonNominal && central_or_shift < kNumJetMETShifts);
+  pt_systematics_[central_or_shift] = pt;
+  mass_systematics_[central_or_shift] = mass;
+  has_ptMass_systematics_.set(central_or_shift);
 }
 
 bool
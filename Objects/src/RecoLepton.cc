@@ -51,9 +51,11 @@ RecoLepton::RecoLepton(const ChargedParticle & lepton,
   , genMatchIdx_(genMatchIdx)
   , mvaRawTTH_cut_(-1.)
   , assocJet_pt_(get_assocJet_pt(pt_, jetPtRatio_))
-  , assocJet_p4_(assocJet_pt_, eta_, phi_, mass_)
+  , passesConePtId_(true)
+  , isConePtLeptonPt_(false)
   , genLepton_(nullptr)
   , genHadTau_(nullptr)
+  , genPhoton_(nullptr)
   , genJet_(nullptr)
   , isCMSPOG_(false)
   , isLoose_(false)
@@ -91,25 +93,25 @@ RecoLepton::set_isTight() const
 void
 RecoLepton::set_genLepton(const GenLepton * genLepton)
 {
-  genLepton_.reset(genLepton);
+  genLepton_ = genLepton;
 }
 
 void
 RecoLepton::set_genHadTau(const GenHadTau * genHadTau)
 {
-  genHadTau_.reset(genHadTau);
+  genHadTau_ = genHadTau;
 }
 
 void
 RecoLepton::set_genPhoton(const GenPhoton * genPhoton)
 {
-  genPhoton_.reset(genPhoton);
+  genPhoton_ = genPhoton;
 }
 
 void
 RecoLepton::set_genJet(const GenJet * genJet)
 {
-  genJet_.reset(genJet);
+  genJet_ = genJet;
 }
 
 bool
@@ -130,24 +132,24 @@ RecoLepton::lepton_pt() const
   return pt_;
 }
 
-const Particle::LorentzVector &
+Particle::LorentzVector
 RecoLepton::lepton_p4() const
 {
-  return p4_;
+  return p4();
 }
 
 Double_t
 RecoLepton::cone_pt() const
 {
   assert(mvaRawTTH_cut_ > 0.);
-  return mvaRawTTH_ >= mvaRawTTH_cut_ ? pt_ : assocJet_pt_;
+  return isConePtLeptonPt_ ? pt() : assocJet_pt_;
 }
 
-const Particle::LorentzVector &
+Particle::LorentzVector
 RecoLepton::cone_p4() const
 {
   assert(mvaRawTTH_cut_ > 0.);
-  return mvaRawTTH_ >= mvaRawTTH_cut_ ? p4_ : assocJet_p4_;
+  return isConePtLeptonPt_ ? p4() : assocJet_p4();
 }
 
 Double_t
@@ -156,10 +158,10 @@ RecoLepton::assocJet_pt() const
   return assocJet_pt_;
 }
 
-const Particle::LorentzVector &
+Particle::LorentzVector
 RecoLepton::assocJet_p4() const
 {
-  return assocJet_p4_;
+  return { assocJet_pt_, eta_, phi_, mass_ };
 }
 
 Double_t
@@ -251,7 +253,24 @@ RecoLepton::jetBtagCSV(Btag btag,
       << "b-tagging discriminator not available: " << as_integer(btag)
     ;
   }
-  return doAssoc ? assocJetBtagCSVs_.at(btag) : jetBtagCSVs_.at(btag);
+  return doAssoc ? assocJetBtagCSVs_[as_integer(btag)] : jetBtagCSVs_[as_integer(btag)];
+}
+
+void
+RecoLepton::set_jetBtagCSV(Btag btag,
+                           Double_t jetBtagCSV,
+                           bool doAssoc)
+{
+  if(doAssoc)
+  {
+    assocJetBtagCSVs_[as_integer(btag)] = jetBtagCSV;
+    has_assocJetBtagCSVs_.set(as_integer(btag));
+  }
+  else
+  {
+    jetBtagCSVs_[as_integer(btag)] = jetBtagCSV;
+    has_jetBtagCSVs_.set(as_integer(btag));
+  }
 }
 
 Int_t
@@ -293,32 +312,32 @@ RecoLepton::genMatchIdx() const
 const GenLepton *
 RecoLepton::genLepton() const
 {
-  return genLepton_.get();
+  return genLepton_;
 }
 
 const GenHadTau *
 RecoLepton::genHadTau() const
 {
-  return genHadTau_.get();
+  return genHadTau_;
 }
 
 const GenPhoton *
 RecoLepton::genPhoton() const
 {
-  return genPhoton_.get();
+  return genPhoton_;
 }
 
 const GenJet *
 RecoLepton::genJet() const
 {
-  return genJet_.get();
+  return genJet_;
 }
 
 bool
 RecoLepton::hasJetBtagCSV(Btag btag,
                           bool doAssoc) const
 {
-  return doAssoc ? assocJetBtagCSVs_.count(btag) : jetBtagCSVs_.count(btag);
+  return doAssoc ? has_assocJetBtagCSVs_.test(as_integer(btag)) : has_jetBtagCSVs_.test(as_integer(btag));
 }
 
 bool
@@ -361,13 +380,14 @@ void
 RecoLepton::set_mvaRawTTH_cut(Double_t mvaRawTTH_cut)
 {
   mvaRawTTH_cut_ = mvaRawTTH_cut;
+  isConePtLeptonPt_ = passesConePtId_ && mvaRawTTH_ >= mvaRawTTH_cut_;
 }
 
 void
 RecoLepton::set_p4(const Particle::LorentzVector & p4)
 {
   Particle::set_p4(p4);
-  set_assocJet_p4();
+  set_assocJet_pt();
 }
 
 void
@@ -377,14 +397,13 @@ RecoLepton::set_ptEtaPhiMass(Double_t pt,
                              Double_t mass)
 {
   Particle::set_ptEtaPhiMass(pt, eta, phi, mass);
-  set_assocJet_p4();
+  set_assocJet_pt();
 }
 
 void
-RecoLepton::set_assocJet_p4()
+RecoLepton::set_assocJet_pt()
 {
   assocJet_pt_ = get_assocJet_pt(pt_, jetPtRatio_);
-  assocJet_p4_ = { assocJet_pt_, eta_, phi_, mass_ };
 }
 
 std::ostream &
@@ -11,6 +11,8 @@ RecoMuon::RecoMuon(const RecoLepton & lepton,
   , segmentCompatibility_(segmentCompatibility)
   , ptErr_(ptErr)
 {
+  // CV: the cone pT of muons equals the muon pT only if the muon passes the medium PFMuon id
+  passesConePtId_ = passesMediumIdPOG_;
   set_mvaRawTTH_cut(0.85);
 }
 
@@ -56,18 +58,6 @@ RecoMuon::is_muon() const
   return true;
 }
 
-Double_t
-RecoMuon::cone_pt() const
-{
-  return passesMediumIdPOG() ? RecoLepton::cone_pt() : assocJet_pt();
-}
-
-const Particle::LorentzVector &
-RecoMuon::cone_p4() const
-{
-  return passesMediumIdPOG() ? RecoLepton::cone_p4() : assocJet_p4();
-}
-
 std::ostream &
 operator<<(std::ostream & stream,
            const RecoMuon & muon)
@@ -5,8 +5,10 @@
 
 #include "TallinnNtupleProducer/Cleaners/interface/ParticleCollectionCleaner.h"               // RecoElectronCollectionCleaner, RecoHadTauCollectionCleaner, RecoJetCollectionCleanerAK4, RecoMuonCollectionCleaner
 #include "TallinnNtupleProducer/Cleaners/interface/RecoJetCollectionCleanerByIndexAK4.h"      // RecoJetCollectionCleanerByIndexAK4
+#include "TallinnNtupleProducer/CommonTools/interface/SysIdRegistry.h"                        // SysId
 #include "TallinnNtupleProducer/Objects/interface/Event.h"                                    // Event
 #include "TallinnNtupleProducer/Readers/interface/EventInfoReader.h"                          // EventInfoReader
+#include "TallinnNtupleProducer/Readers/interface/EventStore.h"                               // EventStore
 #include "TallinnNtupleProducer/Readers/interface/GenHadTauReader.h"                          // GenHadTauReader
 #include "TallinnNtupleProducer/Readers/interface/GenJetReader.h"                             // GenJetReader
 #include "TallinnNtupleProducer/Readers/interface/GenLeptonReader.h"                          // GenLeptonReader
@@ -22,6 +24,7 @@
 #include "TallinnNtupleProducer/Readers/interface/RecoMuonReader.h"                           // RecoMuonReader
 #include "TallinnNtupleProducer/Readers/interface/RecoVertexReader.h"                         // RecoVertexReader
 #include "TallinnNtupleProducer/Readers/interface/TriggerInfoReader.h"                        // TriggerInfoReader
+#include "TallinnNtupleProducer/Selectors/interface/ParticleCollectionTieredSelector.h"       // ParticleCollectionTieredSelector
 #include "TallinnNtupleProducer/Selectors/interface/RecoElectronCollectionSelectorFakeable.h" // RecoElectronCollectionSelectorFakeable
 #include "TallinnNtupleProducer/Selectors/interface/RecoElectronCollectionSelectorLoose.h"    // RecoElectronCollectionSelectorLoose
 #include "TallinnNtupleProducer/Selectors/interface/RecoElectronCollectionSelectorTight.h"    // RecoElectronCollectionSelectorTight
@@ -50,9 +53,30 @@ class EventReader : public ReaderBase
   EventReader(const edm::ParameterSet& cfg);
   ~EventReader();
 
+  /**
+   * @brief Switch all particle-collection reader classes to the central value or to the given systematic shift.
+   *        Reader classes that do not support the given systematic shift are reset to their central value.
+   */
   void
   set_central_or_shift(const std::string& central_or_shift);
 
+  /**
+   * @brief Same as above, for systematic shifts resolved by a SysIdRegistry.
+   *        The options of the particle-collection reader classes are determined on the first call for each SysId
+   *        and taken from a cache, indexed by SysId::idx, in all subsequent calls.
+   */
+  void
+  set_central_or_shift(const SysId & sysId);
+
+  /**
+   * @brief Bind the branches for all systematic shifts (only for MC),
+   *        so that each entry needs to be read from the input tree only once
+   *        and all systematic shifts can then be processed by calling set_central_or_shift and read in turn.
+   *        This method needs to be called before the first call to setBranchAddresses.
+   */
+  void
+  read_systematics(bool flag);
+
   /**
    * @brief Call tree->SetBranchAddress for all particle-collection reader classes
    */
@@ -62,10 +86,39 @@ class EventReader : public ReaderBase
   /**
    * @brief Read branches from tree and use information to fill Event object
    * @return Event object
+   *
+   * @note The Event object holds pointers to objects owned by the EventReader,
+   *       which stay valid until the next call to this function
    */
   Event
   read() const;
 
+  /**
+   * @brief Read only the event-level information (run, luminosity section and event number, ...) of the current entry,
+   *        e.g. for selecting events by run, luminosity section and event number before the particle collections are read
+   * @return reference to EventInfo object, which stays valid until the next call to this function or to read()
+   */
+  const EventInfo &
+  read_eventInfo() const;
+
+  /**
+   * @brief Return names of the branches needed by passesPreselection()
+   */
+  std::vector<std::string>
+  get_preselectionBranchNames() const;
+
+  /**
+   * @brief Cheap preselection on the number of muons, electrons and hadronic taus in the input tree,
+   *        which needs only the branches returned by get_preselectionBranchNames() to be read
+   * @return true, if the event contains at least numNominalLeptons muons and electrons and at least numNominalHadTaus hadronic taus;
+   *         false otherwise
+   *
+   * @note The fakeable leptons and hadronic taus are subsets of the leptons and hadronic taus in the input tree,
+   *       so events that fail the preselection cannot pass any selection that requires numNominalLeptons fakeable leptons and numNominalHadTaus fakeable hadronic taus
+   */
+  bool
+  passesPreselection() const;
+
   /**
     * @brief Return list of systematic uncertainties supported by EventReader class
     */
@@ -74,6 +127,28 @@ class EventReader : public ReaderBase
   get_supported_systematics();
 
  protected:
+  /**
+   * @brief Options of the particle-collection reader classes for one central value or systematic shift
+   */
+  struct ReaderOptions
+  {
+    int hadTauPt_option_;
+    int jetPt_option_;
+    bool read_btag_systematics_;
+    int fatJetPt_option_Hbb_;
+    int fatJetPt_option_Wjj_;
+    int met_option_;
+  };
+
+  ReaderOptions
+  get_readerOptions(const std::string & central_or_shift) const;
+
+  void
+  set_readerOptions(const ReaderOptions & readerOptions);
+
+  std::vector<ReaderOptions> readerOptions_;      ///< cache of reader options, indexed by SysId::idx
+  std::vector<bool> readerOptions_isInitialized_; ///< flags indicating which entries of the readerOptions_ cache have been filled
+
   unsigned numNominalLeptons_;
   unsigned numNominalHadTaus_;
 
@@ -89,18 +164,21 @@ class EventReader : public ReaderBase
   RecoMuonCollectionSelectorLoose * looseMuonSelector_;
   RecoMuonCollectionSelectorFakeable * fakeableMuonSelector_;
   RecoMuonCollectionSelectorTight * tightMuonSelector_;
+  ParticleCollectionTieredSelector<RecoMuon> * muonTieredSelector_; // applies loose, fakeable and tight selection in one pass
 
   RecoElectronReader * electronReader_;
   RecoElectronCollectionCleaner * electronCleaner_;
   RecoElectronCollectionSelectorLoose * looseElectronSelector_;
   RecoElectronCollectionSelectorFakeable * fakeableElectronSelector_;
   RecoElectronCollectionSelectorTight * tightElectronSelector_;
+  ParticleCollectionTieredSelector<RecoElectron> * electronTieredSelector_; // applies loose, fakeable and tight selection in one pass
 
   RecoHadTauReader * hadTauReader_;
   RecoHadTauCollectionCleaner * hadTauCleaner_;
   RecoHadTauCollectionSelectorLoose * looseHadTauSelector_;
   RecoHadTauCollectionSelectorFakeable * fakeableHadTauSelector_;
   RecoHadTauCollectionSelectorTight * tightHadTauSelector_;
+  ParticleCollectionTieredSelector<RecoHadTau> * hadTauTieredSelector_; // applies fakeable and tight selection in one pass
 
   RecoJetReaderAK4 * jetReaderAK4_;
   RecoJetCollectionCleanerAK4 * jetCleanerAK4_dR04_; // used for cleaning AK4 jets wrt electrons, muons, and tauh
@@ -108,6 +186,7 @@ class EventReader : public ReaderBase
   RecoJetCollectionSelectorAK4 * jetSelectorAK4_;
   RecoJetCollectionSelectorAK4_btagLoose * jetSelectorAK4_btagLoose_;
   RecoJetCollectionSelectorAK4_btagMedium * jetSelectorAK4_btagMedium_;
+  ParticleCollectionTieredSelector<RecoJetAK4> * jetTieredSelectorAK4_; // applies jet, loose and medium b-tag selection in one pass
 
   GenLeptonReader * genLeptonReader_;
   GenHadTauReader * genHadTauReader_;
@@ -129,6 +208,11 @@ class EventReader : public ReaderBase
 
   RecoVertexReader * vertexReader_;
 
+  EventStore * store_; ///< storage for the objects of the current event, reused for all entries
+
+  TTree * tree_;               ///< tree given to the last call of setBranchAddresses
+  mutable long long genEntry_; ///< entry of tree_ for which the gen-level objects in store_ have been read (-1 if none)
+
   bool isDEBUG_;
 };
 
@@ -0,0 +1,96 @@
+#ifndef TallinnNtupleProducer_Readers_EventStore_h
+#define TallinnNtupleProducer_Readers_EventStore_h
+
+#include "TallinnNtupleProducer/Objects/interface/GenHadTau.h"                          // GenHadTau
+#include "TallinnNtupleProducer/Objects/interface/GenJet.h"                             // GenJet
+#include "TallinnNtupleProducer/Objects/interface/GenLepton.h"                          // GenLepton
+#include "TallinnNtupleProducer/Objects/interface/GenPhoton.h"                          // GenPhoton
+#include "TallinnNtupleProducer/Objects/interface/RecoElectron.h"                       // RecoElectronCollection, RecoElectronPtrCollection
+#include "TallinnNtupleProducer/Objects/interface/RecoHadTau.h"                         // RecoHadTauCollection, RecoHadTauPtrCollection
+#include "TallinnNtupleProducer/Objects/interface/RecoJetAK4.h"                         // RecoJetCollectionAK4, RecoJetPtrCollectionAK4
+#include "TallinnNtupleProducer/Objects/interface/RecoJetAK8.h"                         // RecoJetCollectionAK8, RecoJetPtrCollectionAK8
+#include "TallinnNtupleProducer/Objects/interface/RecoLepton.h"                         // RecoLepton
+#include "TallinnNtupleProducer/Objects/interface/RecoMEt.h"                            // RecoMEt
+#include "TallinnNtupleProducer/Objects/interface/RecoMuon.h"                           // RecoMuonCollection, RecoMuonPtrCollection
+#include "TallinnNtupleProducer/Readers/interface/GenParticleIndex.h"                   // GenParticleIndex
+#include "TallinnNtupleProducer/Selectors/interface/ParticleCollectionTieredSelector.h" // TieredParticleCollection
+
+#include <vector>                                                                       // std::vector
+
+/**
+ * @brief Storage for the reconstructed and generator-level objects of one event.
+ *
+ *        The EventStore is owned by the EventReader and is reused for all entries,
+ *        so that no memory needs to be allocated for the object collections once their capacity suffices.
+ *        The Event object returned by EventReader::read holds pointers to the objects and to the collections of selected objects in this storage,
+ *        which stay valid until the next call to EventReader::read.
+ */
+class EventStore
+{
+ public:
+  EventStore();
+  ~EventStore();
+
+  /**
+   * @brief Remove all reconstructed objects from the storage (keeping the capacity of the collections).
+   *        The generator-level objects are kept, as they are shared by all systematic shifts of the same entry.
+   */
+  void
+  clear();
+
+  /**
+   * @brief Remove all generator-level objects and their indexes from the storage (keeping the capacity of the collections)
+   */
+  void
+  clear_gen();
+
+  friend class EventReader;
+
+ protected:
+  RecoMuonCollection muons_;
+  RecoMuonPtrCollection muon_ptrs_;
+  TieredParticleCollection<RecoMuon> selMuons_;
+
+  RecoElectronCollection electrons_;
+  RecoElectronPtrCollection electron_ptrs_;
+  RecoElectronPtrCollection cleanedElectrons_;
+  TieredParticleCollection<RecoElectron> selElectrons_;
+
+  TieredParticleCollection<RecoLepton> selLeptons_;
+
+  RecoHadTauCollection hadTaus_;
+  RecoHadTauPtrCollection hadTau_ptrs_;
+  RecoHadTauPtrCollection cleanedHadTaus_;
+  TieredParticleCollection<RecoHadTau> selHadTaus_;
+
+  RecoJetCollectionAK4 jetsAK4_;
+  RecoJetPtrCollectionAK4 jet_ptrsAK4_;
+  RecoJetPtrCollectionAK4 cleanedJetsAK4_;
+  TieredParticleCollection<RecoJetAK4> selJetsAK4_;
+
+  RecoJetCollectionAK8 jetsAK8_Hbb_;
+  RecoJetPtrCollectionAK8 jet_ptrsAK8_Hbb_;
+  RecoJetPtrCollectionAK8 cleanedJetsAK8_Hbb_;
+  RecoJetPtrCollectionAK8 selJetsAK8_Hbb_;
+  RecoJetCollectionAK8 jetsAK8_Wjj_;
+  RecoJetPtrCollectionAK8 jet_ptrsAK8_Wjj_;
+  RecoJetPtrCollectionAK8 selJetsAK8_Wjj_;
+
+  RecoMEt met_;
+
+  std::vector<GenLepton> genLeptons_;
+  std::vector<GenLepton> genElectrons_;
+  std::vector<GenLepton> genMuons_;
+  std::vector<GenHadTau> genHadTaus_;
+  std::vector<GenPhoton> genPhotons_;
+  std::vector<GenJet> genJets_;
+
+  GenParticleIndex<GenLepton> genLeptonIndex_;
+  GenParticleIndex<GenLepton> genElectronIndex_;
+  GenParticleIndex<GenLepton> genMuonIndex_;
+  GenParticleIndex<GenHadTau> genHadTauIndex_;
+  GenParticleIndex<GenPhoton> genPhotonIndex_;
+  GenParticleIndex<GenJet> genJetIndex_;
+};
+
+#endif // TallinnNtupleProducer_Readers_EventStore_h
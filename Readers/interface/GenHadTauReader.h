@@ -28,6 +28,13 @@ class GenHadTauReader : public ReaderBase
   std::vector<GenHadTau>
   read() const;
 
+  /**
+   * @brief Same as above, but fill the collection of GenHadTau objects given as function argument in place.
+   *        The collection is cleared first, but keeps its capacity, so that it can be reused for each event without reallocating memory.
+   */
+  void
+  read(std::vector<GenHadTau> & hadTaus) const;
+
  protected:
  /**
    * @brief Initialize names of branches to be read from tree
@@ -56,8 +63,8 @@ class GenHadTauReader : public ReaderBase
 
   // CV: make sure that only one GenHadTauReader instance exists for a given branchName,
   //     as ROOT cannot handle multiple TTree::SetBranchAddress calls for the same branch.
-  static std::map<std::string, int> numInstances_;
-  static std::map<std::string, GenHadTauReader*> instances_;
+  static thread_local std::map<std::string, int> numInstances_;
+  static thread_local std::map<std::string, GenHadTauReader*> instances_;
 };
 
 #endif // TallinnNtupleProducer_Readers_GenHadTauReader_h
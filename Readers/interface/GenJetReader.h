@@ -28,6 +28,13 @@ class GenJetReader : public ReaderBase
   std::vector<GenJet>
   read() const;
 
+  /**
+   * @brief Same as above, but fill the collection of GenJet objects given as function argument in place.
+   *        The collection is cleared first, but keeps its capacity, so that it can be reused for each event without reallocating memory.
+   */
+  void
+  read(std::vector<GenJet> & jets) const;
+
   void
   read_partonFlavour();
 
@@ -59,8 +66,8 @@ class GenJetReader : public ReaderBase
 
   // CV: make sure that only one RecoJetReader instance exists for a given branchName,
   //     as ROOT cannot handle multiple TTree::SetBranchAddress calls for the same branch.
-  static std::map<std::string, int> numInstances_;
-  static std::map<std::string, GenJetReader *> instances_;
+  static thread_local std::map<std::string, int> numInstances_;
+  static thread_local std::map<std::string, GenJetReader *> instances_;
 };
 
 #endif // TallinnNtupleProducer_Readers_GenJetReader_h
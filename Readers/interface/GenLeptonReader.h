@@ -28,6 +28,13 @@ class GenLeptonReader : public ReaderBase
   std::vector<GenLepton>
   read() const;
 
+  /**
+   * @brief Same as above, but fill the collection of GenLepton objects given as function argument in place.
+   *        The collection is cleared first, but keeps its capacity, so that it can be reused for each event without reallocating memory.
+   */
+  void
+  read(std::vector<GenLepton> & leptons) const;
+
   /**
    * @brief enable/disable read genPartFlav branch
    * @param flag If true, reads genPartFlav branch; if false, does not read genPartFlav branch
@@ -70,8 +77,8 @@ class GenLeptonReader : public ReaderBase
 
   // CV: make sure that only one GenLeptonReader instance exists for a given branchName,
   //     as ROOT cannot handle multiple TTree::SetBranchAddress calls for the same branch.
-  static std::map<std::string, int> numInstances_;
-  static std::map<std::string, GenLeptonReader *> instances_;
+  static thread_local std::map<std::string, int> numInstances_;
+  static thread_local std::map<std::string, GenLeptonReader *> instances_;
 };
 
 #endif // TallinnNtupleProducer_Readers_GenLeptonReader_h
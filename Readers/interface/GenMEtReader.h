@@ -44,8 +44,8 @@ class GenMEtReader : public ReaderBase
 
   // CV: make sure that only one GenMEtReader instance exists for a given branchName,
   //     as ROOT cannot handle multiple TTree::SetBranchAddress calls for the same branch.
-  static std::map<std::string, int> numInstances_;
-  static std::map<std::string, GenMEtReader *> instances_;
+  static thread_local std::map<std::string, int> numInstances_;
+  static thread_local std::map<std::string, GenMEtReader *> instances_;
 };
 
 #endif // TallinnNtupleProducer_Readers_GenMEtReader_h  
@@ -0,0 +1,102 @@
+#ifndef TallinnNtupleProducer_Readers_GenParticleIndex_h
+#define TallinnNtupleProducer_Readers_GenParticleIndex_h
+
+#include <algorithm> // std::sort(), std::lower_bound()
+#include <cstddef>   // std::size_t
+#include <vector>    // std::vector
+
+/**
+ * @brief Index of a collection of generator level particles sorted in eta,
+ *        used to find the candidates for matching a reconstructed particle by dR without scanning the whole collection.
+ *
+ * The index is built once per event and gen particle collection and can then be used to match all collections of reconstructed particles.
+ * It holds a pointer to the collection of gen particles, so the collection must neither be modified nor reallocated while the index is in use.
+ */
+template <typename Tgen>
+class GenParticleIndex
+{
+ public:
+  struct Entry
+  {
+    double eta_;      ///< eta of the gen particle
+    std::size_t idx_; ///< index of the gen particle in the collection
+  };
+  typedef typename std::vector<Entry>::const_iterator const_iterator;
+
+  GenParticleIndex()
+    : genParticles_(nullptr)
+  {}
+  explicit
+  GenParticleIndex(const std::vector<Tgen> & genParticles)
+    : genParticles_(nullptr)
+  {
+    build(genParticles);
+  }
+  ~GenParticleIndex() {}
+
+  /**
+   * @brief Index the collection of gen particles given as function argument (keeping the capacity of the index)
+   */
+  void
+  build(const std::vector<Tgen> & genParticles)
+  {
+    genParticles_ = &genParticles;
+    entries_.clear();
+    entries_.reserve(genParticles.size());
+    for(std::size_t idx = 0; idx < genParticles.size(); ++idx)
+    {
+      entries_.push_back({ genParticles[idx].eta(), idx });
+    }
+    std::sort(entries_.begin(), entries_.end(),
+      [](const Entry & lhs, const Entry & rhs) -> bool
+      {
+        return lhs.eta_ < rhs.eta_;
+      }
+    );
+  }
+
+  void
+  clear()
+  {
+    genParticles_ = nullptr;
+    entries_.clear();
+  }
+
+  const std::vector<Tgen> &
+  genParticles() const
+  {
+    return *genParticles_;
+  }
+
+  std::size_t
+  size() const
+  {
+    return entries_.size();
+  }
+
+  /**
+   * @brief Return first entry with eta greater or equal to given value
+   */
+  const_iterator
+  lower_bound(double eta) const
+  {
+    return std::lower_bound(entries_.begin(), entries_.end(), eta,
+      [](const Entry & entry, double value) -> bool
+      {
+        return entry.eta_ < value;
+      }
+    );
+  }
+
+  const_iterator
+  end() const
+  {
+    return entries_.end();
+  }
+
+ protected:
+  const std::vector<Tgen> * genParticles_;
+  std::vector<Entry> entries_;
+};
+
+#endif // TallinnNtupleProducer_Readers_GenParticleIndex_h
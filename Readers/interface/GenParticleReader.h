@@ -71,8 +71,8 @@ class GenParticleReader : public ReaderBase
 
   // CV: make sure that only one GenParticleReader instance exists for a given branchName,
   //     as ROOT cannot handle multiple TTree::SetBranchAddress calls for the same branch.
-  static std::map<std::string, int> numInstances_;
-  static std::map<std::string, GenParticleReader*> instances_;
+  static thread_local std::map<std::string, int> numInstances_;
+  static thread_local std::map<std::string, GenParticleReader*> instances_;
 };
 
 #endif // TallinnNtupleProducer_Readers_GenParticleReader_h
@@ -28,6 +28,14 @@ class GenPhotonReader : public ReaderBase
   std::vector<GenPhoton>
   read(bool readAll = false) const;
 
+  /**
+   * @brief Same as above, but fill the collection of GenPhoton objects given as function argument in place.
+   *        The collection is cleared first, but keeps its capacity, so that it can be reused for each event without reallocating memory.
+   */
+  void
+  read(std::vector<GenPhoton> & photons,
+       bool readAll = false) const;
+
   /**
    * @brief enable/disable read genPartFlav branch
    * @param flag If true, reads genPartFlav branch; if false, does not read genPartFlav branch
@@ -69,8 +77,8 @@ class GenPhotonReader : public ReaderBase
 
   // CV: make sure that only one GenPhotonReader instance exists for a given branchName,
   //     as ROOT cannot handle multiple TTree::SetBranchAddress calls for the same branch.
-  static std::map<std::string, int> numInstances_;
-  static std::map<std::string, GenPhotonReader *> instances_;
+  static thread_local std::map<std::string, int> numInstances_;
+  static thread_local std::map<std::string, GenPhotonReader *> instances_;
 };
 
 #endif // TallinnNtupleProducer_Readers_GenPhotonReader_h
@@ -49,8 +49,8 @@ class L1PreFiringWeightReader : public ReaderBase
 
   // make sure that only one L1PreFiringWeightReader instance exists for a given branchName,
   // as ROOT cannot handle multiple TTree::SetBranchAddress calls for the same branch.
-  static std::map<std::string, int> numInstances_;
-  static std::map<std::string, L1PreFiringWeightReader *> instances_;
+  static thread_local std::map<std::string, int> numInstances_;
+  static thread_local std::map<std::string, L1PreFiringWeightReader *> instances_;
 };
 
 #endif // TallinnNtupleProducer_Readers_L1PreFiringWeightReader_h
@@ -101,8 +101,8 @@ class LHEInfoReader : public ReaderBase
 
   // CV: make sure that only one LHEInfoReader instance exists for a given branchName,
   //     as ROOT cannot handle multiple TTree::SetBranchAddress calls for the same branch.
-  static std::map<std::string, int> numInstances_;
-  static std::map<std::string, LHEInfoReader *> instances_;
+  static thread_local std::map<std::string, int> numInstances_;
+  static thread_local std::map<std::string, LHEInfoReader *> instances_;
 };
 
 #endif // tthAnalysis_HiggsToTauTau_LHEInfoReader_h
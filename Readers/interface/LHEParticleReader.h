@@ -56,8 +56,8 @@ class LHEParticleReader : public ReaderBase
 
   // CV: make sure that only one LHEParticleReader instance exists for a given branchName,
   //     as ROOT cannot handle multiple TTree::SetBranchAddress calls for the same branch.
-  static std::map<std::string, int> numInstances_;
-  static std::map<std::string, LHEParticleReader*> instances_;
+  static thread_local std::map<std::string, int> numInstances_;
+  static thread_local std::map<std::string, LHEParticleReader*> instances_;
 };
 
 #endif // TallinnNtupleProducer_Readers_LHEParticleReader_h
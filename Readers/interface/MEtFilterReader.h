@@ -32,8 +32,8 @@ class MEtFilterReader : public ReaderBase
   std::array<std::string, MEtFilterFlag::LAST> branchNames_;
 
   // CV: make sure that only one MEtFilterReader instance exists,
-  static int numInstances_;
-  static MEtFilterReader * instance_;
+  static thread_local int numInstances_;
+  static thread_local MEtFilterReader * instance_;
 
   MEtFilter metFilter_;
   Era era_;
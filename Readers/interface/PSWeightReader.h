@@ -66,8 +66,8 @@ class PSWeightReader : public ReaderBase
    bool has_PS_weights_;
    bool apply_LHE_nom_;
 
-   static std::map<std::string, int> numInstances_;
-   static std::map<std::string, PSWeightReader *> instances_;
+   static thread_local std::map<std::string, int> numInstances_;
+   static thread_local std::map<std::string, PSWeightReader *> instances_;
 };
 
 #endif // tthAnalysis_HiggsToTauTau_PSWeightReader_h
@@ -12,6 +12,7 @@
 #include "TallinnNtupleProducer/Objects/interface/RecoHadTau.h"       // RecoHadTau
 #include "TallinnNtupleProducer/Objects/interface/RecoJetAK4.h"       // RecoJetAK4
 #include "TallinnNtupleProducer/Objects/interface/RecoMuon.h"         // RecoMuon
+#include "TallinnNtupleProducer/Readers/interface/GenParticleIndex.h" // GenParticleIndex
 
 #include <algorithm>                                                  // std::find()
 
@@ -35,6 +36,9 @@ class ParticleCollectionGenMatcher
 
   /**
    * @brief Match reconstructed particles to generator level electrons and muons by dR
+   *
+   * The overloads taking a GenParticleIndex instead of the collection of gen particles
+   * allow to reuse the same index for matching several collections of reconstructed particles.
    */
   void
   addGenLeptonMatch(const std::vector<const Trec *> & recParticles,
@@ -43,20 +47,31 @@ class ParticleCollectionGenMatcher
                     double minDPtRel = -0.5,
                     double maxDPtRel = +0.5,
                     int status = 1) const
+  {
+    return addGenLeptonMatch(recParticles, GenParticleIndex<GenLepton>(genLeptons), dRmax, minDPtRel, maxDPtRel, status);
+  }
+
+  void
+  addGenLeptonMatch(const std::vector<const Trec *> & recParticles,
+                    const GenParticleIndex<GenLepton> & genLeptons,
+                    double dRmax = 0.3,
+                    double minDPtRel = -0.5,
+                    double maxDPtRel = +0.5,
+                    int status = 1) const
   {
     return addGenMatch<GenLepton, GenLeptonLinker>(recParticles, genLeptons, dRmax, minDPtRel, maxDPtRel, genLeptonLinker_, status);
   }
 
   void
   addGenLeptonMatchByIndex(const std::vector<const Trec *> & recParticles,
-                           const std::vector<GenParticle> & genParticles,
+                           const std::vector<GenLepton> & genLeptons,
                            GenParticleType genParticleType) const
   {
     if(genParticleType == GenParticleType::kGenPhoton)
     {
       throw cmsException(this, __func__, __LINE__) << "Cannot match to gen photons in this function";
     }
-    return addGenMatchByIndex<GenLeptonLinker>(recParticles, genParticles, genLeptonLinker_, genParticleType);
+    return addGenMatchByIndex<GenLeptonLinker>(recParticles, genLeptons, genLeptonLinker_, genParticleType);
   }
 
   /**
@@ -67,6 +82,15 @@ class ParticleCollectionGenMatcher
                     const std::vector<GenHadTau> & genHadTaus,
                     double dRmax = 0.3,
                     double maxDPtRel = 1.0) const
+  {
+    return addGenHadTauMatch(recParticles, GenParticleIndex<GenHadTau>(genHadTaus), dRmax, maxDPtRel);
+  }
+
+  void
+  addGenHadTauMatch(const std::vector<const Trec *> & recParticles,
+                    const GenParticleIndex<GenHadTau> & genHadTaus,
+                    double dRmax = 0.3,
+                    double maxDPtRel = 1.0) const
   {
     std::vector<unsigned char> genPartFlavs;
     if(typeid(Trec) == typeid(RecoHadTau))
@@ -82,15 +106,25 @@ class ParticleCollectionGenMatcher
                     double dRmax = 0.3,
                     double maxDPtRel = 1.0, // 0 < pt(reco) < 2 * pt(gen)
                     int status = 1) const
+  {
+    return addGenPhotonMatch(recParticles, GenParticleIndex<GenPhoton>(genPhotons), dRmax, maxDPtRel, status);
+  }
+
+  void
+  addGenPhotonMatch(const std::vector<const Trec *> & recParticles,
+                    const GenParticleIndex<GenPhoton> & genPhotons,
+                    double dRmax = 0.3,
+                    double maxDPtRel = 1.0, // 0 < pt(reco) < 2 * pt(gen)
+                    int status = 1) const
   {
     return addGenMatch<GenPhoton, GenPhotonLinker>(recParticles, genPhotons, dRmax, maxDPtRel, genPhotonLinker_, status);
   }
 
   void
   addGenPhotonMatchByIndex(const std::vector<const Trec *> & recParticles,
-                           const std::vector<GenParticle> & genParticles) const
+                           const std::vector<GenPhoton> & genPhotons) const
   {
-    return addGenMatchByIndex<GenPhotonLinker>(recParticles, genParticles, genPhotonLinker_, GenParticleType::kGenPhoton);
+    return addGenMatchByIndex<GenPhotonLinker>(recParticles, genPhotons, genPhotonLinker_, GenParticleType::kGenPhoton);
   }
 
   /**
@@ -101,13 +135,22 @@ class ParticleCollectionGenMatcher
                  const std::vector<GenJet> & genJets,
                  double dRmax = 0.3,
                  double maxDPtRel = 0.5) const
+  {
+    return addGenJetMatch(recParticles, GenParticleIndex<GenJet>(genJets), dRmax, maxDPtRel);
+  }
+
+  void
+  addGenJetMatch(const std::vector<const Trec *> & recParticles,
+                 const GenParticleIndex<GenJet> & genJets,
+                 double dRmax = 0.3,
+                 double maxDPtRel = 0.5) const
   {
     return addGenMatch<GenJet, GenJetLinker>(recParticles, genJets, dRmax, maxDPtRel, genJetLinker_);
   }
 
   void
   addGenJetMatchByIndex(const std::vector<const Trec *> & recParticles,
-                        const std::vector<GenParticle> & genJets) const
+                        const std::vector<GenJet> & genJets) const
   {
     return addGenMatchByIndex<GenJetLinker>(recParticles, genJets, genJetLinker_, GenParticleType::kGenAny);
   }
@@ -120,7 +163,7 @@ class ParticleCollectionGenMatcher
             typename Tlinker>
   void
   addGenMatch(const std::vector<const Trec *> & recParticles,
-              const std::vector<Tgen> & genParticles,
+              const GenParticleIndex<Tgen> & genParticles,
               double dRmax,
               double maxDPtRel,
               const Tlinker & linker,
@@ -132,11 +175,18 @@ class ParticleCollectionGenMatcher
     );
   }
 
+  /**
+   * @brief Match each reconstructed particle to the gen particle closest in dR that passes the constraints and is not yet matched
+   *
+   * Only the gen particles within dRmax in eta are considered, which are found in the index by binary search.
+   * In case of several gen particles at the same dR, the one that comes first in the gen particle collection is taken,
+   * so that the result is the same as when looping over the whole gen particle collection.
+   */
   template <typename Tgen,
             typename Tlinker>
   void
   addGenMatch(const std::vector<const Trec *> & recParticles,
-              const std::vector<Tgen> & genParticles,
+              const GenParticleIndex<Tgen> & genIndex,
               double dRmax,
               double minDPtRel,
               double maxDPtRel,
@@ -145,6 +195,9 @@ class ParticleCollectionGenMatcher
               const std::vector<unsigned char> & genPartFlavs = {}) const
   {
     assert(minDPtRel < 0. && maxDPtRel > 0.);
+    // CV: widen the eta window slightly, so that rounding cannot exclude a gen particle with dR < dRmax;
+    //     the gen particles within the window are required to pass dR < dRmax below
+    const double dEtaMax = dRmax + 1.e-6;
     for(const Trec * recParticle: recParticles)
     {
       if(recParticle->hasAnyGenMatch())
@@ -153,11 +206,14 @@ class ParticleCollectionGenMatcher
         continue;
       }
       Tgen * bestMatch = nullptr;
+      std::size_t idx_bestMatch = genIndex.size();
       double dR_bestMatch = 1.e+3;
       double dPtRel_bestMatch = 1.e+3;
 
-      for(const Tgen & genParticle: genParticles)
+      const double recEta = recParticle->eta();
+      for(auto entry = genIndex.lower_bound(recEta - dEtaMax); entry != genIndex.end() && entry->eta_ <= recEta + dEtaMax; ++entry)
       {
+        const Tgen & genParticle = genIndex.genParticles()[entry->idx_];
         const double dR = deltaR(
           recParticle->eta(), recParticle->phi(), genParticle.eta(), genParticle.phi()
         );
@@ -173,9 +229,11 @@ class ParticleCollectionGenMatcher
         {
           passesConstraints &= genParticle.status() == status;
         }
-        if(dR < dRmax && dR < dR_bestMatch && passesConstraints && ! genParticle.isMatchedToReco())
+        if(dR < dRmax && (dR < dR_bestMatch || (dR == dR_bestMatch && entry->idx_ < idx_bestMatch)) &&
+           passesConstraints && ! genParticle.isMatchedToReco())
         {
           bestMatch = const_cast<Tgen *>(&genParticle);
+          idx_bestMatch = entry->idx_;
           dR_bestMatch = dR;
           dPtRel_bestMatch = dPtRel;
         }
@@ -200,14 +258,14 @@ class ParticleCollectionGenMatcher
       {
         std::cout
           << "Did not find gen match for reconstructed object in gen particle collection '" << typeid (Tgen).name()
-          << "' (size = " << genParticles.size() << "):\n" << *recParticle << '\n'
+          << "' (size = " << genIndex.size() << "):\n" << *recParticle << '\n'
         ;
       }
     }
   }
 
   template <typename Tlinker,
-            typename Tgen = GenParticle>
+            typename Tgen>
   void
   addGenMatchByIndex(const std::vector<const Trec *> & recParticles,
                      const std::vector<Tgen> & genParticles,
@@ -318,20 +376,14 @@ class ParticleCollectionGenMatcher
     }
   }
 
+  // CV: the linkers do not copy the gen particles, so the gen particle collections must stay valid as long as the reco particles are used
   struct GenLeptonLinker
   {
     void
     operator()(Trec & recParticle,
                const GenLepton * genLepton) const
     {
-      recParticle.set_genLepton(new GenLepton(*genLepton));
-    }
-
-    void
-    operator()(Trec & recParticle,
-               const GenParticle * genLepton) const
-    {
-      recParticle.set_genLepton(new GenLepton(*genLepton));
+      recParticle.set_genLepton(genLepton);
     }
   };
   GenLeptonLinker genLeptonLinker_;
@@ -341,7 +393,7 @@ class ParticleCollectionGenMatcher
     void operator()(Trec & recParticle,
                     const GenHadTau * genHadTau) const
     {
-      recParticle.set_genHadTau(new GenHadTau(*genHadTau));
+      recParticle.set_genHadTau(genHadTau);
     }
   };
   GenHadTauLinker genHadTauLinker_;
@@ -351,13 +403,7 @@ class ParticleCollectionGenMatcher
     void operator()(Trec & recParticle,
                     const GenPhoton * genPhoton) const
     {
-      recParticle.set_genPhoton(new GenPhoton(*genPhoton));
-    }
-
-    void operator()(Trec & recParticle,
-                    const GenParticle * genPhoton) const
-    {
-      recParticle.set_genPhoton(new GenPhoton(*genPhoton));
+      recParticle.set_genPhoton(genPhoton);
     }
   };
   GenPhotonLinker genPhotonLinker_;
@@ -367,13 +413,7 @@ class ParticleCollectionGenMatcher
     void operator()(Trec & recParticle,
                     const GenJet * genJet) const
     {
-      recParticle.set_genJet(new GenJet(*genJet));
-    }
-
-    void operator()(Trec & recParticle,
-                    const GenParticle * genJet) const
-    {
-      recParticle.set_genJet(new GenJet(*genJet));
+      recParticle.set_genJet(genJet);
     }
   };
   GenJetLinker genJetLinker_;
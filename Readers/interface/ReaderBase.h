@@ -7,6 +7,12 @@
 class TTree;
 enum class Era;
 
+/**
+ * @brief Base class for all reader classes.
+ *
+ * @note The static registries (numInstances_, instances_), which derrived classes use to make sure that each branch is bound to one reader instance only,
+ *       are declared thread_local: each thread needs to create, use and delete its own reader instances (and its own TTreeWrapper)
+ */
 class ReaderBase
 {
  public:
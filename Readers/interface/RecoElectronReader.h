@@ -35,6 +35,26 @@ class RecoElectronReader : public ReaderBase
   std::vector<RecoElectron>
   read() const;
 
+  /**
+   * @brief Same as above, but fill the collection of RecoElectron objects given as function argument in place.
+   *        The collection is cleared first, but keeps its capacity, so that it can be reused for each event without reallocating memory.
+   */
+  void
+  read(std::vector<RecoElectron> & electrons) const;
+
+  /**
+   * @brief Return name of the branch holding the number of electrons
+   */
+  const std::string &
+  getBranchName_num() const;
+
+  /**
+   * @brief Return number of electrons in the current entry, as read from the branch getBranchName_num().
+   *        Only this branch needs to be read from the tree, so that the number can be used for a preselection of events
+   */
+  unsigned
+  get_num() const;
+
   /**
     * @brief Return list of systematic uncertainties supported by RecoElectronReader class
     */
@@ -48,6 +68,18 @@ class RecoElectronReader : public ReaderBase
   void
   set_mvaTTH_wp(double mvaTTH_wp);
 
+  /**
+   * @brief Skip electrons failing the cuts on pT, abs(eta), abs(dxy) and abs(dz) given as function arguments,
+   *        before the RecoElectron objects are constructed
+   *
+   * The cuts are applied to the branch arrays directly and must not be tighter than the loosest selection applied to the RecoElectron objects.
+   */
+  void
+  set_preselection(double min_pt,
+                   double max_absEta,
+                   double max_dxy,
+                   double max_dz);
+
  protected:
  /**
    * @brief Initialize names of branches to be read from tree
@@ -87,13 +119,21 @@ class RecoElectronReader : public ReaderBase
 
   double mvaTTH_wp_;
 
+  bool apply_preselection_;
+  double preselection_min_pt_;
+  double preselection_max_absEta_;
+  double preselection_max_dxy_;
+  double preselection_max_dz_;
+  mutable std::vector<unsigned char> passesPreselection_; ///< flags of the electrons passing the preselection, one per lepton stored in the Ntuple
+  mutable std::vector<std::size_t> preselectedIdxs_;      ///< indices of the electrons passing the preselection, one per RecoElectron object
+
   std::map<EGammaID, Float_t *> rawMVAs_POG_;
   std::map<EGammaID, std::map<EGammaWP, Bool_t *>> mvaIDs_POG_;
 
   // CV: make sure that only one RecoElectronReader instance exists for a given branchName,
   //     as ROOT cannot handle multiple TTree::SetBranchAddress calls for the same branch.
-  static std::map<std::string, int> numInstances_;
-  static std::map<std::string, RecoElectronReader *> instances_;
+  static thread_local std::map<std::string, int> numInstances_;
+  static thread_local std::map<std::string, RecoElectronReader *> instances_;
 };
 
 #endif // TallinnNtupleProducer_Readers_RecoElectronReader_h
@@ -1,6 +1,8 @@
 #ifndef TallinnNtupleProducer_Readers_RecoHadTauReader_h
 #define TallinnNtupleProducer_Readers_RecoHadTauReader_h
 
+#include "TallinnNtupleProducer/Objects/interface/GenJet.h"     // GenJet
+#include "TallinnNtupleProducer/Objects/interface/GenLepton.h"  // GenLepton
 #include "TallinnNtupleProducer/Objects/interface/RecoHadTau.h" // RecoHadTau
 #include "TallinnNtupleProducer/Readers/interface/ReaderBase.h" // ReaderBase
 
@@ -26,6 +28,20 @@ class RecoHadTauReader : public ReaderBase
   void
   set_default_tauID(TauID tauId);
 
+  /**
+   * @brief Skip hadronic taus failing the cuts on pT (after the tau energy scale correction), abs(eta), abs(dz) and decay mode
+   *        given as function arguments, before the RecoHadTau objects are constructed
+   *
+   * The cuts are applied to the branch arrays directly and must not be tighter than the loosest selection applied to the RecoHadTau objects.
+   */
+  void
+  set_preselection(double min_pt,
+                   double max_absEta,
+                   double max_dz,
+                   bool apply_decayModeFinding,
+                   const std::vector<int> & decayMode_whitelist,
+                   const std::vector<int> & decayMode_blacklist);
+
   /**
    * @brief Call tree->SetBranchAddress for all RecoHadTau branches
    */
@@ -39,6 +55,26 @@ class RecoHadTauReader : public ReaderBase
   std::vector<RecoHadTau>
   read() const;
 
+  /**
+   * @brief Same as above, but fill the collection of RecoHadTau objects given as function argument in place.
+   *        The collection is cleared first, but keeps its capacity, so that it can be reused for each event without reallocating memory.
+   */
+  void
+  read(std::vector<RecoHadTau> & hadTaus) const;
+
+  /**
+   * @brief Return name of the branch holding the number of hadTaus
+   */
+  const std::string &
+  getBranchName_num() const;
+
+  /**
+   * @brief Return number of hadTaus in the current entry, as read from the branch getBranchName_num().
+   *        Only this branch needs to be read from the tree, so that the number can be used for a preselection of events
+   */
+  unsigned
+  get_num() const;
+
   /**
     * @brief Return list of systematic uncertainties supported by RecoHadTauReader class
     */
@@ -75,6 +111,12 @@ class RecoHadTauReader : public ReaderBase
   GenJetReader * genJetReader_;
   bool readGenMatching_;
 
+  // CV: the RecoHadTau objects link to the matched generator level particles stored in these collections,
+  //     which are overwritten by the next call to readGenMatching
+  mutable std::vector<GenLepton> matched_genLeptons_;
+  mutable std::vector<GenHadTau> matched_genHadTaus_;
+  mutable std::vector<GenJet> matched_genJets_;
+
   std::string branchName_pt_;
   std::string branchName_eta_;
   std::string branchName_phi_;
@@ -97,6 +139,18 @@ class RecoHadTauReader : public ReaderBase
   TauID tauID_;
   TauESTool * tauESTool_;
 
+  bool apply_preselection_;
+  double preselection_min_pt_;
+  double preselection_max_absEta_;
+  double preselection_max_dz_;
+  bool preselection_apply_decayModeFinding_;
+  std::vector<Int_t> preselection_decayMode_whitelist_;
+  std::vector<Int_t> preselection_decayMode_blacklist_;
+  mutable std::vector<double> corrFactors_;               ///< tau energy scale corrections, one per hadronic tau stored in the Ntuple
+  mutable std::vector<Float_t> corrPts_;                  ///< pT after the tau energy scale correction, one per hadronic tau stored in the Ntuple
+  mutable std::vector<unsigned char> passesPreselection_; ///< flags of the hadronic taus passing the preselection, one per hadronic tau stored in the Ntuple
+  mutable std::vector<std::size_t> preselectedIdxs_;      ///< indices of the hadronic taus passing the preselection, one per RecoHadTau object
+
   UInt_t nHadTaus_;
   Float_t * hadTau_pt_;
   Float_t * hadTau_eta_;
@@ -119,8 +173,8 @@ class RecoHadTauReader : public ReaderBase
 
   // CV: make sure that only one RecoHadronicTauReader instance exists for a given branchName,
   //     as ROOT cannot handle multiple TTree::SetBranchAddress calls for the same branch.
-  static std::map<std::string, int> numInstances_;
-  static std::map<std::string, RecoHadTauReader *> instances_;
+  static thread_local std::map<std::string, int> numInstances_;
+  static thread_local std::map<std::string, RecoHadTauReader *> instances_;
 };
 
 #endif // TallinnNtupleProducer_Readers_RecoHadTauReader_h
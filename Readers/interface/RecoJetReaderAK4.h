@@ -3,6 +3,8 @@
 
 #include "FWCore/ParameterSet/interface/ParameterSet.h"         // edm::ParameterSet
 
+#include "TallinnNtupleProducer/Objects/interface/GenHadTau.h"  // GenHadTau
+#include "TallinnNtupleProducer/Objects/interface/GenLepton.h"  // GenLepton
 #include "TallinnNtupleProducer/Objects/interface/RecoJetAK4.h" // RecoJetAK4
 #include "TallinnNtupleProducer/Readers/interface/ReaderBase.h" // ReaderBase
 
@@ -38,6 +40,18 @@ class RecoJetReaderAK4 : public ReaderBase
   void
   read_btag_systematics(bool flag);
 
+  /**
+   * @brief Skip jets failing the cuts on pT, abs(eta) and jet id given as function arguments,
+   *        before the RecoJet objects are constructed
+   *
+   * The cuts are applied to the branch arrays directly and must not be tighter than the loosest selection applied to the RecoJet objects.
+   * A cut on abs(eta) that is not positive is not applied.
+   */
+  void
+  set_preselection(double min_pt,
+                   double max_absEta,
+                   int min_jetId);
+
   /**
    * @brief Call tree->SetBranchAddress for all RecoJet branches
    */
@@ -51,6 +65,13 @@ class RecoJetReaderAK4 : public ReaderBase
   std::vector<RecoJetAK4>
   read() const;
 
+  /**
+   * @brief Same as above, but fill the collection of RecoJet objects given as function argument in place.
+   *        The collection is cleared first, but keeps its capacity, so that it can be reused for each event without reallocating memory.
+   */
+  void
+  read(std::vector<RecoJetAK4> & jets) const;
+
   /**
     * @brief Return list of systematic uncertainties supported by RecoJetReaderAK4 class
     */
@@ -99,6 +120,12 @@ class RecoJetReaderAK4 : public ReaderBase
   GenHadTauReader * genHadTauReader_;
   GenJetReader * genJetReader_;
   bool readGenMatching_;
+
+  // CV: the RecoJetAK4 objects link to the matched generator level particles stored in these collections,
+  //     which are overwritten by the next call to readGenMatching
+  mutable std::vector<GenLepton> matched_genLeptons_;
+  mutable std::vector<GenHadTau> matched_genHadTaus_;
+  mutable std::vector<GenJet> matched_genJets_;
  
   std::string branchName_eta_;
   std::string branchName_phi_;
@@ -125,6 +152,13 @@ class RecoJetReaderAK4 : public ReaderBase
   bool read_ptMass_systematics_;
   bool read_btag_systematics_;
 
+  bool apply_preselection_;
+  double preselection_min_pt_;
+  double preselection_max_absEta_;
+  int preselection_min_jetId_;
+  mutable std::vector<unsigned char> passesPreselection_; ///< flags of the jets passing the preselection, one per jet stored in the Ntuple
+  mutable std::vector<std::size_t> preselectedIdxs_;      ///< indices of the jets passing the preselection, one per RecoJet object
+
   UInt_t nJets_;
   Float_t * jet_eta_;
   Float_t * jet_phi_;
@@ -147,8 +181,8 @@ class RecoJetReaderAK4 : public ReaderBase
 
   // CV: make sure that only one RecoJetReader instance exists for a given branchName,
   //     as ROOT cannot handle multiple TTree::SetBranchAddress calls for the same branch.
-  static std::map<std::string, int> numInstances_;
-  static std::map<std::string, RecoJetReaderAK4 *> instances_;
+  static thread_local std::map<std::string, int> numInstances_;
+  static thread_local std::map<std::string, RecoJetReaderAK4 *> instances_;
 };
 
 #endif // TallinnNtupleProducer_Readers_RecoJetReaderAK4_h
@@ -42,6 +42,13 @@ class RecoJetReaderAK8 : public ReaderBase
   std::vector<RecoJetAK8>
   read() const;
 
+  /**
+   * @brief Same as above, but fill the collection of RecoJetAK8 objects given as function argument in place.
+   *        The collection is cleared first, but keeps its capacity, so that it can be reused for each event without reallocating memory.
+   */
+  void
+  read(std::vector<RecoJetAK8> & jets) const;
+
   /**
     * @brief Return list of systematic uncertainties supported by RecoJetReaderAK8 class
     */
@@ -117,8 +124,8 @@ class RecoJetReaderAK8 : public ReaderBase
 
   // CV: make sure that only one RecoJetReaderAK8 instance exists for a given branchName,
   //     as ROOT cannot handle multiple TTree::SetBranchAddress calls for the same branch.
-  static std::map<std::string, int> numInstances_;
-  static std::map<std::string, RecoJetReaderAK8 *> instances_;
+  static thread_local std::map<std::string, int> numInstances_;
+  static thread_local std::map<std::string, RecoJetReaderAK8 *> instances_;
 };
 
 #endif // TallinnNtupleProducer_Readers_RecoJetReaderAK8_h
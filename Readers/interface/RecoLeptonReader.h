@@ -46,42 +46,46 @@ class RecoLeptonReader : public ReaderBase
   /**
    * @brief Read branches containing information on matching of RecoElectrons and RecoMuons
    *        to generator level electrons, muons, hadronic taus, and jets from tree
-   *        and add this information to collection of RecoElectron and RecoMuon objects given as function argument
+   *        and add this information to collection of RecoElectron and RecoMuon objects given as function argument,
+   *        where the k-th RecoElectron or RecoMuon object has been read from the entry preselectedIdxs[k] of the branches
    */
   template<typename T,
            typename = std::enable_if<std::is_base_of<RecoLepton, T>::value>>
   void
-  readGenMatching(std::vector<T> & leptons) const
+  readGenMatching(std::vector<T> & leptons,
+                  const std::vector<std::size_t> & preselectedIdxs) const
   {
     if(readGenMatching_)
     {
       assert(genLeptonReader_ && genHadTauReader_ && genPhotonReader_ && genJetReader_);
 
       const std::size_t nLeptons = leptons.size();
-      std::vector<GenLepton> matched_genLeptons = genLeptonReader_->read();
-      assert(matched_genLeptons.size() == nLeptons);
-      std::vector<GenHadTau> matched_genHadTaus = genHadTauReader_->read();
-      assert(matched_genHadTaus.size() == nLeptons);
-      std::vector<GenPhoton> matched_genPhotons = genPhotonReader_->read(true);
-      assert(matched_genPhotons.size() == nLeptons);
-      std::vector<GenJet> matched_genJets = genJetReader_->read();
-      assert(matched_genJets.size() == nLeptons);
+      assert(preselectedIdxs.size() == nLeptons);
+      genLeptonReader_->read(matched_genLeptons_);
+      assert(matched_genLeptons_.size() == nLeptons_);
+      genHadTauReader_->read(matched_genHadTaus_);
+      assert(matched_genHadTaus_.size() == nLeptons_);
+      genPhotonReader_->read(matched_genPhotons_, true);
+      assert(matched_genPhotons_.size() == nLeptons_);
+      genJetReader_->read(matched_genJets_);
+      assert(matched_genJets_.size() == nLeptons_);
 
       for(std::size_t idxLepton = 0; idxLepton < nLeptons; ++idxLepton)
       {
         T & lepton = leptons[idxLepton];
+        const std::size_t idxLepton_stored = preselectedIdxs[idxLepton];
 
-        const GenLepton & matched_genLepton = matched_genLeptons[idxLepton];
-        if(matched_genLepton.isValid()) lepton.set_genLepton(new GenLepton(matched_genLepton));
+        const GenLepton & matched_genLepton = matched_genLeptons_[idxLepton_stored];
+        if(matched_genLepton.isValid()) lepton.set_genLepton(&matched_genLepton);
 
-        const GenHadTau & matched_genHadTau = matched_genHadTaus[idxLepton];
-        if(matched_genHadTau.isValid()) lepton.set_genHadTau(new GenHadTau(matched_genHadTau));
+        const GenHadTau & matched_genHadTau = matched_genHadTaus_[idxLepton_stored];
+        if(matched_genHadTau.isValid()) lepton.set_genHadTau(&matched_genHadTau);
 
-        const GenPhoton & matched_genPhoton = matched_genPhotons[idxLepton];
-        if(matched_genPhoton.isValid()) lepton.set_genPhoton(new GenPhoton(matched_genPhoton));
+        const GenPhoton & matched_genPhoton = matched_genPhotons_[idxLepton_stored];
+        if(matched_genPhoton.isValid()) lepton.set_genPhoton(&matched_genPhoton);
 
-        const GenJet & matched_genJet = matched_genJets[idxLepton];
-        if(matched_genJet.isValid()) lepton.set_genJet(new GenJet(matched_genJet));
+        const GenJet & matched_genJet = matched_genJets_[idxLepton_stored];
+        if(matched_genJet.isValid()) lepton.set_genJet(&matched_genJet);
       }
     }
   }
@@ -92,6 +96,13 @@ class RecoLeptonReader : public ReaderBase
   GenJetReader * genJetReader_;
   bool readGenMatching_;
 
+  // CV: the RecoElectron and RecoMuon objects link to the matched generator level particles stored in these collections,
+  //     which are overwritten by the next call to readGenMatching
+  mutable std::vector<GenLepton> matched_genLeptons_;
+  mutable std::vector<GenHadTau> matched_genHadTaus_;
+  mutable std::vector<GenPhoton> matched_genPhotons_;
+  mutable std::vector<GenJet> matched_genJets_;
+
   std::string branchName_pt_;
   std::string branchName_eta_;
   std::string branchName_phi_;
@@ -147,8 +158,8 @@ class RecoLeptonReader : public ReaderBase
 
   // CV: make sure that only one RecoLeptonReader instance exists for a given branchName,
   //     as ROOT cannot handle multiple TTree::SetBranchAddress calls for the same branch.
-  static std::map<std::string, int> numInstances_;
-  static std::map<std::string, RecoLeptonReader *> instances_;
+  static thread_local std::map<std::string, int> numInstances_;
+  static thread_local std::map<std::string, RecoLeptonReader *> instances_;
 };
 
 #endif // TallinnNtupleProducer_Readers_RecoLeptonReader_h
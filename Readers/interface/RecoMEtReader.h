@@ -48,6 +48,13 @@ class RecoMEtReader : public ReaderBase
   RecoMEt
   read() const;
 
+  /**
+   * @brief Same as above, but fill the RecoMEt object given as function argument in place,
+   *        so that the memory of its systematic shifts can be reused for each event without reallocating it.
+   */
+  void
+  read(RecoMEt & met) const;
+
   /**
     * @brief Return list of systematic uncertainties supported by RecoMEtReader class
     */
@@ -90,8 +97,8 @@ class RecoMEtReader : public ReaderBase
 
   // CV: make sure that only one RecoMEtReader instance exists for a given branchName,
   //     as ROOT cannot handle multiple TTree::SetBranchAddress calls for the same branch.
-  static std::map<std::string, int> numInstances_;
-  static std::map<std::string, RecoMEtReader *> instances_;
+  static thread_local std::map<std::string, int> numInstances_;
+  static thread_local std::map<std::string, RecoMEtReader *> instances_;
 };
 
 #endif // TallinnNtupleProducer_Readers_RecoMEtReader_h
@@ -33,6 +33,26 @@ class RecoMuonReader : public ReaderBase
   std::vector<RecoMuon>
   read() const;
 
+  /**
+   * @brief Same as above, but fill the collection of RecoMuon objects given as function argument in place.
+   *        The collection is cleared first, but keeps its capacity, so that it can be reused for each event without reallocating memory.
+   */
+  void
+  read(std::vector<RecoMuon> & muons) const;
+
+  /**
+   * @brief Return name of the branch holding the number of muons
+   */
+  const std::string &
+  getBranchName_num() const;
+
+  /**
+   * @brief Return number of muons in the current entry, as read from the branch getBranchName_num().
+   *        Only this branch needs to be read from the tree, so that the number can be used for a preselection of events
+   */
+  unsigned
+  get_num() const;
+
   /**
     * @brief Return list of systematic uncertainties supported by RecoMuonReader class
     */
@@ -46,6 +66,18 @@ class RecoMuonReader : public ReaderBase
   void
   set_mvaTTH_wp(double mvaTTH_wp);
 
+  /**
+   * @brief Skip muons failing the cuts on pT, abs(eta), abs(dxy) and abs(dz) given as function arguments,
+   *        before the RecoMuon objects are constructed
+   *
+   * The cuts are applied to the branch arrays directly and must not be tighter than the loosest selection applied to the RecoMuon objects.
+   */
+  void
+  set_preselection(double min_pt,
+                   double max_absEta,
+                   double max_dxy,
+                   double max_dz);
+
  protected:
  /**
    * @brief Initialize names of branches to be read from tree
@@ -69,10 +101,18 @@ class RecoMuonReader : public ReaderBase
 
   double mvaTTH_wp_;
 
+  bool apply_preselection_;
+  double preselection_min_pt_;
+  double preselection_max_absEta_;
+  double preselection_max_dxy_;
+  double preselection_max_dz_;
+  mutable std::vector<unsigned char> passesPreselection_; ///< flags of the muons passing the preselection, one per lepton stored in the Ntuple
+  mutable std::vector<std::size_t> preselectedIdxs_;      ///< indices of the muons passing the preselection, one per RecoMuon object
+
   // CV: make sure that only one RecoMuonReader instance exists for a given branchName,
   //     as ROOT cannot handle multiple TTree::SetBranchAddress calls for the same branch.
-  static std::map<std::string, int> numInstances_;
-  static std::map<std::string, RecoMuonReader *> instances_;
+  static thread_local std::map<std::string, int> numInstances_;
+  static thread_local std::map<std::string, RecoMuonReader *> instances_;
 };
 
 #endif // TallinnNtupleProducer_Readers_RecoMuonReader_h
@@ -62,8 +62,8 @@ class RecoSubjetReaderAK8 : public ReaderBase
 
   // CV: make sure that only one RecoSubjetReaderAK8 instance exists for a given branchName,
   //     as ROOT cannot handle multiple TTree::SetBranchAddress calls for the same branch.
-  static std::map<std::string, int> numInstances_;
-  static std::map<std::string, RecoSubjetReaderAK8 *> instances_;
+  static thread_local std::map<std::string, int> numInstances_;
+  static thread_local std::map<std::string, RecoSubjetReaderAK8 *> instances_;
 };
 
 #endif // TallinnNtupleProducer_Readers_RecoSubjetReaderAK8_h
@@ -62,8 +62,8 @@ class RecoVertexReader : public ReaderBase
 
   // CV: make sure that only one RecoVertexReader instance exists for a given branchName,
   //     as ROOT cannot handle multiple TTree::SetBranchAddress calls for the same branch.
-  static std::map<std::string, int> numInstances_;
-  static std::map<std::string, RecoVertexReader *> instances_;
+  static thread_local std::map<std::string, int> numInstances_;
+  static thread_local std::map<std::string, RecoVertexReader *> instances_;
 };
 
 #endif // TallinnNtupleProducer_Readers_RecoVertexReader_h
@@ -3,17 +3,31 @@
 
 /**
  * @brief Auxiliary function to convert std::vector<Particle> to std::vector<const Particle*>, 
- * @return std::vector of const pointers to particles in collection given as function argument
+ *        filling the std::vector of const pointers given as second function argument in place
  */
 template <typename T> 
-std::vector<const T*>
-convert_to_ptrs(const std::vector<T> & particles)
+void
+convert_to_ptrs(const std::vector<T> & particles,
+                std::vector<const T*> & particle_ptrs)
 {
-  std::vector<const T *> particle_ptrs;
+  particle_ptrs.clear();
+  particle_ptrs.reserve(particles.size());
   for(const T & particle: particles)
   {
     particle_ptrs.push_back(&particle);
   }
+}
+
+/**
+ * @brief Auxiliary function to convert std::vector<Particle> to std::vector<const Particle*>, 
+ * @return std::vector of const pointers to particles in collection given as function argument
+ */
+template <typename T> 
+std::vector<const T*>
+convert_to_ptrs(const std::vector<T> & particles)
+{
+  std::vector<const T *> particle_ptrs;
+  convert_to_ptrs(particles, particle_ptrs);
   return particle_ptrs;
 }
 
@@ -0,0 +1,134 @@
+#ifndef TallinnNtupleProducer_Readers_preselect_h
+#define TallinnNtupleProducer_Readers_preselect_h
+
+#include <cmath>   // std::fabs()
+#include <cstddef> // std::size_t
+#include <cstdlib> // std::abs()
+#include <vector>  // std::vector
+
+/**
+ * @brief Kernels that apply cuts directly to the arrays of values that ROOT reads from the branches of a collection,
+ *        before the Reco* objects are constructed.
+ *
+ * Each kernel clears the flags of the objects that fail the cut and leaves the flags of all other objects unchanged,
+ * so that the flags are the logical AND of all cuts applied to them.
+ * The loops over the objects have neither function calls nor branches, so that the compiler can vectorize them.
+ * The values are compared in double precision and objects fail a cut only if the comparison made by the selectors fails,
+ * so that objects with NaN values are treated in the same way as by the selectors.
+ */
+template <typename T>
+inline void
+preselect_min(const T * __restrict__ values,
+              std::size_t numObjects,
+              double min_value,
+              unsigned char * __restrict__ passes)
+{
+  for(std::size_t idxObject = 0; idxObject < numObjects; ++idxObject)
+  {
+    passes[idxObject] &= ! (static_cast<double>(values[idxObject]) < min_value);
+  }
+}
+
+template <typename T>
+inline void
+preselect_maxAbs(const T * __restrict__ values,
+                 std::size_t numObjects,
+                 double max_absValue,
+                 unsigned char * __restrict__ passes)
+{
+  for(std::size_t idxObject = 0; idxObject < numObjects; ++idxObject)
+  {
+    passes[idxObject] &= ! (std::fabs(static_cast<double>(values[idxObject])) > max_absValue);
+  }
+}
+
+template <typename T>
+inline void
+preselect_equalAbs(const T * __restrict__ values,
+                   std::size_t numObjects,
+                   T absValue,
+                   unsigned char * __restrict__ passes)
+{
+  for(std::size_t idxObject = 0; idxObject < numObjects; ++idxObject)
+  {
+    passes[idxObject] &= std::abs(values[idxObject]) == absValue;
+  }
+}
+
+template <typename T>
+inline void
+preselect_true(const T * __restrict__ values,
+               std::size_t numObjects,
+               unsigned char * __restrict__ passes)
+{
+  for(std::size_t idxObject = 0; idxObject < numObjects; ++idxObject)
+  {
+    passes[idxObject] &= values[idxObject] != 0;
+  }
+}
+
+/**
+ * @brief Keep the objects whose value is in the whitelist given as function argument (no cut is applied if the whitelist is empty)
+ */
+template <typename T>
+inline void
+preselect_whitelist(const T * __restrict__ values,
+                    std::size_t numObjects,
+                    const std::vector<T> & whitelist,
+                    unsigned char * __restrict__ passes)
+{
+  if(whitelist.empty())
+  {
+    return;
+  }
+  for(std::size_t idxObject = 0; idxObject < numObjects; ++idxObject)
+  {
+    unsigned char isInWhitelist = 0;
+    for(const T & value: whitelist)
+    {
+      isInWhitelist |= values[idxObject] == value;
+    }
+    passes[idxObject] &= isInWhitelist;
+  }
+}
+
+/**
+ * @brief Drop the objects whose value is in the blacklist given as function argument
+ */
+template <typename T>
+inline void
+preselect_blacklist(const T * __restrict__ values,
+                    std::size_t numObjects,
+                    const std::vector<T> & blacklist,
+                    unsigned char * __restrict__ passes)
+{
+  for(const T & value: blacklist)
+  {
+    for(std::size_t idxObject = 0; idxObject < numObjects; ++idxObject)
+    {
+      passes[idxObject] &= values[idxObject] != value;
+    }
+  }
+}
+
+/**
+ * @brief Fill the indices of the objects that pass all cuts into the vector given as function argument, in increasing order
+ *       (the vector is overwritten, but keeps its capacity)
+ */
+inline void
+get_preselectedIdxs(const unsigned char * passes,
+                    std::size_t numObjects,
+                    std::vector<std::size_t> & preselectedIdxs)
+{
+  preselectedIdxs.resize(numObjects);
+  std::size_t numPreselected = 0;
+  for(std::size_t idxObject = 0; idxObject < numObjects; ++idxObject)
+  {
+    // CV: the index is always written, but only kept if the object passes
+    preselectedIdxs[numPreselected] = idxObject;
+    numPreselected += passes[idxObject];
+  }
+  preselectedIdxs.resize(numPreselected);
+}
+
+#endif // TallinnNtupleProducer_Readers_preselect_h
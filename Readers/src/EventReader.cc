@@ -5,9 +5,14 @@
 #include "TallinnNtupleProducer/CommonTools/interface/hadTauDefinitions.h"        // get_tau_id_wp_int()
 #include "TallinnNtupleProducer/CommonTools/interface/isHigherPt.h"               // isHigherPt()
 #include "TallinnNtupleProducer/CommonTools/interface/merge_systematic_shifts.h"  // merge_systematic_shifts()
+#include "TallinnNtupleProducer/CommonTools/interface/StageProfiler.h"            // PROFILE_SCOPE(), PROFILE_START(), PROFILE_STOP()
 #include "TallinnNtupleProducer/CommonTools/interface/sysUncertOptions.h"         // getHadTauPt_option(), getFatJet_option(), getJet_option(), getMET_option()
 #include "TallinnNtupleProducer/Readers/interface/convert_to_ptrs.h"              // convert_to_ptrs()
 
+#include "TTree.h"                                                                // TTree
+
+#include <algorithm>                                                              // std::min(), std::max()
+
 namespace
 {
   edm::ParameterSet
@@ -44,22 +49,26 @@ EventReader::EventReader(const edm::ParameterSet& cfg)
   , looseMuonSelector_(nullptr)
   , fakeableMuonSelector_(nullptr)
   , tightMuonSelector_(nullptr)
+  , muonTieredSelector_(nullptr)
   , electronReader_(nullptr)
   , electronCleaner_(nullptr)
   , looseElectronSelector_(nullptr)
   , fakeableElectronSelector_(nullptr)
   , tightElectronSelector_(nullptr)
+  , electronTieredSelector_(nullptr)
   , hadTauReader_(nullptr)
   , hadTauCleaner_(nullptr)
   , looseHadTauSelector_(nullptr)
   , fakeableHadTauSelector_(nullptr)
   , tightHadTauSelector_(nullptr)
+  , hadTauTieredSelector_(nullptr)
   , jetReaderAK4_(nullptr)
   , jetCleanerAK4_dR04_(nullptr)
   , jetCleanerAK4_dR12_(nullptr)
   , jetSelectorAK4_(nullptr)
   , jetSelectorAK4_btagLoose_(nullptr)
   , jetSelectorAK4_btagMedium_(nullptr)
+  , jetTieredSelectorAK4_(nullptr)
   , genLeptonReader_(nullptr)
   , genHadTauReader_(nullptr)
   , genPhotonReader_(nullptr)
@@ -76,16 +85,16 @@ EventReader::EventReader(const edm::ParameterSet& cfg)
   , metReader_(nullptr)
   , metFilterReader_(nullptr)
   , vertexReader_(nullptr)
+  , store_(nullptr)
+  , tree_(nullptr)
+  , genEntry_(-1)
   , isDEBUG_(cfg.getParameter<bool>("isDEBUG"))
 {
-std::cout << "break-point A.1 reached" << std::endl;
   numNominalLeptons_ = cfg.getParameter<unsigned>("numNominalLeptons");
   numNominalHadTaus_ = cfg.getParameter<unsigned>("numNominalHadTaus");
-std::cout << "break-point A.2 reached" << std::endl;
   era_ = get_era(cfg.getParameter<std::string>("era"));
   isMC_ = cfg.getParameter<bool>("isMC");
   readGenMatching_ = isMC_ && !cfg.getParameter<bool>("redoGenMatching");
-std::cout << "break-point A.3 reached" << std::endl;
   eventInfoReader_ = new EventInfoReader(cfg);
   const std::string apply_topPtReweighting_str = cfg.getParameter<std::string>("apply_topPtReweighting");
   const bool apply_topPtReweighting = ! apply_topPtReweighting_str.empty();
@@ -93,17 +102,15 @@ std::cout << "break-point A.3 reached" << std::endl;
   {
     eventInfoReader_->setTopPtRwgtBranchName(apply_topPtReweighting_str);
   }
-std::cout << "break-point A.4 reached" << std::endl;
   edm::ParameterSet cfg_triggers = cfg.getParameter<edm::ParameterSet>("triggers");
   triggerInfoReader_ = new TriggerInfoReader(cfg_triggers);
-std::cout << "break-point A.5 reached" << std::endl;
   muonReader_ = new RecoMuonReader(make_cfg(cfg, "branchName_muons"));
   const double lep_mva_cut_mu = cfg.getParameter<double>("lep_mva_cut_mu");
   muonReader_->set_mvaTTH_wp(lep_mva_cut_mu);
   looseMuonSelector_ = new RecoMuonCollectionSelectorLoose(era_, -1, isDEBUG_);
   fakeableMuonSelector_ = new RecoMuonCollectionSelectorFakeable(era_, -1, isDEBUG_);
   tightMuonSelector_ = new RecoMuonCollectionSelectorTight(era_, -1, isDEBUG_);
-std::cout << "break-point A.6 reached" << std::endl;
+  muonTieredSelector_ = new ParticleCollectionTieredSelector<RecoMuon>(true);
   electronReader_ = new RecoElectronReader(make_cfg(cfg, "branchName_electrons"));
   const double lep_mva_cut_e = cfg.getParameter<double>("lep_mva_cut_e");
   electronReader_->set_mvaTTH_wp(lep_mva_cut_e);
@@ -111,12 +118,13 @@ std::cout << "break-point A.6 reached" << std::endl;
   looseElectronSelector_ = new RecoElectronCollectionSelectorLoose(era_, -1, isDEBUG_);
   fakeableElectronSelector_ = new RecoElectronCollectionSelectorFakeable(era_, -1, isDEBUG_);
   tightElectronSelector_ = new RecoElectronCollectionSelectorTight(era_, -1, isDEBUG_);
-std::cout << "break-point A.7 reached" << std::endl;
+  electronTieredSelector_ = new ParticleCollectionTieredSelector<RecoElectron>(true);
   hadTauReader_ = new RecoHadTauReader(make_cfg(cfg, "branchName_hadTaus"));
   hadTauCleaner_ = new RecoHadTauCollectionCleaner(0.3, isDEBUG_);
   looseHadTauSelector_ = new RecoHadTauCollectionSelectorLoose(era_, -1, isDEBUG_);
   fakeableHadTauSelector_ = new RecoHadTauCollectionSelectorFakeable(era_, -1, isDEBUG_);
   tightHadTauSelector_ = new RecoHadTauCollectionSelectorTight(era_, -1, isDEBUG_);
+  hadTauTieredSelector_ = new ParticleCollectionTieredSelector<RecoHadTau>(true);
   std::string hadTauWP_againstJets_fakeable = cfg.getParameter<std::string>("hadTauWP_againstJets_fakeable");
   std::string hadTauWP_againstJets_tight = cfg.getParameter<std::string>("hadTauWP_againstJets_tight");
   if ( get_tau_id_wp_int(hadTauWP_againstJets_tight) <= get_tau_id_wp_int(hadTauWP_againstJets_fakeable) )
@@ -129,7 +137,6 @@ std::cout << "break-point A.7 reached" << std::endl;
   int hadTauWP_againstMuons = get_tau_id_wp_int(cfg.getParameter<std::string>("hadTauWP_againstMuons"));
   fakeableHadTauSelector_->set_min_antiMuon(hadTauWP_againstMuons);
   tightHadTauSelector_->set_min_antiMuon(hadTauWP_againstMuons);
-std::cout << "break-point A.8 reached" << std::endl;
   jetReaderAK4_ = new RecoJetReaderAK4(make_cfg(cfg, "branchName_jets_ak4"));
   bool jetCleaningByIndex = cfg.getParameter<bool>("jetCleaningByIndex");
   if ( jetCleaningByIndex )
@@ -144,7 +151,41 @@ std::cout << "break-point A.8 reached" << std::endl;
   jetSelectorAK4_ = new RecoJetCollectionSelectorAK4(era_, -1, isDEBUG_);
   jetSelectorAK4_btagLoose_ = new RecoJetCollectionSelectorAK4_btagLoose(era_, -1, isDEBUG_);
   jetSelectorAK4_btagMedium_ = new RecoJetCollectionSelectorAK4_btagMedium(era_, -1, isDEBUG_);
-std::cout << "break-point A.9 reached" << std::endl;
+  // CV: the b-tag selectors apply the jet selection themselves, so the tiers are evaluated independently of each other
+  jetTieredSelectorAK4_ = new ParticleCollectionTieredSelector<RecoJetAK4>(false);
+  // CV: skip the objects that fail the loosest selection applied to them already in the readers, before the objects are constructed;
+  //     the preselection is not applied in debug mode, so that the selectors print the reason for rejecting each object
+  if ( ! isDEBUG_ )
+  {
+    const RecoMuonSelectorLoose & looseMuonSelector = looseMuonSelector_->getSelector();
+    muonReader_->set_preselection(
+      looseMuonSelector.get_min_pt(), looseMuonSelector.get_max_absEta(), looseMuonSelector.get_max_dxy(), looseMuonSelector.get_max_dz()
+    );
+    const RecoElectronSelectorLoose & looseElectronSelector = looseElectronSelector_->getSelector();
+    electronReader_->set_preselection(
+      looseElectronSelector.get_min_pt(), looseElectronSelector.get_max_absEta(), looseElectronSelector.get_max_dxy(), looseElectronSelector.get_max_dz()
+    );
+    const RecoHadTauSelectorFakeable & fakeableHadTauSelector = fakeableHadTauSelector_->getSelector();
+    hadTauReader_->set_preselection(
+      fakeableHadTauSelector.get_min_pt(), fakeableHadTauSelector.get_max_absEta(), fakeableHadTauSelector.get_max_dz(),
+      fakeableHadTauSelector.get_apply_decayModeFinding(), fakeableHadTauSelector.get_decayMode_whitelist(), fakeableHadTauSelector.get_decayMode_blacklist()
+    );
+    // CV: as a jet is kept if it passes any of the jet and b-tag selections, the cuts of the jet preselection are the loosest of the three
+    const std::vector<const RecoJetSelectorAK4 *> jetSelectorsAK4 = {
+      &jetSelectorAK4_->getSelector(), &jetSelectorAK4_btagLoose_->getSelector(), &jetSelectorAK4_btagMedium_->getSelector()
+    };
+    double jet_min_pt = jetSelectorsAK4.front()->get_min_pt();
+    double jet_max_absEta = jetSelectorsAK4.front()->get_max_absEta();
+    int jet_min_jetId = jetSelectorsAK4.front()->get_min_jetId();
+    for ( const RecoJetSelectorAK4 * jetSelector : jetSelectorsAK4 )
+    {
+      jet_min_pt = std::min(jet_min_pt, jetSelector->get_min_pt());
+      // CV: a cut on abs(eta) that is not positive is not applied by the selector
+      jet_max_absEta = jet_max_absEta > 0. && jetSelector->get_max_absEta() > 0. ? std::max(jet_max_absEta, jetSelector->get_max_absEta()) : -1.;
+      jet_min_jetId = std::min(jet_min_jetId, jetSelector->get_min_jetId());
+    }
+    jetReaderAK4_->set_preselection(jet_min_pt, jet_max_absEta, jet_min_jetId);
+  }
   if ( readGenMatching_ )
   {
     genLeptonReader_ = new GenLeptonReader(make_cfg(cfg, "branchName_genLeptons"));
@@ -156,18 +197,15 @@ std::cout << "break-point A.9 reached" << std::endl;
     hadTauGenMatcher_ = new RecoHadTauCollectionGenMatcher();
     jetGenMatcherAK4_ = new RecoJetCollectionGenMatcherAK4();
   }
-std::cout << "break-point A.10 reached" << std::endl;
   jetReaderAK8_Hbb_ = new RecoJetReaderAK8(make_cfg_jetsAK8(cfg, "branchName_jets_ak8_Hbb", "branchName_subjets_ak8_Hbb"));
   jetReaderAK8_Wjj_ = new RecoJetReaderAK8(make_cfg_jetsAK8(cfg, "branchName_jets_ak8_Wjj", "branchName_subjets_ak8_Wjj"));
   jetCleanerAK8_dR08_ = new RecoJetCollectionCleanerAK8(0.8, isDEBUG_);
   jetSelectorAK8_Hbb_ = new RecoJetCollectionSelectorAK8_Hbb(era_, -1, isDEBUG_);
   jetSelectorAK8_Wjj_ = new RecoJetCollectionSelectorAK8_Wjj(era_, -1, isDEBUG_);
-std::cout << "break-point A.11 reached" << std::endl;
   metReader_ = new RecoMEtReader(make_cfg(cfg, "branchName_met"));
   metFilterReader_ = new MEtFilterReader(cfg);
-std::cout << "break-point A.12 reached" << std::endl;
   vertexReader_ = new RecoVertexReader(make_cfg(cfg, "branchName_vertex"));
-std::cout << "break-point A.13 reached" << std::endl;
+  store_ = new EventStore();
 }
 
 EventReader::~EventReader()
@@ -176,22 +214,26 @@ EventReader::~EventReader()
   delete looseMuonSelector_;
   delete fakeableMuonSelector_;
   delete tightMuonSelector_;
+  delete muonTieredSelector_;
   delete electronReader_;
   delete electronCleaner_;
   delete looseElectronSelector_;
   delete fakeableElectronSelector_;
   delete tightElectronSelector_;
+  delete electronTieredSelector_;
   delete hadTauReader_;
   delete hadTauCleaner_;
   delete looseHadTauSelector_;
   delete fakeableHadTauSelector_;
   delete tightHadTauSelector_;
+  delete hadTauTieredSelector_;
   delete jetReaderAK4_;
   delete jetCleanerAK4_dR04_;
   delete jetCleanerAK4_dR12_;
   delete jetSelectorAK4_;
   delete jetSelectorAK4_btagLoose_;
   delete jetSelectorAK4_btagMedium_;
+  delete jetTieredSelectorAK4_;
   delete genLeptonReader_;
   delete genHadTauReader_;
   delete genPhotonReader_;
@@ -208,6 +250,7 @@ EventReader::~EventReader()
   delete metReader_;
   delete metFilterReader_;
   delete vertexReader_;
+  delete store_;
 }
 
 void
@@ -222,53 +265,122 @@ EventReader::set_central_or_shift(const std::string& central_or_shift)
   {
     // CV: electron energy scale uncertainty not implemented yet 
   }
-  if ( contains(hadTauReader_->get_supported_systematics(), central_or_shift) )
-  {
-    const int hadTauPt_option = getHadTauPt_option(central_or_shift);
-    hadTauReader_->setHadTauPt_central_or_shift(hadTauPt_option);
-  }
-  if ( contains(jetReaderAK4_->get_supported_systematics(), central_or_shift) )
+  set_readerOptions(get_readerOptions(central_or_shift));
+}
+
+void
+EventReader::set_central_or_shift(const SysId & sysId)
+{
+  eventInfoReader_->set_central_or_shift(sysId.central_or_shift);
+  if ( sysId.idx >= readerOptions_.size() )
   {
-    const int jetPt_option = getJet_option(central_or_shift, isMC_);
-    jetReaderAK4_->setPtMass_central_or_shift(jetPt_option);
-    jetReaderAK4_->read_btag_systematics(central_or_shift != "central" && isMC_);
+    readerOptions_.resize(sysId.idx + 1);
+    readerOptions_isInitialized_.resize(sysId.idx + 1, false);
   }
-  if ( contains(jetReaderAK8_Hbb_->get_supported_systematics(), central_or_shift) )
+  if ( !readerOptions_isInitialized_[sysId.idx] )
   {
-    const int fatJetPt_option = getFatJet_option(central_or_shift, isMC_);
-    jetReaderAK8_Hbb_->set_central_or_shift(fatJetPt_option);
+    // CV: the options of the reader classes cannot be taken from the SysId directly,
+    //     as the systematic shifts supported by the individual reader classes differ from those accepted by the get*_option functions
+    readerOptions_[sysId.idx] = get_readerOptions(sysId.central_or_shift);
+    readerOptions_isInitialized_[sysId.idx] = true;
   }
-  if ( contains(jetReaderAK8_Wjj_->get_supported_systematics(), central_or_shift) )
+  set_readerOptions(readerOptions_[sysId.idx]);
+}
+
+EventReader::ReaderOptions
+EventReader::get_readerOptions(const std::string & central_or_shift) const
+{
+  // CV: reset reader classes to their central value in case the systematic shift is not supported by them,
+  //     as otherwise the systematic shift set for the previous call would still be applied
+  //     when looping over all systematic shifts for the same event
+  ReaderOptions readerOptions;
+  const bool isHadTauPt_shift = contains(hadTauReader_->get_supported_systematics(), central_or_shift);
+  readerOptions.hadTauPt_option_ = getHadTauPt_option(isHadTauPt_shift ? central_or_shift : "central");
+  const bool isJetPt_shift = contains(jetReaderAK4_->get_supported_systematics(), central_or_shift);
+  readerOptions.jetPt_option_ = getJet_option(isJetPt_shift ? central_or_shift : "central", isMC_);
+  readerOptions.read_btag_systematics_ = isJetPt_shift && central_or_shift != "central" && isMC_;
+  const bool isFatJetPt_shift_Hbb = contains(jetReaderAK8_Hbb_->get_supported_systematics(), central_or_shift);
+  readerOptions.fatJetPt_option_Hbb_ = getFatJet_option(isFatJetPt_shift_Hbb ? central_or_shift : "central", isMC_);
+  const bool isFatJetPt_shift_Wjj = contains(jetReaderAK8_Wjj_->get_supported_systematics(), central_or_shift);
+  readerOptions.fatJetPt_option_Wjj_ = getFatJet_option(isFatJetPt_shift_Wjj ? central_or_shift : "central", isMC_);
+  const bool isMEt_shift = contains(metReader_->get_supported_systematics(), central_or_shift);
+  readerOptions.met_option_ = getMET_option(isMEt_shift ? central_or_shift : "central", isMC_);
+  return readerOptions;
+}
+
+void
+EventReader::set_readerOptions(const ReaderOptions & readerOptions)
+{
+  hadTauReader_->setHadTauPt_central_or_shift(readerOptions.hadTauPt_option_);
+  jetReaderAK4_->setPtMass_central_or_shift(readerOptions.jetPt_option_);
+  jetReaderAK4_->read_btag_systematics(readerOptions.read_btag_systematics_);
+  jetReaderAK8_Hbb_->set_central_or_shift(readerOptions.fatJetPt_option_Hbb_);
+  jetReaderAK8_Wjj_->set_central_or_shift(readerOptions.fatJetPt_option_Wjj_);
+  metReader_->setMEt_central_or_shift(readerOptions.met_option_);
+}
+
+void
+EventReader::read_systematics(bool flag)
+{
+  if ( !isMC_ )
   {
-    const int fatJetPt_option = getFatJet_option(central_or_shift, isMC_);
-    jetReaderAK8_Wjj_->set_central_or_shift(fatJetPt_option);
+    return;
   }
-  if ( contains(metReader_->get_supported_systematics(), central_or_shift) )
+  jetReaderAK4_->read_ptMass_systematics(flag);
+  jetReaderAK4_->read_btag_systematics(flag);
+  jetReaderAK8_Hbb_->read_sys(flag);
+  jetReaderAK8_Wjj_->read_sys(flag);
+  metReader_->read_ptPhi_systematics(flag);
+}
+
+std::vector<std::string>
+EventReader::setBranchAddresses(TTree * tree)
+{
+  std::vector<std::string> bound_branches;
+  for(ReaderBase * reader: std::vector<ReaderBase *>({
+        eventInfoReader_,
+        triggerInfoReader_,
+        muonReader_,
+        electronReader_,
+        hadTauReader_,
+        jetReaderAK4_,
+        genLeptonReader_,
+        genHadTauReader_,
+        genPhotonReader_,
+        genJetReader_,
+        jetReaderAK8_Hbb_,
+        jetReaderAK8_Wjj_,
+        metReader_,
+        metFilterReader_,
+        vertexReader_
+      }))
   {
-    const int met_option = getMET_option(central_or_shift, isMC_);
-    metReader_->setMEt_central_or_shift(met_option);
+    const std::vector<std::string> reader_branches = reader->setBranchAddresses(tree);
+    bound_branches.insert(bound_branches.end(), reader_branches.begin(), reader_branches.end());
   }
+  // CV: the entry numbers restart at zero for each input file, so the cached gen-level information must not be used for the new file
+  tree_ = tree;
+  genEntry_ = -1;
+  return bound_branches;
 }
 
 std::vector<std::string>
-EventReader::setBranchAddresses(TTree * tree)
+EventReader::get_preselectionBranchNames() const
+{
+  return { muonReader_->getBranchName_num(), electronReader_->getBranchName_num(), hadTauReader_->getBranchName_num() };
+}
+
+bool
+EventReader::passesPreselection() const
 {
-  eventInfoReader_->setBranchAddresses(tree);
-  triggerInfoReader_->setBranchAddresses(tree);
-  muonReader_->setBranchAddresses(tree);
-  electronReader_->setBranchAddresses(tree);
-  hadTauReader_->setBranchAddresses(tree);
-  jetReaderAK4_->setBranchAddresses(tree);
-  genLeptonReader_->setBranchAddresses(tree);
-  genHadTauReader_->setBranchAddresses(tree);
-  genPhotonReader_->setBranchAddresses(tree);
-  genJetReader_->setBranchAddresses(tree);
-  jetReaderAK8_Hbb_->setBranchAddresses(tree);
-  jetReaderAK8_Wjj_->setBranchAddresses(tree);
-  metReader_->setBranchAddresses(tree);
-  metFilterReader_->setBranchAddresses(tree);
-  vertexReader_->setBranchAddresses(tree);
-  return {};
+  return muonReader_->get_num() + electronReader_->get_num() >= numNominalLeptons_ && hadTauReader_->get_num() >= numNominalHadTaus_;
+}
+
+const EventInfo &
+EventReader::read_eventInfo() const
+{
+  PROFILE_SCOPE("EventInfoReader");
+  return eventInfoReader_->read();
 }
 
 namespace
@@ -286,183 +398,188 @@ namespace
   }
 
   /**
-   * @brief Return first N objects from collection given as function argument. In case the input
-   *        collection contains fewer than N objects, the whole input collection is returned
-   */
-  template <typename T>
-  std::vector<T>
-  pickFirstNobjects(const std::vector<T> & objects_input,
-                    std::size_t N)
-  {
-    const std::size_t N_input = std::min(objects_input.size(), N);
-    std::vector<T> objects_output;
-    std::copy_n(objects_input.begin(), N_input, std::back_inserter(objects_output));
-    return objects_output;
-  }
-
-  /**
-   * @brief Compute subset of particles contained in "lhs" as well as in "rhs" collection.
-   *       (in the typical use-case "lhs" = fakeableLeptonsFull/fakeableHadTausFull and "rhs" = tightLeptons/tightHadTaus)
-   */
-  template <typename T,
-            typename U,
-            typename F>
-  std::vector<T>
-  getIntersection(const std::vector<T> & lhs_collection,
-                  const std::vector<U> & rhs_collection,
-                  bool (*sortFunction)(const F *, const F *))
-  {
-    std::vector<T> output_collection;
-    for(const T & lhs_element: lhs_collection)
-    {
-      for(const U & rhs_element: rhs_collection)
-      {
-        if(lhs_element == rhs_element)
-        {
-          output_collection.push_back(lhs_element);
-        }
-      }
-    }
-    std::sort(output_collection.begin(), output_collection.end(), sortFunction);
-    return output_collection;
-  }
-
-  /**
-   * @brief Build collection of selected leptons by merging collections of selected electrons and selected muons
+   * @brief Bits of the masks of TieredParticleCollection, in the order in which the selectors are passed to ParticleCollectionTieredSelector
    */
-  std::vector<const RecoLepton *>
-  mergeLeptonCollectionsNoSort(const std::vector<const RecoElectron *> & electrons,
-                               const std::vector<const RecoMuon *> & muons)
-  {
-    std::vector<const RecoLepton *> leptons;
-    const std::size_t nLeptons = electrons.size() + muons.size();
-    if(nLeptons > 0)
-    {
-      leptons.reserve(nLeptons);
-      leptons.insert(leptons.end(), electrons.begin(), electrons.end());
-      leptons.insert(leptons.end(), muons.begin(), muons.end());
-    }
-    return leptons;
-  }
-
-  template <typename T>
-  std::vector<const RecoLepton *>
-  mergeLeptonCollections(const std::vector<const RecoElectron *> & electrons,
-                         const std::vector<const RecoMuon *> & muons,
-                         bool (*sortFunction)(const T *, const T *))
-  {
-    std::vector<const RecoLepton *> leptons = mergeLeptonCollectionsNoSort(electrons, muons);
-    std::sort(leptons.begin(), leptons.end(), sortFunction);
-    return leptons;
-  }
+  enum { kLepton_loose, kLepton_fakeable, kLepton_tight };
+  enum { kHadTau_fakeable, kHadTau_tight };
+  enum { kJetAK4, kJetAK4_btagLoose, kJetAK4_btagMedium };
 }
 
 Event
 EventReader::read() const
 {
-std::cout << "break-point B.1 reached" << std::endl;
+  PROFILE_SCOPE("EventReader::read");
+  PROFILE_START(timer_eventInfo, "EventInfoReader");
   const EventInfo& eventInfo = eventInfoReader_->read();
-std::cout << "break-point B.2 reached" << std::endl;
+  PROFILE_STOP(timer_eventInfo);
+  PROFILE_START(timer_triggerInfo, "TriggerInfoReader");
   const TriggerInfo& triggerInfo = triggerInfoReader_->read();
-std::cout << "break-point B.3 reached" << std::endl;
+  PROFILE_STOP(timer_triggerInfo);
   Event event(eventInfo, triggerInfo);
-std::cout << "break-point B.4 reached" << std::endl;
-  RecoMuonCollection muons = muonReader_->read();
-  RecoMuonPtrCollection muon_ptrs = convert_to_ptrs(muons);
-  RecoMuonPtrCollection cleanedMuons = muon_ptrs; // CV: no cleaning needed for muons, as they have the highest priority in the overlap removal
-  event.looseMuons_ = looseMuonSelector_->operator()(cleanedMuons, isHigherConePt<RecoMuon>);
-  RecoMuonPtrCollection fakeableMuonsFull = fakeableMuonSelector_->operator()(event.looseMuons_, isHigherConePt<RecoMuon>);
-  RecoMuonPtrCollection tightMuonsFull = tightMuonSelector_->operator()(fakeableMuonsFull, isHigherConePt<RecoMuon>);
-  event.fakeableMuons_ = pickFirstNobjects(fakeableMuonsFull, numNominalLeptons_);
-  event.tightMuons_ = getIntersection(event.fakeableMuons_, tightMuonsFull, isHigherConePt<RecoMuon>);
-std::cout << "break-point B.5 reached" << std::endl;
-  RecoElectronCollection electrons = electronReader_->read();
-  RecoElectronPtrCollection electron_ptrs = convert_to_ptrs(electrons);
-  RecoElectronPtrCollection cleanedElectrons = electronCleaner_->operator()(electron_ptrs, event.looseMuons_);
-  event.looseElectrons_ = looseElectronSelector_->operator()(cleanedElectrons, isHigherConePt<RecoElectron>);
-  RecoElectronPtrCollection fakeableElectronsFull = fakeableElectronSelector_->operator()(event.looseElectrons_, isHigherConePt<RecoElectron>);
-  RecoElectronPtrCollection tightElectronsFull = tightElectronSelector_->operator()(fakeableElectronsFull, isHigherConePt<RecoElectron>);
-  event.fakeableElectrons_ = pickFirstNobjects(fakeableElectronsFull, numNominalLeptons_);
-  event.tightElectrons_ = getIntersection(event.fakeableElectrons_, tightElectronsFull, isHigherConePt<RecoElectron>);
-std::cout << "break-point B.6 reached" << std::endl;
-  event.looseLeptons_ = mergeLeptonCollections(event.looseElectrons_, event.looseMuons_, isHigherConePt<RecoLepton>);
-  RecoLeptonPtrCollection fakeableLeptonsFull = mergeLeptonCollections(fakeableElectronsFull, fakeableMuonsFull, isHigherConePt<RecoLepton>);
-  RecoLeptonPtrCollection tightLeptonsFull = mergeLeptonCollections(tightElectronsFull, tightMuonsFull, isHigherConePt<RecoLepton>);
-  event.fakeableLeptons_ = pickFirstNobjects(fakeableLeptonsFull, numNominalLeptons_);
-  event.tightLeptons_ = getIntersection(event.fakeableLeptons_, tightLeptonsFull, isHigherConePt<RecoLepton>);
-std::cout << "break-point B.7 reached" << std::endl;
-  RecoHadTauCollection hadTaus = hadTauReader_->read();
-  RecoHadTauPtrCollection hadTau_ptrs = convert_to_ptrs(hadTaus);
-  RecoHadTauPtrCollection cleanedHadTaus = hadTauCleaner_->operator()(hadTau_ptrs, event.looseMuons_, event.looseElectrons_);
-  RecoHadTauPtrCollection fakeableHadTausFull = fakeableHadTauSelector_->operator()(cleanedHadTaus, isHigherPt<RecoHadTau>);
-  RecoHadTauPtrCollection tightHadTausFull = tightHadTauSelector_->operator()(fakeableHadTausFull, isHigherPt<RecoHadTau>);
-  event.fakeableHadTaus_ = pickFirstNobjects(fakeableHadTausFull, numNominalHadTaus_);
-  event.tightHadTaus_ = getIntersection(event.fakeableHadTaus_, tightHadTausFull, isHigherPt<RecoHadTau>);
-std::cout << "break-point B.8 reached" << std::endl;
-  RecoJetCollectionAK4 jetsAK4 = jetReaderAK4_->read();
-  RecoJetPtrCollectionAK4 jet_ptrsAK4 = convert_to_ptrs(jetsAK4);
-  RecoJetPtrCollectionAK4 cleanedJetsAK4 = jetCleanerAK4_dR04_->operator()(jet_ptrsAK4, event.fakeableLeptons_, event.fakeableHadTaus_);
-  event.selJetsAK4_ = jetSelectorAK4_->operator()(cleanedJetsAK4, isHigherPt<RecoJetAK4>);
-  event.selJetsAK4_btagLoose_ = jetSelectorAK4_btagLoose_->operator()(cleanedJetsAK4, isHigherPt<RecoJetAK4>);
-  event.selJetsAK4_btagMedium_ = jetSelectorAK4_btagMedium_->operator()(cleanedJetsAK4, isHigherPt<RecoJetAK4>);
-std::cout << "break-point B.9 reached" << std::endl;
+  // CV: the reconstructed objects of the previous call are released here,
+  //     so the Event object returned by the previous call must not be used anymore
+  store_->clear();
+
+  PROFILE_START(timer_muonReader, "RecoMuonReader");
+  muonReader_->read(store_->muons_);
+  convert_to_ptrs(store_->muons_, store_->muon_ptrs_);
+  PROFILE_STOP(timer_muonReader);
+  PROFILE_START(timer_muonSelectors, "RecoMuonCollectionSelectors");
+  const RecoMuonPtrCollection & cleanedMuons = store_->muon_ptrs_; // CV: no cleaning needed for muons, as they have the highest priority in the overlap removal
+  muonTieredSelector_->operator()(cleanedMuons, isHigherConePt<RecoMuon>, store_->selMuons_, *looseMuonSelector_, *fakeableMuonSelector_, *tightMuonSelector_);
+  event.looseMuons_ = &store_->selMuons_.get(kLepton_loose);
+  event.fakeableMuons_ = &store_->selMuons_.get(kLepton_fakeable, numNominalLeptons_, kLepton_fakeable);
+  event.tightMuons_ = &store_->selMuons_.get(kLepton_tight, numNominalLeptons_, kLepton_fakeable);
+  PROFILE_STOP(timer_muonSelectors);
+
+  PROFILE_START(timer_electronReader, "RecoElectronReader");
+  electronReader_->read(store_->electrons_);
+  convert_to_ptrs(store_->electrons_, store_->electron_ptrs_);
+  PROFILE_STOP(timer_electronReader);
+  PROFILE_START(timer_electronCleaner, "RecoElectronCollectionCleaner");
+  const RecoElectronPtrCollection & cleanedElectrons = store_->cleanedElectrons_;
+  electronCleaner_->clean(store_->electron_ptrs_, store_->cleanedElectrons_, *event.looseMuons_);
+  PROFILE_STOP(timer_electronCleaner);
+  PROFILE_START(timer_electronSelectors, "RecoElectronCollectionSelectors");
+  electronTieredSelector_->operator()(cleanedElectrons, isHigherConePt<RecoElectron>, store_->selElectrons_, *looseElectronSelector_, *fakeableElectronSelector_, *tightElectronSelector_);
+  event.looseElectrons_ = &store_->selElectrons_.get(kLepton_loose);
+  event.fakeableElectrons_ = &store_->selElectrons_.get(kLepton_fakeable, numNominalLeptons_, kLepton_fakeable);
+  event.tightElectrons_ = &store_->selElectrons_.get(kLepton_tight, numNominalLeptons_, kLepton_fakeable);
+  PROFILE_STOP(timer_electronSelectors);
+
+  PROFILE_START(timer_leptonMerging, "RecoLeptonCollectionMerging");
+  store_->selLeptons_.merge(store_->selElectrons_, store_->selMuons_, isHigherConePt<RecoLepton>);
+  event.looseLeptons_ = &store_->selLeptons_.get(kLepton_loose);
+  event.fakeableLeptons_ = &store_->selLeptons_.get(kLepton_fakeable, numNominalLeptons_, kLepton_fakeable);
+  event.tightLeptons_ = &store_->selLeptons_.get(kLepton_tight, numNominalLeptons_, kLepton_fakeable);
+  PROFILE_STOP(timer_leptonMerging);
+
+  PROFILE_START(timer_hadTauReader, "RecoHadTauReader");
+  hadTauReader_->read(store_->hadTaus_);
+  convert_to_ptrs(store_->hadTaus_, store_->hadTau_ptrs_);
+  PROFILE_STOP(timer_hadTauReader);
+  PROFILE_START(timer_hadTauCleaner, "RecoHadTauCollectionCleaner");
+  const RecoHadTauPtrCollection & cleanedHadTaus = store_->cleanedHadTaus_;
+  hadTauCleaner_->clean(store_->hadTau_ptrs_, store_->cleanedHadTaus_, *event.looseMuons_, *event.looseElectrons_);
+  PROFILE_STOP(timer_hadTauCleaner);
+  PROFILE_START(timer_hadTauSelectors, "RecoHadTauCollectionSelectors");
+  hadTauTieredSelector_->operator()(cleanedHadTaus, isHigherPt<RecoHadTau>, store_->selHadTaus_, *fakeableHadTauSelector_, *tightHadTauSelector_);
+  event.fakeableHadTaus_ = &store_->selHadTaus_.get(kHadTau_fakeable, numNominalHadTaus_, kHadTau_fakeable);
+  event.tightHadTaus_ = &store_->selHadTaus_.get(kHadTau_tight, numNominalHadTaus_, kHadTau_fakeable);
+  PROFILE_STOP(timer_hadTauSelectors);
+
+  PROFILE_START(timer_jetReaderAK4, "RecoJetReaderAK4");
+  jetReaderAK4_->read(store_->jetsAK4_);
+  convert_to_ptrs(store_->jetsAK4_, store_->jet_ptrsAK4_);
+  PROFILE_STOP(timer_jetReaderAK4);
+  PROFILE_START(timer_jetCleanerAK4, "RecoJetCollectionCleanerAK4");
+  const RecoJetPtrCollectionAK4 & cleanedJetsAK4 = store_->cleanedJetsAK4_;
+  jetCleanerAK4_dR04_->clean(store_->jet_ptrsAK4_, store_->cleanedJetsAK4_, *event.fakeableLeptons_, *event.fakeableHadTaus_);
+  PROFILE_STOP(timer_jetCleanerAK4);
+  PROFILE_START(timer_jetSelectorsAK4, "RecoJetCollectionSelectorsAK4");
+  jetTieredSelectorAK4_->operator()(cleanedJetsAK4, isHigherPt<RecoJetAK4>, store_->selJetsAK4_, *jetSelectorAK4_, *jetSelectorAK4_btagLoose_, *jetSelectorAK4_btagMedium_);
+  event.selJetsAK4_ = &store_->selJetsAK4_.get(kJetAK4);
+  event.selJetsAK4_btagLoose_ = &store_->selJetsAK4_.get(kJetAK4_btagLoose);
+  event.selJetsAK4_btagMedium_ = &store_->selJetsAK4_.get(kJetAK4_btagMedium);
+  PROFILE_STOP(timer_jetSelectorsAK4);
+
   if ( readGenMatching_ )
   {
-    std::vector<GenLepton> genLeptons = genLeptonReader_->read();
-    std::vector<GenLepton> genElectrons;
-    std::vector<GenLepton> genMuons;
-    for ( auto genLepton : genLeptons )
+    // CV: the gen-level particles do not depend on the systematic shift,
+    //     so they are read and indexed only once per entry and shared by all systematic shifts
+    assert(tree_);
+    const long long entry = tree_->GetReadEntry();
+    if ( entry != genEntry_ )
     {
-      const int abs_pdgId = std::abs(genLepton.pdgId());
-      switch ( abs_pdgId )
+      PROFILE_START(timer_genReaders, "GenParticleReaders");
+      store_->clear_gen();
+      genLeptonReader_->read(store_->genLeptons_);
+      for ( const GenLepton & genLepton : store_->genLeptons_ )
       {
-        case 11: genElectrons.push_back(genLepton); break;
-        case 13: genMuons.push_back(genLepton);     break;
-        default: assert(0);
+        const int abs_pdgId = std::abs(genLepton.pdgId());
+        switch ( abs_pdgId )
+        {
+          case 11: store_->genElectrons_.push_back(genLepton); break;
+          case 13: store_->genMuons_.push_back(genLepton);     break;
+          default: assert(0);
+        }
       }
+      genHadTauReader_->read(store_->genHadTaus_);
+      genPhotonReader_->read(store_->genPhotons_);
+      genJetReader_->read(store_->genJets_);
+      PROFILE_STOP(timer_genReaders);
+
+      PROFILE_SCOPE("GenParticleIndexes");
+      // CV: each gen particle collection is indexed once per entry,
+      //     and the same index is used for matching all collections of reconstructed particles to it
+      store_->genLeptonIndex_.build(store_->genLeptons_);
+      store_->genElectronIndex_.build(store_->genElectrons_);
+      store_->genMuonIndex_.build(store_->genMuons_);
+      store_->genHadTauIndex_.build(store_->genHadTaus_);
+      store_->genPhotonIndex_.build(store_->genPhotons_);
+      store_->genJetIndex_.build(store_->genJets_);
+      genEntry_ = entry;
     }
-    std::vector<GenHadTau> genHadTaus = genHadTauReader_->read();
-    std::vector<GenPhoton> genPhotons = genPhotonReader_->read();
-    std::vector<GenJet> genJets = genJetReader_->read();
 
-    muonGenMatcher_->addGenLeptonMatch(event.looseMuons_, genMuons);
-    muonGenMatcher_->addGenHadTauMatch(event.looseMuons_, genHadTaus);
-    muonGenMatcher_->addGenJetMatch(event.looseMuons_, genJets);
+    PROFILE_SCOPE("ParticleCollectionGenMatchers");
+    const GenParticleIndex<GenLepton> & genLeptonIndex = store_->genLeptonIndex_;
+    const GenParticleIndex<GenLepton> & genElectronIndex = store_->genElectronIndex_;
+    const GenParticleIndex<GenLepton> & genMuonIndex = store_->genMuonIndex_;
+    const GenParticleIndex<GenHadTau> & genHadTauIndex = store_->genHadTauIndex_;
+    const GenParticleIndex<GenPhoton> & genPhotonIndex = store_->genPhotonIndex_;
+    const GenParticleIndex<GenJet> & genJetIndex = store_->genJetIndex_;
+
+    muonGenMatcher_->addGenLeptonMatch(*event.looseMuons_, genMuonIndex);
+    muonGenMatcher_->addGenHadTauMatch(*event.looseMuons_, genHadTauIndex);
+    muonGenMatcher_->addGenJetMatch(*event.looseMuons_, genJetIndex);
 
-    electronGenMatcher_->addGenLeptonMatch(event.looseElectrons_ , genElectrons);
-    electronGenMatcher_->addGenPhotonMatch(event.looseElectrons_ , genPhotons);
-    electronGenMatcher_->addGenHadTauMatch(event.looseElectrons_ , genHadTaus);
-    electronGenMatcher_->addGenJetMatch(event.looseElectrons_ , genJets);
+    electronGenMatcher_->addGenLeptonMatch(*event.looseElectrons_ , genElectronIndex);
+    electronGenMatcher_->addGenPhotonMatch(*event.looseElectrons_ , genPhotonIndex);
+    electronGenMatcher_->addGenHadTauMatch(*event.looseElectrons_ , genHadTauIndex);
+    electronGenMatcher_->addGenJetMatch(*event.looseElectrons_ , genJetIndex);
 
-    hadTauGenMatcher_->addGenLeptonMatch(event.fakeableHadTaus_, genLeptons);
-    hadTauGenMatcher_->addGenHadTauMatch(event.fakeableHadTaus_, genHadTaus);
-    hadTauGenMatcher_->addGenJetMatch(event.fakeableHadTaus_, genJets);
+    hadTauGenMatcher_->addGenLeptonMatch(*event.fakeableHadTaus_, genLeptonIndex);
+    hadTauGenMatcher_->addGenHadTauMatch(*event.fakeableHadTaus_, genHadTauIndex);
+    hadTauGenMatcher_->addGenJetMatch(*event.fakeableHadTaus_, genJetIndex);
 
     // CV: performing the gen-matching on the cleanedJetsAK4 collection
     //     adds gen-matching information to three collections of AK4 jets at once (selJetsAK4, selJetsAK4_btagLoose, selJetsAK4_btagMedium)
-    jetGenMatcherAK4_->addGenLeptonMatch(cleanedJetsAK4, genLeptons);
-    jetGenMatcherAK4_->addGenHadTauMatch(cleanedJetsAK4, genHadTaus);
-    jetGenMatcherAK4_->addGenJetMatch(cleanedJetsAK4, genJets);
+    jetGenMatcherAK4_->addGenLeptonMatch(cleanedJetsAK4, genLeptonIndex);
+    jetGenMatcherAK4_->addGenHadTauMatch(cleanedJetsAK4, genHadTauIndex);
+    jetGenMatcherAK4_->addGenJetMatch(cleanedJetsAK4, genJetIndex);
   }
-std::cout << "break-point B.10 reached" << std::endl;
-  RecoJetCollectionAK8 jetsAK8_Hbb = jetReaderAK8_Hbb_->read();
-  RecoJetPtrCollectionAK8 jet_ptrsAK8_Hbb = convert_to_ptrs(jetsAK8_Hbb);
+
+  PROFILE_START(timer_jetReaderAK8, "RecoJetReaderAK8");
+  jetReaderAK8_Hbb_->read(store_->jetsAK8_Hbb_);
+  convert_to_ptrs(store_->jetsAK8_Hbb_, store_->jet_ptrsAK8_Hbb_);
+  jetReaderAK8_Wjj_->read(store_->jetsAK8_Wjj_);
+  convert_to_ptrs(store_->jetsAK8_Wjj_, store_->jet_ptrsAK8_Wjj_);
+  PROFILE_STOP(timer_jetReaderAK8);
+  PROFILE_START(timer_jetCleanerAK8, "RecoJetCollectionCleanerAK8");
   // CV: clean AK8_Hbb jets wrt leptons only (not wrt hadronic taus)
-  RecoJetPtrCollectionAK8 cleanedJetsAK8_Hbb = jetCleanerAK8_dR08_->operator()(jet_ptrsAK8_Hbb, event.fakeableLeptons_);
-  event.selJetsAK8_Hbb_ = jetSelectorAK8_Hbb_->operator()(cleanedJetsAK8_Hbb, isHigherPt<RecoJetAK8>);
-  RecoJetCollectionAK8 jetsAK8_Wjj = jetReaderAK8_Wjj_->read();
-  RecoJetPtrCollectionAK8 jet_ptrsAK8_Wjj = convert_to_ptrs(jetsAK8_Wjj);
+  jetCleanerAK8_dR08_->clean(store_->jet_ptrsAK8_Hbb_, store_->cleanedJetsAK8_Hbb_, *event.fakeableLeptons_);
+  PROFILE_STOP(timer_jetCleanerAK8);
+  PROFILE_START(timer_jetSelectorsAK8, "RecoJetCollectionSelectorsAK8");
+  jetSelectorAK8_Hbb_->operator()(store_->cleanedJetsAK8_Hbb_, isHigherPt<RecoJetAK8>, store_->selJetsAK8_Hbb_);
+  event.selJetsAK8_Hbb_ = &store_->selJetsAK8_Hbb_;
   // CV: AK8_Wjj jets must NOT be cleaned wrt leptons,
   //     as the lepton produced in H->WW*->lnu qq decays often ends up near the two quarks in the detector (in dR)
-  jetSelectorAK8_Wjj_->getSelector().set_leptons(event.fakeableLeptons_);
-  event.selJetsAK8_Wjj_ = jetSelectorAK8_Wjj_->operator()(jet_ptrsAK8_Wjj, isHigherPt<RecoJetAK8>);
-std::cout << "break-point B.11 reached" << std::endl;
+  jetSelectorAK8_Wjj_->getSelector().set_leptons(*event.fakeableLeptons_);
+  jetSelectorAK8_Wjj_->operator()(store_->jet_ptrsAK8_Wjj_, isHigherPt<RecoJetAK8>, store_->selJetsAK8_Wjj_);
+  event.selJetsAK8_Wjj_ = &store_->selJetsAK8_Wjj_;
+  PROFILE_STOP(timer_jetSelectorsAK8);
+
+  PROFILE_START(timer_vertexReader, "RecoVertexReader");
   event.vertex_ = vertexReader_->read();
-std::cout << "break-point B.12 reached" << std::endl;
+  PROFILE_STOP(timer_vertexReader);
+  PROFILE_START(timer_metReader, "RecoMEtReader");
   metReader_->set_phiModulationCorrDetails(&eventInfo, &event.vertex_);
-  event.met_ = metReader_->read();
+  metReader_->read(store_->met_);
+  event.met_ = &store_->met_;
+  PROFILE_STOP(timer_metReader);
+  PROFILE_START(timer_metFilterReader, "MEtFilterReader");
   event.metFilters_ = metFilterReader_->read();
-std::cout << "break-point B.13 reached" << std::endl;
+  PROFILE_STOP(timer_metFilterReader);
   return event;
 }
 
@@ -0,0 +1,52 @@
+#include "TallinnNtupleProducer/Readers/interface/EventStore.h"
+
+EventStore::EventStore()
+{}
+
+EventStore::~EventStore()
+{}
+
+void
+EventStore::clear()
+{
+  selMuons_.clear();
+  muon_ptrs_.clear();
+  muons_.clear();
+  selElectrons_.clear();
+  cleanedElectrons_.clear();
+  electron_ptrs_.clear();
+  electrons_.clear();
+  selLeptons_.clear();
+  selHadTaus_.clear();
+  cleanedHadTaus_.clear();
+  hadTau_ptrs_.clear();
+  hadTaus_.clear();
+  selJetsAK4_.clear();
+  cleanedJetsAK4_.clear();
+  jet_ptrsAK4_.clear();
+  jetsAK4_.clear();
+  selJetsAK8_Hbb_.clear();
+  cleanedJetsAK8_Hbb_.clear();
+  jet_ptrsAK8_Hbb_.clear();
+  jetsAK8_Hbb_.clear();
+  selJetsAK8_Wjj_.clear();
+  jet_ptrsAK8_Wjj_.clear();
+  jetsAK8_Wjj_.clear();
+}
+
+void
+EventStore::clear_gen()
+{
+  genLeptonIndex_.clear();
+  genElectronIndex_.clear();
+  genMuonIndex_.clear();
+  genHadTauIndex_.clear();
+  genPhotonIndex_.clear();
+  genJetIndex_.clear();
+  genLeptons_.clear();
+  genElectrons_.clear();
+  genMuons_.clear();
+  genHadTaus_.clear();
+  genPhotons_.clear();
+  genJets_.clear();
+}
@@ -6,8 +6,8 @@
 #include "TString.h"                                                          // Form()
 #include "TTree.h"                                                            // TTree
 
-std::map<std::string, int> GenHadTauReader::numInstances_;
-std::map<std::string, GenHadTauReader *> GenHadTauReader::instances_;
+thread_local std::map<std::string, int> GenHadTauReader::numInstances_;
+thread_local std::map<std::string, GenHadTauReader *> GenHadTauReader::instances_;
 
 GenHadTauReader::GenHadTauReader(const edm::ParameterSet & cfg)
   : ReaderBase(cfg)
@@ -93,8 +93,8 @@ GenHadTauReader::setBranchAddresses(TTree * tree)
   return {};
 }
 
-std::vector<GenHadTau>
-GenHadTauReader::read() const
+void
+GenHadTauReader::read(std::vector<GenHadTau> & hadTaus) const
 {
   const GenHadTauReader * const gInstance = instances_[branchName_obj_];
   assert(gInstance);
@@ -107,7 +107,7 @@ GenHadTauReader::read() const
          "exceeds max_nHadTaus = " << max_nHadTaus_ << " !!\n";
   }
 
-  std::vector<GenHadTau> hadTaus;
+  hadTaus.clear();
   if(nHadTaus > 0)
   {
     hadTaus.reserve(nHadTaus);
@@ -123,5 +123,12 @@ GenHadTauReader::read() const
       });
     }
   }
+}
+
+std::vector<GenHadTau>
+GenHadTauReader::read() const
+{
+  std::vector<GenHadTau> hadTaus;
+  read(hadTaus);
   return hadTaus;
 }
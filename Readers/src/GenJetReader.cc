@@ -6,8 +6,8 @@
 #include "TString.h"                                                          // Form()
 #include "TTree.h"                                                            // TTree
 
-std::map<std::string, int> GenJetReader::numInstances_;
-std::map<std::string, GenJetReader *> GenJetReader::instances_;
+thread_local std::map<std::string, int> GenJetReader::numInstances_;
+thread_local std::map<std::string, GenJetReader *> GenJetReader::instances_;
 
 GenJetReader::GenJetReader(const edm::ParameterSet & cfg)
   : ReaderBase(cfg)
@@ -96,7 +96,8 @@ GenJetReader::setBranchAddresses(TTree * tree)
   return {};
 }
 
-std::vector<GenJet> GenJetReader::read() const
+void
+GenJetReader::read(std::vector<GenJet> & jets) const
 {
   const GenJetReader * const gInstance = instances_[branchName_obj_];
   assert(gInstance);
@@ -108,7 +109,7 @@ std::vector<GenJet> GenJetReader::read() const
       << "Number of jets stored in Ntuple = " << nJets << ", exceeds max_nJets = " << max_nJets_ << " !!\n";
   }
 
-  std::vector<GenJet> jets;
+  jets.clear();
   if(nJets > 0)
   {
     jets.reserve(nJets);
@@ -123,5 +124,12 @@ std::vector<GenJet> GenJetReader::read() const
       });
     }
   }
+}
+
+std::vector<GenJet>
+GenJetReader::read() const
+{
+  std::vector<GenJet> jets;
+  read(jets);
   return jets;
 }
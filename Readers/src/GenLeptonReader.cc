@@ -6,8 +6,8 @@
 #include "TString.h"                                                          // Form()
 #include "TTree.h"                                                            // TTree
 
-std::map<std::string, int> GenLeptonReader::numInstances_;
-std::map<std::string, GenLeptonReader *> GenLeptonReader::instances_;
+thread_local std::map<std::string, int> GenLeptonReader::numInstances_;
+thread_local std::map<std::string, GenLeptonReader *> GenLeptonReader::instances_;
 
 GenLeptonReader::GenLeptonReader(const edm::ParameterSet & cfg)
   : ReaderBase(cfg)
@@ -110,8 +110,8 @@ GenLeptonReader::setBranchAddresses(TTree * tree)
   return {};
 }
 
-std::vector<GenLepton>
-GenLeptonReader::read() const
+void
+GenLeptonReader::read(std::vector<GenLepton> & leptons) const
 {
   const GenLeptonReader * const gInstance = instances_[branchName_obj_];
   assert(gInstance);
@@ -124,7 +124,7 @@ GenLeptonReader::read() const
          " exceeds max_nLeptons = " << max_nLeptons_ << " !!\n";
   }
 
-  std::vector<GenLepton> leptons;
+  leptons.clear();
   if(nLeptons > 0)
   {
     leptons.reserve(nLeptons);
@@ -142,5 +142,12 @@ GenLeptonReader::read() const
       });
     }
   }
+}
+
+std::vector<GenLepton>
+GenLeptonReader::read() const
+{
+  std::vector<GenLepton> leptons;
+  read(leptons);
   return leptons;
 }
@@ -6,8 +6,8 @@
 #include "TTree.h"                                                            // TTree
 #include "TString.h"                                                          // Form()
 
-std::map<std::string, int> GenMEtReader::numInstances_;
-std::map<std::string, GenMEtReader *> GenMEtReader::instances_;
+thread_local std::map<std::string, int> GenMEtReader::numInstances_;
+thread_local std::map<std::string, GenMEtReader *> GenMEtReader::instances_;
 
 GenMEtReader::GenMEtReader(const edm::ParameterSet & cfg)
   : ReaderBase(cfg)
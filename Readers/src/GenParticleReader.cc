@@ -6,8 +6,8 @@
 #include "TTree.h"                                                            // TTree
 #include "TString.h"                                                          // Form()
 
-std::map<std::string, int> GenParticleReader::numInstances_;
-std::map<std::string, GenParticleReader *> GenParticleReader::instances_;
+thread_local std::map<std::string, int> GenParticleReader::numInstances_;
+thread_local std::map<std::string, GenParticleReader *> GenParticleReader::instances_;
 
 GenParticleReader::GenParticleReader(const edm::ParameterSet & cfg)
   : ReaderBase(cfg)
@@ -6,8 +6,8 @@
 #include "TString.h"                                                          // Form()
 #include "TTree.h"                                                            // TTree
 
-std::map<std::string, int> GenPhotonReader::numInstances_;
-std::map<std::string, GenPhotonReader *> GenPhotonReader::instances_;
+thread_local std::map<std::string, int> GenPhotonReader::numInstances_;
+thread_local std::map<std::string, GenPhotonReader *> GenPhotonReader::instances_;
 
 GenPhotonReader::GenPhotonReader(const edm::ParameterSet & cfg)
   : ReaderBase(cfg)
@@ -108,30 +108,9 @@ GenPhotonReader::setBranchAddresses(TTree * tree)
   return {};
 }
 
-namespace
-{
-  template <typename T>
-  std::vector<T>
-  filterByStatus(const std::vector<T> & genParticles, int status)
-  {
-    if(status > 0)
-    {
-      std::vector<T> filteredGenParticles;
-      std::copy_if(
-        genParticles.cbegin(), genParticles.cend(), std::back_inserter(filteredGenParticles),
-          [status](const GenParticle & genParticle) -> bool
-          {
-            return genParticle.status() == status;
-          }
-      );
-      return filteredGenParticles;
-    }
-    return genParticles;
-  }
-}
-
-std::vector<GenPhoton>
-GenPhotonReader::read(bool readAll) const
+void
+GenPhotonReader::read(std::vector<GenPhoton> & photons,
+                      bool readAll) const
 {
   const GenPhotonReader * const gInstance = instances_[branchName_obj_];
   assert(gInstance);
@@ -145,12 +124,17 @@ GenPhotonReader::read(bool readAll) const
     ;
   }
 
-  std::vector<GenPhoton> photons;
+  photons.clear();
   if(nPhotons > 0)
   {
     photons.reserve(nPhotons);
     for(UInt_t idxPhoton = 0; idxPhoton < nPhotons; ++idxPhoton)
     {
+      // CV: keep only photons of status 1, unless all photons are requested
+      if(! readAll && gInstance->photon_status_[idxPhoton] != 1)
+      {
+        continue;
+      }
       photons.push_back({
         gInstance->photon_pt_[idxPhoton],
         gInstance->photon_eta_[idxPhoton],
@@ -163,5 +147,12 @@ GenPhotonReader::read(bool readAll) const
       });
     }
   }
-  return readAll ? photons : filterByStatus(photons, 1);
+}
+
+std::vector<GenPhoton>
+GenPhotonReader::read(bool readAll) const
+{
+  std::vector<GenPhoton> photons;
+  read(photons, readAll);
+  return photons;
 }
@@ -10,8 +10,8 @@
 
 #include <assert.h>                                                           // assert()
 
-std::map<std::string, int> L1PreFiringWeightReader::numInstances_;
-std::map<std::string, L1PreFiringWeightReader*> L1PreFiringWeightReader::instances_;
+thread_local std::map<std::string, int> L1PreFiringWeightReader::numInstances_;
+thread_local std::map<std::string, L1PreFiringWeightReader*> L1PreFiringWeightReader::instances_;
 
 L1PreFiringWeightReader::L1PreFiringWeightReader(const edm::ParameterSet & cfg)
   : ReaderBase(cfg)
@@ -12,8 +12,8 @@
 #include <assert.h>                                                           // assert()
 #include <iostream>                                                           // std::cerr
 
-std::map<std::string, int> LHEInfoReader::numInstances_;
-std::map<std::string, LHEInfoReader*> LHEInfoReader::instances_;
+thread_local std::map<std::string, int> LHEInfoReader::numInstances_;
+thread_local std::map<std::string, LHEInfoReader*> LHEInfoReader::instances_;
 
 LHEInfoReader::LHEInfoReader(const edm::ParameterSet & cfg)
   : ReaderBase(cfg)
@@ -8,8 +8,8 @@
 
 #include <assert.h>                                                           // assert()
 
-std::map<std::string, int> LHEParticleReader::numInstances_;
-std::map<std::string, LHEParticleReader *> LHEParticleReader::instances_;
+thread_local std::map<std::string, int> LHEParticleReader::numInstances_;
+thread_local std::map<std::string, LHEParticleReader *> LHEParticleReader::instances_;
 
 LHEParticleReader::LHEParticleReader(const edm::ParameterSet & cfg)
   : ReaderBase(cfg)
@@ -9,8 +9,8 @@
 
 #include <assert.h>                                                           // assert()
 
-int MEtFilterReader::numInstances_ = 0;
-MEtFilterReader * MEtFilterReader::instance_ = nullptr;
+thread_local int MEtFilterReader::numInstances_ = 0;
+thread_local MEtFilterReader * MEtFilterReader::instance_ = nullptr;
 
 MEtFilterReader::MEtFilterReader(const edm::ParameterSet & cfg)
   : ReaderBase(cfg)
@@ -10,8 +10,8 @@
 
 #include <assert.h>                                                           // assert()
 
-std::map<std::string, int> PSWeightReader::numInstances_;
-std::map<std::string, PSWeightReader*> PSWeightReader::instances_;
+thread_local std::map<std::string, int> PSWeightReader::numInstances_;
+thread_local std::map<std::string, PSWeightReader*> PSWeightReader::instances_;
 
 PSWeightReader::PSWeightReader(const edm::ParameterSet & cfg)
   : ReaderBase(cfg)
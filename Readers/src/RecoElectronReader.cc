@@ -4,13 +4,14 @@
 #include "TallinnNtupleProducer/CommonTools/interface/electronDefinitions.h"  // EGammaID, EGammaWP
 #include "TallinnNtupleProducer/CommonTools/interface/Era.h"                  // Era
 #include "TallinnNtupleProducer/Readers/interface/BranchAddressInitializer.h" // BranchAddressInitializer
+#include "TallinnNtupleProducer/Readers/interface/preselect.h"                // preselect_equalAbs(), preselect_min(), preselect_maxAbs(), get_preselectedIdxs()
 #include "TallinnNtupleProducer/Readers/interface/RecoLeptonReader.h"         // RecoLeptonReader
 
 #include "TTree.h"                                                            // TTree
 #include "TString.h"                                                          // Form()
 
-std::map<std::string, int> RecoElectronReader::numInstances_;
-std::map<std::string, RecoElectronReader *> RecoElectronReader::instances_;
+thread_local std::map<std::string, int> RecoElectronReader::numInstances_;
+thread_local std::map<std::string, RecoElectronReader *> RecoElectronReader::instances_;
 
 RecoElectronReader::RecoElectronReader(const edm::ParameterSet & cfg)
   : ReaderBase(cfg)
@@ -28,6 +29,11 @@ RecoElectronReader::RecoElectronReader(const edm::ParameterSet & cfg)
   , conversionVeto_(nullptr)
   , cutbasedID_HLT_(nullptr)
   , mvaTTH_wp_(-1.)
+  , apply_preselection_(false)
+  , preselection_min_pt_(-1.)
+  , preselection_max_absEta_(-1.)
+  , preselection_max_dxy_(-1.)
+  , preselection_max_dz_(-1.)
 { 
   era_ = get_era(cfg.getParameter<std::string>("era"));
   branchName_obj_ = cfg.getParameter<std::string>("branchName"); // default = "Electron"
@@ -160,14 +166,28 @@ RecoElectronReader::setBranchAddresses(TTree * tree)
   return bound_branches;
 }
 
-std::vector<RecoElectron>
-RecoElectronReader::read() const
+const std::string &
+RecoElectronReader::getBranchName_num() const
+{
+  return branchName_num_;
+}
+
+unsigned
+RecoElectronReader::get_num() const
+{
+  const RecoLeptonReader * const gLeptonReader = leptonReader_->instances_[branchName_obj_];
+  assert(gLeptonReader);
+  return gLeptonReader->nLeptons_;
+}
+
+void
+RecoElectronReader::read(std::vector<RecoElectron> & electrons) const
 {
   const RecoLeptonReader * const gLeptonReader = leptonReader_->instances_[branchName_obj_];
   assert(gLeptonReader);
   const RecoElectronReader * const gElectronReader = instances_[branchName_obj_];
   assert(gElectronReader);
-  std::vector<RecoElectron> electrons;
+  electrons.clear();
 
   const UInt_t nLeptons = gLeptonReader->nLeptons_;
   if(nLeptons > leptonReader_->max_nLeptons_)
@@ -180,80 +200,96 @@ RecoElectronReader::read() const
 
   if (nLeptons > 0)
   {
-    electrons.reserve(nLeptons);
-    for(UInt_t idxLepton = 0; idxLepton < nLeptons; ++idxLepton)
+    // CV: evaluate the preselection on the branch arrays, so that RecoElectron objects are constructed only for the electrons that pass it
+    passesPreselection_.assign(nLeptons, 1);
+    preselect_equalAbs(gLeptonReader->pdgId_, nLeptons, 11, passesPreselection_.data());
+    if(apply_preselection_)
     {
-      if(std::abs(gLeptonReader->pdgId_[idxLepton]) == 11)
-      {
-        electrons.push_back({
-          {
-            {
-              gLeptonReader->pt_[idxLepton],
-              gLeptonReader->eta_[idxLepton],
-              gLeptonReader->phi_[idxLepton],
-              gLeptonReader->mass_[idxLepton],
-              gLeptonReader->pdgId_[idxLepton],
-              gLeptonReader->charge_[idxLepton],
-            },
-            gLeptonReader->dxy_[idxLepton],
-            gLeptonReader->dz_[idxLepton],
-            gLeptonReader->relIso_all_[idxLepton],
-            gLeptonReader->pfRelIso04_all_[idxLepton],
-            gLeptonReader->relIso_chg_[idxLepton],
-            gLeptonReader->relIso_neu_[idxLepton],
-            gLeptonReader->sip3d_[idxLepton],
-            gLeptonReader->mvaRawTTH_[idxLepton],
-            gLeptonReader->jetPtRatio_[idxLepton],
-            gLeptonReader->jetPtRel_[idxLepton],
-            gLeptonReader->jetNDauChargedMVASel_[idxLepton],
-            gLeptonReader->tightCharge_[idxLepton],
-            gLeptonReader->filterBits_[idxLepton],
-            gLeptonReader->jetIdx_[idxLepton],
-            gLeptonReader->genPartFlav_[idxLepton],
-            gLeptonReader->genMatchIdx_[idxLepton],
-          },
-          gElectronReader->eCorr_[idxLepton],
-          gElectronReader->sigmaEtaEta_[idxLepton],
-          gElectronReader->HoE_[idxLepton],
-          gElectronReader->deltaEta_[idxLepton],
-          gElectronReader->deltaPhi_[idxLepton],
-          gElectronReader->OoEminusOoP_[idxLepton],
-          gElectronReader->lostHits_[idxLepton],
-          gElectronReader->conversionVeto_[idxLepton],
-          gElectronReader->cutbasedID_HLT_[idxLepton],
-        });
+      preselect_min(gLeptonReader->pt_, nLeptons, preselection_min_pt_, passesPreselection_.data());
+      preselect_maxAbs(gLeptonReader->eta_, nLeptons, preselection_max_absEta_, passesPreselection_.data());
+      preselect_maxAbs(gLeptonReader->dxy_, nLeptons, preselection_max_dxy_, passesPreselection_.data());
+      preselect_maxAbs(gLeptonReader->dz_, nLeptons, preselection_max_dz_, passesPreselection_.data());
+    }
+    get_preselectedIdxs(passesPreselection_.data(), nLeptons, preselectedIdxs_);
 
-        RecoElectron & electron = electrons.back();
-        for(const auto & kv: gLeptonReader->jetBtagCSVs_)
-        {
-          const double val = kv.second[idxLepton];
-          electron.jetBtagCSVs_[kv.first] = std::isnan(val) ? -2. : val;
-        }
-        for(const auto & kv: gLeptonReader->assocJetBtagCSVs_)
-        {
-          const double val = kv.second[idxLepton];
-          electron.assocJetBtagCSVs_[kv.first] = std::isnan(val) ? -2. : val;
-        }
-        for(const auto & EGammaID_choice: gElectronReader->rawMVAs_POG_)
-        {
-          electron.egammaID_raws_[EGammaID_choice.first] = EGammaID_choice.second[idxLepton];
-        }
-        for(const auto & EGammaID_choice: gElectronReader->mvaIDs_POG_)
+    electrons.reserve(preselectedIdxs_.size());
+    for(std::size_t idxLepton: preselectedIdxs_)
+    {
+      electrons.push_back({
         {
-          electron.egammaID_ids_[EGammaID_choice.first] = {};
-          for(const auto & EGammaWP_choice: EGammaID_choice.second)
           {
-            electron.egammaID_ids_[EGammaID_choice.first][EGammaWP_choice.first] = EGammaWP_choice.second[idxLepton];
-          }
-        }
-        if(mvaTTH_wp_ > 0.)
+            gLeptonReader->pt_[idxLepton],
+            gLeptonReader->eta_[idxLepton],
+            gLeptonReader->phi_[idxLepton],
+            gLeptonReader->mass_[idxLepton],
+            gLeptonReader->pdgId_[idxLepton],
+            gLeptonReader->charge_[idxLepton],
+          },
+          gLeptonReader->dxy_[idxLepton],
+          gLeptonReader->dz_[idxLepton],
+          gLeptonReader->relIso_all_[idxLepton],
+          gLeptonReader->pfRelIso04_all_[idxLepton],
+          gLeptonReader->relIso_chg_[idxLepton],
+          gLeptonReader->relIso_neu_[idxLepton],
+          gLeptonReader->sip3d_[idxLepton],
+          gLeptonReader->mvaRawTTH_[idxLepton],
+          gLeptonReader->jetPtRatio_[idxLepton],
+          gLeptonReader->jetPtRel_[idxLepton],
+          gLeptonReader->jetNDauChargedMVASel_[idxLepton],
+          gLeptonReader->tightCharge_[idxLepton],
+          gLeptonReader->filterBits_[idxLepton],
+          gLeptonReader->jetIdx_[idxLepton],
+          gLeptonReader->genPartFlav_[idxLepton],
+          gLeptonReader->genMatchIdx_[idxLepton],
+        },
+        gElectronReader->eCorr_[idxLepton],
+        gElectronReader->sigmaEtaEta_[idxLepton],
+        gElectronReader->HoE_[idxLepton],
+        gElectronReader->deltaEta_[idxLepton],
+        gElectronReader->deltaPhi_[idxLepton],
+        gElectronReader->OoEminusOoP_[idxLepton],
+        gElectronReader->lostHits_[idxLepton],
+        gElectronReader->conversionVeto_[idxLepton],
+        gElectronReader->cutbasedID_HLT_[idxLepton],
+      });
+
+      RecoElectron & electron = electrons.back();
+      for(const auto & kv: gLeptonReader->jetBtagCSVs_)
+      {
+        const double val = kv.second[idxLepton];
+        electron.set_jetBtagCSV(kv.first, std::isnan(val) ? -2. : val, false);
+      }
+      for(const auto & kv: gLeptonReader->assocJetBtagCSVs_)
+      {
+        const double val = kv.second[idxLepton];
+        electron.set_jetBtagCSV(kv.first, std::isnan(val) ? -2. : val, true);
+      }
+      for(const auto & EGammaID_choice: gElectronReader->rawMVAs_POG_)
+      {
+        electron.egammaID_raws_[EGammaID_choice.first] = EGammaID_choice.second[idxLepton];
+      }
+      for(const auto & EGammaID_choice: gElectronReader->mvaIDs_POG_)
+      {
+        electron.egammaID_ids_[EGammaID_choice.first] = {};
+        for(const auto & EGammaWP_choice: EGammaID_choice.second)
         {
-          electron.set_mvaRawTTH_cut(mvaTTH_wp_);
+          electron.egammaID_ids_[EGammaID_choice.first][EGammaWP_choice.first] = EGammaWP_choice.second[idxLepton];
         }
       }
+      if(mvaTTH_wp_ > 0.)
+      {
+        electron.set_mvaRawTTH_cut(mvaTTH_wp_);
+      }
     }
-    gLeptonReader->readGenMatching(electrons);
+    gLeptonReader->readGenMatching(electrons, preselectedIdxs_);
   }
+}
+
+std::vector<RecoElectron>
+RecoElectronReader::read() const
+{
+  std::vector<RecoElectron> electrons;
+  read(electrons);
   return electrons;
 }
 
@@ -262,3 +298,16 @@ RecoElectronReader::set_mvaTTH_wp(double mvaTTH_wp)
 {
   mvaTTH_wp_ = mvaTTH_wp;
 }
+
+void
+RecoElectronReader::set_preselection(double min_pt,
+                                     double max_absEta,
+                                     double max_dxy,
+                                     double max_dz)
+{
+  apply_preselection_ = true;
+  preselection_min_pt_ = min_pt;
+  preselection_max_absEta_ = max_absEta;
+  preselection_max_dxy_ = max_dxy;
+  preselection_max_dz_ = max_dz;
+}
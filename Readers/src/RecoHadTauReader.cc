@@ -7,13 +7,14 @@
 #include "TallinnNtupleProducer/Readers/interface/GenHadTauReader.h"          // GenHadTauReader
 #include "TallinnNtupleProducer/Readers/interface/GenLeptonReader.h"          // GenLeptonReader
 #include "TallinnNtupleProducer/Readers/interface/GenJetReader.h"             // GenJetReader
+#include "TallinnNtupleProducer/Readers/interface/preselect.h"                // preselect_min(), preselect_maxAbs(), preselect_true(), preselect_whitelist(), preselect_blacklist(), get_preselectedIdxs()
 #include "TallinnNtupleProducer/Readers/interface/TauESTool.h"                // TauESTool
 
 #include "TTree.h"                                                            // TTree
 #include "TString.h"                                                          // Form()
 
-std::map<std::string, int> RecoHadTauReader::numInstances_;
-std::map<std::string, RecoHadTauReader *> RecoHadTauReader::instances_;
+thread_local std::map<std::string, int> RecoHadTauReader::numInstances_;
+thread_local std::map<std::string, RecoHadTauReader *> RecoHadTauReader::instances_;
 
 RecoHadTauReader::RecoHadTauReader(const edm::ParameterSet & cfg)
   : ReaderBase(cfg)
@@ -28,6 +29,11 @@ RecoHadTauReader::RecoHadTauReader(const edm::ParameterSet & cfg)
   , readGenMatching_(false)
   , tauID_(TauID::DeepTau2017v2VSjet)
   , tauESTool_(nullptr)
+  , apply_preselection_(false)
+  , preselection_min_pt_(-1.)
+  , preselection_max_absEta_(-1.)
+  , preselection_max_dz_(-1.)
+  , preselection_apply_decayModeFinding_(false)
   , hadTau_pt_(nullptr)
   , hadTau_eta_(nullptr)
   , hadTau_phi_(nullptr)
@@ -128,6 +134,23 @@ RecoHadTauReader::set_default_tauID(TauID tauId)
   }
 }
 
+void
+RecoHadTauReader::set_preselection(double min_pt,
+                                   double max_absEta,
+                                   double max_dz,
+                                   bool apply_decayModeFinding,
+                                   const std::vector<int> & decayMode_whitelist,
+                                   const std::vector<int> & decayMode_blacklist)
+{
+  apply_preselection_ = true;
+  preselection_min_pt_ = min_pt;
+  preselection_max_absEta_ = max_absEta;
+  preselection_max_dz_ = max_dz;
+  preselection_apply_decayModeFinding_ = apply_decayModeFinding;
+  preselection_decayMode_whitelist_ = decayMode_whitelist;
+  preselection_decayMode_blacklist_ = decayMode_blacklist;
+}
+
 void
 RecoHadTauReader::setBranchNames()
 {
@@ -215,13 +238,27 @@ RecoHadTauReader::setBranchAddresses(TTree * tree)
   return bound_branches;
 }
 
-std::vector<RecoHadTau>
-RecoHadTauReader::read() const
+const std::string &
+RecoHadTauReader::getBranchName_num() const
+{
+  return branchName_num_;
+}
+
+unsigned
+RecoHadTauReader::get_num() const
 {
   const RecoHadTauReader * const gInstance = instances_[branchName_obj_];
   assert(gInstance);
+  return gInstance->nHadTaus_;
+}
 
-  std::vector<RecoHadTau> hadTaus;
+void
+RecoHadTauReader::read(std::vector<RecoHadTau> & hadTaus) const
+{
+  const RecoHadTauReader * const gInstance = instances_[branchName_obj_];
+  assert(gInstance);
+
+  hadTaus.clear();
   const UInt_t nHadTaus = gInstance->nHadTaus_;
   if(nHadTaus > max_nHadTaus_)
   {
@@ -232,15 +269,40 @@ RecoHadTauReader::read() const
 
   if(nHadTaus > 0)
   {
-    hadTaus.reserve(nHadTaus);
+    corrFactors_.resize(nHadTaus);
+    corrPts_.resize(nHadTaus);
     for(UInt_t idxHadTau = 0; idxHadTau < nHadTaus; ++idxHadTau)
     {
-      const double corrFactor = tauESTool_ ? tauESTool_->getTES(
+      corrFactors_[idxHadTau] = tauESTool_ ? tauESTool_->getTES(
           gInstance->hadTau_pt_[idxHadTau],
           gInstance->hadTau_decayMode_[idxHadTau],
           gInstance->hadTau_genPartFlav_[idxHadTau]
         ) : 1.
       ;
+      corrPts_[idxHadTau] = gInstance->hadTau_pt_[idxHadTau] * corrFactors_[idxHadTau];
+    }
+
+    // CV: evaluate the preselection on the branch arrays, so that RecoHadTau objects are constructed only for the hadronic taus that pass it;
+    //     the cut on pT is applied after the tau energy scale correction, as it is by the selectors
+    passesPreselection_.assign(nHadTaus, 1);
+    if(apply_preselection_)
+    {
+      preselect_min(corrPts_.data(), nHadTaus, preselection_min_pt_, passesPreselection_.data());
+      preselect_maxAbs(gInstance->hadTau_eta_, nHadTaus, preselection_max_absEta_, passesPreselection_.data());
+      preselect_maxAbs(gInstance->hadTau_dz_, nHadTaus, preselection_max_dz_, passesPreselection_.data());
+      if(preselection_apply_decayModeFinding_)
+      {
+        preselect_true(gInstance->hadTau_idDecayMode_, nHadTaus, passesPreselection_.data());
+      }
+      preselect_whitelist(gInstance->hadTau_decayMode_, nHadTaus, preselection_decayMode_whitelist_, passesPreselection_.data());
+      preselect_blacklist(gInstance->hadTau_decayMode_, nHadTaus, preselection_decayMode_blacklist_, passesPreselection_.data());
+    }
+    get_preselectedIdxs(passesPreselection_.data(), nHadTaus, preselectedIdxs_);
+
+    hadTaus.reserve(preselectedIdxs_.size());
+    for(std::size_t idxHadTau: preselectedIdxs_)
+    {
+      const double corrFactor = corrFactors_[idxHadTau];
       const double hadTau_pt   = gInstance->hadTau_pt_  [idxHadTau] * corrFactor;
       const double hadTau_mass = gInstance->hadTau_mass_[idxHadTau] * corrFactor;
 
@@ -280,6 +342,13 @@ RecoHadTauReader::read() const
     }
     readGenMatching(hadTaus);
   }
+}
+
+std::vector<RecoHadTau>
+RecoHadTauReader::read() const
+{
+  std::vector<RecoHadTau> hadTaus;
+  read(hadTaus);
   return hadTaus;
 }
 
@@ -290,28 +359,32 @@ RecoHadTauReader::readGenMatching(std::vector<RecoHadTau> & hadTaus) const
   {
     assert(genLeptonReader_ && genHadTauReader_ && genJetReader_);
     const std::size_t nHadTaus = hadTaus.size();
+    assert(preselectedIdxs_.size() == nHadTaus);
 
-    std::vector<GenLepton> matched_genLeptons = genLeptonReader_->read();
-    assert(matched_genLeptons.size() == nHadTaus);
+    genLeptonReader_->read(matched_genLeptons_);
+    assert(matched_genLeptons_.size() == passesPreselection_.size());
 
-    std::vector<GenHadTau> matched_genHadTaus = genHadTauReader_->read();
-    assert(matched_genHadTaus.size() == nHadTaus);
+    genHadTauReader_->read(matched_genHadTaus_);
+    assert(matched_genHadTaus_.size() == passesPreselection_.size());
 
-    std::vector<GenJet> matched_genJets = genJetReader_->read();
-    assert(matched_genJets.size() == nHadTaus);
+    genJetReader_->read(matched_genJets_);
+    assert(matched_genJets_.size() == passesPreselection_.size());
 
     for(std::size_t idxHadTau = 0; idxHadTau < nHadTaus; ++idxHadTau)
     {
       RecoHadTau & hadTau = hadTaus[idxHadTau];
+      // CV: the arrays of matched generator level particles have one entry per hadronic tau stored in the Ntuple,
+      //     including the hadronic taus that fail the preselection
+      const std::size_t idxHadTau_stored = preselectedIdxs_[idxHadTau];
 
-      const GenLepton & matched_genLepton = matched_genLeptons[idxHadTau];
-      if(matched_genLepton.isValid()) hadTau.set_genLepton(new GenLepton(matched_genLepton));
+      const GenLepton & matched_genLepton = matched_genLeptons_[idxHadTau_stored];
+      if(matched_genLepton.isValid()) hadTau.set_genLepton(&matched_genLepton);
 
-      const GenHadTau & matched_genHadTau = matched_genHadTaus[idxHadTau];
-      if(matched_genHadTau.isValid()) hadTau.set_genHadTau(new GenHadTau(matched_genHadTau));
+      const GenHadTau & matched_genHadTau = matched_genHadTaus_[idxHadTau_stored];
+      if(matched_genHadTau.isValid()) hadTau.set_genHadTau(&matched_genHadTau);
 
-      const GenJet & matched_genJet = matched_genJets[idxHadTau];
-      if(matched_genJet.isValid()) hadTau.set_genJet(new GenJet(matched_genJet));
+      const GenJet & matched_genJet = matched_genJets_[idxHadTau_stored];
+      if(matched_genJet.isValid()) hadTau.set_genJet(&matched_genJet);
     }
   }
 }
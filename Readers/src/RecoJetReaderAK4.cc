@@ -8,12 +8,13 @@
 #include "TallinnNtupleProducer/Readers/interface/GenHadTauReader.h"          // GenHadTauReader
 #include "TallinnNtupleProducer/Readers/interface/GenLeptonReader.h"          // GenLeptonReader
 #include "TallinnNtupleProducer/Readers/interface/GenJetReader.h"             // GenJetReader
+#include "TallinnNtupleProducer/Readers/interface/preselect.h"                // preselect_min(), preselect_maxAbs(), get_preselectedIdxs()
 
 #include "TTree.h"                                                            // TTree
 #include "TString.h"                                                          // Form()
 
-std::map<std::string, int> RecoJetReaderAK4::numInstances_;
-std::map<std::string, RecoJetReaderAK4 *> RecoJetReaderAK4::instances_;
+thread_local std::map<std::string, int> RecoJetReaderAK4::numInstances_;
+thread_local std::map<std::string, RecoJetReaderAK4 *> RecoJetReaderAK4::instances_;
 
 RecoJetReaderAK4::RecoJetReaderAK4(const edm::ParameterSet & cfg)
   : ReaderBase(cfg)
@@ -31,6 +32,10 @@ RecoJetReaderAK4::RecoJetReaderAK4(const edm::ParameterSet & cfg)
   , ptMassOption_(-1)
   , read_ptMass_systematics_(false)
   , read_btag_systematics_(false)
+  , apply_preselection_(false)
+  , preselection_min_pt_(-1.)
+  , preselection_max_absEta_(-1.)
+  , preselection_min_jetId_(-1)
   , jet_eta_(nullptr)
   , jet_phi_(nullptr)
   , jet_charge_(nullptr)
@@ -158,6 +163,17 @@ RecoJetReaderAK4::read_btag_systematics(bool flag)
   read_btag_systematics_ = flag;
 }
 
+void
+RecoJetReaderAK4::set_preselection(double min_pt,
+                                   double max_absEta,
+                                   int min_jetId)
+{
+  apply_preselection_ = true;
+  preselection_min_pt_ = min_pt;
+  preselection_max_absEta_ = max_absEta;
+  preselection_min_jetId_ = min_jetId;
+}
+
 void
 RecoJetReaderAK4::setBranchNames()
 {
@@ -304,13 +320,13 @@ RecoJetReaderAK4::setBranchAddresses(TTree * tree)
   return bound_branches;
 }
 
-std::vector<RecoJetAK4>
-RecoJetReaderAK4::read() const
+void
+RecoJetReaderAK4::read(std::vector<RecoJetAK4> & jets) const
 {
   const RecoJetReaderAK4 * const gInstance = instances_[branchName_obj_];
   assert(gInstance);
 
-  std::vector<RecoJetAK4> jets;
+  jets.clear();
   const UInt_t nJets = gInstance->nJets_;
   if(nJets > max_nJets_)
   {
@@ -321,8 +337,21 @@ RecoJetReaderAK4::read() const
 
   if(nJets > 0)
   {
-    jets.reserve(nJets);
-    for(UInt_t idxJet = 0; idxJet < nJets; ++idxJet)
+    // CV: evaluate the preselection on the branch arrays, so that RecoJet objects are constructed only for the jets that pass it
+    passesPreselection_.assign(nJets, 1);
+    if(apply_preselection_)
+    {
+      preselect_min(gInstance->jet_pt_systematics_.at(ptMassOption_), nJets, preselection_min_pt_, passesPreselection_.data());
+      if(preselection_max_absEta_ > 0.)
+      {
+        preselect_maxAbs(gInstance->jet_eta_, nJets, preselection_max_absEta_, passesPreselection_.data());
+      }
+      preselect_min(gInstance->jet_jetId_, nJets, preselection_min_jetId_, passesPreselection_.data());
+    }
+    get_preselectedIdxs(passesPreselection_.data(), nJets, preselectedIdxs_);
+
+    jets.reserve(preselectedIdxs_.size());
+    for(std::size_t idxJet: preselectedIdxs_)
     {
       // set QGL to -1. if:
       // 1) the value is nan
@@ -380,28 +409,27 @@ RecoJetReaderAK4::read() const
       {
         for(const auto & kv: gInstance->jet_BtagWeights_systematics_)
         {
-          for(int idxShift = kBtag_central; idxShift <= kBtag_jesRelativeSample_EraDown; ++idxShift)
+          // CV: loop over the branches that have actually been bound, rather than looking up every kBtag_* enum
+          for(const auto & kv_shift: kv.second)
           {
+            const int idxShift = kv_shift.first;
             if(! read_btag_systematics_ && idxShift != btag_central_or_shift_)
             {
               continue;
             }
-            if(gInstance->jet_BtagWeights_systematics_.at(kv.first).count(idxShift))
-            {
-              jet.BtagWeight_systematics_[kv.first][idxShift] = gInstance->jet_BtagWeights_systematics_.at(kv.first).at(idxShift)[idxJet];
-            }
-          } // idxShift
+            jet.set_BtagWeight(kv.first, idxShift, kv_shift.second[idxJet]);
+          } // kv_shift
         } // jet_BtagWeights_systematics_
       } // isMC_
 
       for(const auto & kv: gInstance->jet_BtagCSVs_)
       {
-        double btagCSV_tmp = gInstance->jet_BtagCSVs_.at(kv.first)[idxJet];
+        double btagCSV_tmp = kv.second[idxJet];
         if(std::isnan(btagCSV_tmp))
         {
           btagCSV_tmp = -2;
         }
-        jet.BtagCSVs_[kv.first] = btagCSV_tmp;
+        jet.set_BtagCSV(kv.first, btagCSV_tmp);
       }
 
       if(isMC_ && read_ptMass_systematics_)
@@ -412,23 +440,30 @@ RecoJetReaderAK4::read() const
           {
             continue;
           }
-          // we want to save all pT-s and masses that have been shifted by systematic uncertainties to the maps,
+          // we want to save all pT-s and masses that have been shifted by systematic uncertainties to the arrays,
           // including the central nominal and central non-nominal values; crucial for RecoJetWriter
-          jet.pt_systematics_[idxShift]   = gInstance->jet_pt_systematics_.at(idxShift)[idxJet];
-          jet.mass_systematics_[idxShift] = gInstance->jet_mass_systematics_.at(idxShift)[idxJet];
+          jet.set_systematics_ptMass(
+            idxShift, gInstance->jet_pt_systematics_.at(idxShift)[idxJet], gInstance->jet_mass_systematics_.at(idxShift)[idxJet]
+          );
         } // idxShift
       }
       else
       {
-        // fill the maps with only the central values (either nominal or non-nominal if data)
-        jet.pt_systematics_[ptMassOption_]   = gInstance->jet_pt_systematics_.at(ptMassOption_)[idxJet];
-        jet.mass_systematics_[ptMassOption_] = gInstance->jet_mass_systematics_.at(ptMassOption_)[idxJet];
+        // fill the arrays with only the central values (either nominal or non-nominal if data)
+        jet.set_systematics_ptMass(ptMassOption_, jet_pt, jet_mass);
       } // isMC_
 
     } // idxJet
 
     readGenMatching(jets);
   } // nJets > 0
+}
+
+std::vector<RecoJetAK4>
+RecoJetReaderAK4::read() const
+{
+  std::vector<RecoJetAK4> jets;
+  read(jets);
   return jets;
 }
 
@@ -438,29 +473,33 @@ RecoJetReaderAK4::readGenMatching(std::vector<RecoJetAK4> & jets) const
   if(readGenMatching_)
   {
     assert(genLeptonReader_ && genHadTauReader_ && genJetReader_);
-    std::size_t nJets = jets.size();
+    const std::size_t nJets = jets.size();
+    assert(preselectedIdxs_.size() == nJets);
 
-    std::vector<GenLepton> matched_genLeptons = genLeptonReader_->read();
-    assert(matched_genLeptons.size() == nJets);
+    genLeptonReader_->read(matched_genLeptons_);
+    assert(matched_genLeptons_.size() == passesPreselection_.size());
 
-    std::vector<GenHadTau> matched_genHadTaus = genHadTauReader_->read();
-    assert(matched_genHadTaus.size() == nJets);
+    genHadTauReader_->read(matched_genHadTaus_);
+    assert(matched_genHadTaus_.size() == passesPreselection_.size());
 
-    std::vector<GenJet> matched_genJets = genJetReader_->read();
-    assert(matched_genJets.size() == nJets);
+    genJetReader_->read(matched_genJets_);
+    assert(matched_genJets_.size() == passesPreselection_.size());
 
     for(std::size_t idxJet = 0; idxJet < nJets; ++idxJet)
     {
       RecoJetAK4 & jet = jets[idxJet];
+      // CV: the arrays of matched generator level particles have one entry per jet stored in the Ntuple,
+      //     including the jets that fail the preselection
+      const std::size_t idxJet_stored = preselectedIdxs_[idxJet];
 
-      const GenLepton & matched_genLepton = matched_genLeptons[idxJet];
-      if(matched_genLepton.isValid()) jet.set_genLepton(new GenLepton(matched_genLepton));
+      const GenLepton & matched_genLepton = matched_genLeptons_[idxJet_stored];
+      if(matched_genLepton.isValid()) jet.set_genLepton(&matched_genLepton);
 
-      const GenHadTau & matched_genHadTau = matched_genHadTaus[idxJet];
-      if(matched_genHadTau.isValid()) jet.set_genHadTau(new GenHadTau(matched_genHadTau));
+      const GenHadTau & matched_genHadTau = matched_genHadTaus_[idxJet_stored];
+      if(matched_genHadTau.isValid()) jet.set_genHadTau(&matched_genHadTau);
 
-      const GenJet & matched_genJet = matched_genJets[idxJet];
-      if(matched_genJet.isValid()) jet.set_genJet(new GenJet(matched_genJet));
+      const GenJet & matched_genJet = matched_genJets_[idxJet_stored];
+      if(matched_genJet.isValid()) jet.set_genJet(&matched_genJet);
     }
   }
 }
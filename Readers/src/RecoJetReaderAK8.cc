@@ -11,8 +11,8 @@
 #include "TTree.h"                                                            // TTree
 #include "TString.h"                                                          // Form()
 
-std::map<std::string, int> RecoJetReaderAK8::numInstances_;
-std::map<std::string, RecoJetReaderAK8 *> RecoJetReaderAK8::instances_;
+thread_local std::map<std::string, int> RecoJetReaderAK8::numInstances_;
+thread_local std::map<std::string, RecoJetReaderAK8 *> RecoJetReaderAK8::instances_;
 
 RecoJetReaderAK8::RecoJetReaderAK8(const edm::ParameterSet & cfg)
   : ReaderBase(cfg)
@@ -332,13 +332,13 @@ namespace
   }
 }
 
-std::vector<RecoJetAK8>
-RecoJetReaderAK8::read() const
+void
+RecoJetReaderAK8::read(std::vector<RecoJetAK8> & jets) const
 {
   const RecoJetReaderAK8 * const gInstance = instances_[branchName_obj_];
   assert(gInstance);
 
-  std::vector<RecoJetAK8> jets;
+  jets.clear();
   const UInt_t nJets = gInstance->nJets_;
   if(nJets > max_nJets_)
   {
@@ -430,5 +430,12 @@ RecoJetReaderAK8::read() const
     } // idxJet
   } // nJets > 0
 
+}
+
+std::vector<RecoJetAK8>
+RecoJetReaderAK8::read() const
+{
+  std::vector<RecoJetAK8> jets;
+  read(jets);
   return jets;
 }
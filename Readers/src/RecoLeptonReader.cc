@@ -8,8 +8,8 @@
 #include <TString.h>                                                          // Form
 #include <TTree.h>                                                            // TTree
 
-std::map<std::string, int> RecoLeptonReader::numInstances_;
-std::map<std::string, RecoLeptonReader *> RecoLeptonReader::instances_;
+thread_local std::map<std::string, int> RecoLeptonReader::numInstances_;
+thread_local std::map<std::string, RecoLeptonReader *> RecoLeptonReader::instances_;
 
 RecoLeptonReader::RecoLeptonReader(const edm::ParameterSet & cfg)
   : ReaderBase(cfg)
@@ -9,8 +9,8 @@
 #include "TString.h"                                                          // Form()
 #include "TTree.h"                                                            // TTree
 
-std::map<std::string, int> RecoMEtReader::numInstances_;
-std::map<std::string, RecoMEtReader *> RecoMEtReader::instances_;
+thread_local std::map<std::string, int> RecoMEtReader::numInstances_;
+thread_local std::map<std::string, RecoMEtReader *> RecoMEtReader::instances_;
 
 RecoMEtReader::RecoMEtReader(const edm::ParameterSet & cfg)
   : ReaderBase(cfg)
@@ -159,15 +159,22 @@ RecoMEtReader::set_phiModulationCorrDetails(const EventInfo * const eventInfo,
 
 RecoMEt
 RecoMEtReader::read() const
+{
+  RecoMEt met;
+  read(met);
+  return met;
+}
+
+void
+RecoMEtReader::read(RecoMEt & met) const
 {
   const RecoMEtReader * const gInstance = instances_[branchName_obj_];
   assert(gInstance);
-  RecoMEt met = met_;
+  met = met_;
   if(enable_phiModulationCorr_)
   {
     const std::pair TheXYCorr_Met_MetPhi = METXYCorr_Met_MetPhi(eventInfo_, recoVertex_, era_);
     met.shift_PxPy(TheXYCorr_Met_MetPhi);
   }
   met.set_default(ptPhiOption_);
-  return met;
 }
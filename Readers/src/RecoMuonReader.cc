@@ -3,13 +3,14 @@
 #include "TallinnNtupleProducer/CommonTools/interface/cmsException.h"         // cmsException()
 #include "TallinnNtupleProducer/CommonTools/interface/Era.h"                  // Era
 #include "TallinnNtupleProducer/Readers/interface/BranchAddressInitializer.h" // BranchAddressInitializer
+#include "TallinnNtupleProducer/Readers/interface/preselect.h"                // preselect_equalAbs(), preselect_min(), preselect_maxAbs(), get_preselectedIdxs()
 #include "TallinnNtupleProducer/Readers/interface/RecoLeptonReader.h"         // RecoLeptonReader
 
 #include "TTree.h"                                                            // TTree
 #include "TString.h"                                                          // Form()
 
-std::map<std::string, int> RecoMuonReader::numInstances_;
-std::map<std::string, RecoMuonReader *> RecoMuonReader::instances_;
+thread_local std::map<std::string, int> RecoMuonReader::numInstances_;
+thread_local std::map<std::string, RecoMuonReader *> RecoMuonReader::instances_;
 
 RecoMuonReader::RecoMuonReader(const edm::ParameterSet & cfg)
   : ReaderBase(cfg)
@@ -21,6 +22,11 @@ RecoMuonReader::RecoMuonReader(const edm::ParameterSet & cfg)
   , segmentCompatibility_(nullptr)
   , ptErr_(nullptr)
   , mvaTTH_wp_(-1.)
+  , apply_preselection_(false)
+  , preselection_min_pt_(-1.)
+  , preselection_max_absEta_(-1.)
+  , preselection_max_dxy_(-1.)
+  , preselection_max_dz_(-1.)
 {
   era_ = get_era(cfg.getParameter<std::string>("era"));
   branchName_obj_ = cfg.getParameter<std::string>("branchName"); // default = "Muon"
@@ -92,14 +98,28 @@ RecoMuonReader::setBranchAddresses(TTree * tree)
   return bound_branches;
 }
 
-std::vector<RecoMuon>
-RecoMuonReader::read() const
+const std::string &
+RecoMuonReader::getBranchName_num() const
+{
+  return branchName_num_;
+}
+
+unsigned
+RecoMuonReader::get_num() const
+{
+  const RecoLeptonReader * const gLeptonReader = leptonReader_->instances_[branchName_obj_];
+  assert(gLeptonReader);
+  return gLeptonReader->nLeptons_;
+}
+
+void
+RecoMuonReader::read(std::vector<RecoMuon> & muons) const
 {
   const RecoLeptonReader * const gLeptonReader = leptonReader_->instances_[branchName_obj_];
   assert(gLeptonReader);
   const RecoMuonReader * const gMuonReader = instances_[branchName_obj_];
   assert(gMuonReader);
-  std::vector<RecoMuon> muons;
+  muons.clear();
   const UInt_t nLeptons = gLeptonReader->nLeptons_;
   
   if(nLeptons > leptonReader_->max_nLeptons_)
@@ -110,66 +130,82 @@ RecoMuonReader::read() const
   }
   if(nLeptons > 0)
   {
-    muons.reserve(nLeptons);
-    for(UInt_t idxLepton = 0; idxLepton < nLeptons; ++idxLepton)
+    // CV: evaluate the preselection on the branch arrays, so that RecoMuon objects are constructed only for the muons that pass it
+    passesPreselection_.assign(nLeptons, 1);
+    preselect_equalAbs(gLeptonReader->pdgId_, nLeptons, 13, passesPreselection_.data());
+    if(apply_preselection_)
     {
-      if(std::abs(gLeptonReader->pdgId_[idxLepton]) == 13)
-      {
-        // Karl: For *some* leptons that don't have an associated jet,
-        //       the deepCSV score is nan (and not -1) for an unknown reason.
-        //       Adding a safeguard for these instances.
-        muons.push_back(RecoMuon({
+      preselect_min(gLeptonReader->pt_, nLeptons, preselection_min_pt_, passesPreselection_.data());
+      preselect_maxAbs(gLeptonReader->eta_, nLeptons, preselection_max_absEta_, passesPreselection_.data());
+      preselect_maxAbs(gLeptonReader->dxy_, nLeptons, preselection_max_dxy_, passesPreselection_.data());
+      preselect_maxAbs(gLeptonReader->dz_, nLeptons, preselection_max_dz_, passesPreselection_.data());
+    }
+    get_preselectedIdxs(passesPreselection_.data(), nLeptons, preselectedIdxs_);
+
+    muons.reserve(preselectedIdxs_.size());
+    for(std::size_t idxLepton: preselectedIdxs_)
+    {
+      // Karl: For *some* leptons that don't have an associated jet,
+      //       the deepCSV score is nan (and not -1) for an unknown reason.
+      //       Adding a safeguard for these instances.
+      muons.push_back(RecoMuon({
+        {
           {
-            {
-              gLeptonReader->pt_[idxLepton],
-              gLeptonReader->eta_[idxLepton],
-              gLeptonReader->phi_[idxLepton],
-              gLeptonReader->mass_[idxLepton],
-              gLeptonReader->pdgId_[idxLepton],
-              gLeptonReader->charge_[idxLepton],
-            },
-            gLeptonReader->dxy_[idxLepton],
-            gLeptonReader->dz_[idxLepton],
-            gLeptonReader->relIso_all_[idxLepton],
-            gLeptonReader->pfRelIso04_all_[idxLepton],
-            gLeptonReader->relIso_chg_[idxLepton],
-            gLeptonReader->relIso_neu_[idxLepton],
-            gLeptonReader->sip3d_[idxLepton],
-            gLeptonReader->mvaRawTTH_[idxLepton],
-            gLeptonReader->jetPtRatio_[idxLepton],
-            gLeptonReader->jetPtRel_[idxLepton],
-            gLeptonReader->jetNDauChargedMVASel_[idxLepton],
-            gLeptonReader->tightCharge_[idxLepton],
-            gLeptonReader->filterBits_[idxLepton],
-            gLeptonReader->jetIdx_[idxLepton],
-            gLeptonReader->genPartFlav_[idxLepton],
-            gLeptonReader->genMatchIdx_[idxLepton],
+            gLeptonReader->pt_[idxLepton],
+            gLeptonReader->eta_[idxLepton],
+            gLeptonReader->phi_[idxLepton],
+            gLeptonReader->mass_[idxLepton],
+            gLeptonReader->pdgId_[idxLepton],
+            gLeptonReader->charge_[idxLepton],
           },
-          true, // Karl: all muon objects pass Muon POG's loose definition at the nanoAOD production level
-          gMuonReader->mediumIdPOG_[idxLepton],
-          gMuonReader->segmentCompatibility_[idxLepton],
-          gMuonReader->ptErr_[idxLepton]
-        }));
-
-        RecoMuon & muon = muons.back();
-        for(const auto & kv: gLeptonReader->jetBtagCSVs_)
-        {
-          const double val = kv.second[idxLepton];
-          muon.jetBtagCSVs_[kv.first] = std::isnan(val) ? -2. : val;
-        }
-        for(const auto & kv: gLeptonReader->assocJetBtagCSVs_)
-        {
-          const double val = kv.second[idxLepton];
-          muon.assocJetBtagCSVs_[kv.first] = std::isnan(val) ? -2. : val;
-        }
-        if(mvaTTH_wp_ > 0.)
-        {
-          muon.set_mvaRawTTH_cut(mvaTTH_wp_);
-        }
+          gLeptonReader->dxy_[idxLepton],
+          gLeptonReader->dz_[idxLepton],
+          gLeptonReader->relIso_all_[idxLepton],
+          gLeptonReader->pfRelIso04_all_[idxLepton],
+          gLeptonReader->relIso_chg_[idxLepton],
+          gLeptonReader->relIso_neu_[idxLepton],
+          gLeptonReader->sip3d_[idxLepton],
+          gLeptonReader->mvaRawTTH_[idxLepton],
+          gLeptonReader->jetPtRatio_[idxLepton],
+          gLeptonReader->jetPtRel_[idxLepton],
+          gLeptonReader->jetNDauChargedMVASel_[idxLepton],
+          gLeptonReader->tightCharge_[idxLepton],
+          gLeptonReader->filterBits_[idxLepton],
+          gLeptonReader->jetIdx_[idxLepton],
+          gLeptonReader->genPartFlav_[idxLepton],
+          gLeptonReader->genMatchIdx_[idxLepton],
+        },
+        true, // Karl: all muon objects pass Muon POG's loose definition at the nanoAOD production level
+        gMuonReader->mediumIdPOG_[idxLepton],
+        gMuonReader->segmentCompatibility_[idxLepton],
+        gMuonReader->ptErr_[idxLepton]
+      }));
+
+      RecoMuon & muon = muons.back();
+      for(const auto & kv: gLeptonReader->jetBtagCSVs_)
+      {
+        const double val = kv.second[idxLepton];
+        muon.set_jetBtagCSV(kv.first, std::isnan(val) ? -2. : val, false);
+      }
+      for(const auto & kv: gLeptonReader->assocJetBtagCSVs_)
+      {
+        const double val = kv.second[idxLepton];
+        muon.set_jetBtagCSV(kv.first, std::isnan(val) ? -2. : val, true);
+      }
+      if(mvaTTH_wp_ > 0.)
+      {
+        muon.set_mvaRawTTH_cut(mvaTTH_wp_);
       }
     }
-    gLeptonReader->readGenMatching(muons);
+    gLeptonReader->readGenMatching(muons, preselectedIdxs_);
   }
+}
+
+std::vector<RecoMuon>
+RecoMuonReader::read() const
+{
+  std::vector<RecoMuon> muons;
+  read(muons);
   return muons;
 }
 
@@ -178,3 +214,16 @@ RecoMuonReader::set_mvaTTH_wp(double mvaTTH_wp)
 {
   mvaTTH_wp_ = mvaTTH_wp;
 }
+
+void
+RecoMuonReader::set_preselection(double min_pt,
+                                 double max_absEta,
+                                 double max_dxy,
+                                 double max_dz)
+{
+  apply_preselection_ = true;
+  preselection_min_pt_ = min_pt;
+  preselection_max_absEta_ = max_absEta;
+  preselection_max_dxy_ = max_dxy;
+  preselection_max_dz_ = max_dz;
+}
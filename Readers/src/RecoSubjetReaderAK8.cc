@@ -8,8 +8,8 @@
 #include "TTree.h"                                                            // TTree
 #include "TString.h"                                                          // Form()
 
-std::map<std::string, int> RecoSubjetReaderAK8::numInstances_;
-std::map<std::string, RecoSubjetReaderAK8 *> RecoSubjetReaderAK8::instances_;
+thread_local std::map<std::string, int> RecoSubjetReaderAK8::numInstances_;
+thread_local std::map<std::string, RecoSubjetReaderAK8 *> RecoSubjetReaderAK8::instances_;
 
 RecoSubjetReaderAK8::RecoSubjetReaderAK8(const edm::ParameterSet & cfg)
   : ReaderBase(cfg)
@@ -6,8 +6,8 @@
 #include "TTree.h"                                                            // TTree
 #include "TString.h"                                                          // Form()
 
-std::map<std::string, int> RecoVertexReader::numInstances_;
-std::map<std::string, RecoVertexReader *> RecoVertexReader::instances_;
+thread_local std::map<std::string, int> RecoVertexReader::numInstances_;
+thread_local std::map<std::string, RecoVertexReader *> RecoVertexReader::instances_;
 
 RecoVertexReader::RecoVertexReader(const edm::ParameterSet & cfg)
   : ReaderBase(cfg)
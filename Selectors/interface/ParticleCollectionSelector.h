@@ -54,6 +54,33 @@ class ParticleCollectionSelector
     return selParticles;
   }
 
+  /**
+   * @brief Same as above, but fill the selected particles into the collection given as third function argument,
+   *        which is cleared first, but keeps its capacity, so that it can be reused for each event without reallocating memory
+   */
+  template <typename T,
+            typename = typename std::enable_if<std::is_base_of<T, Tobj>::value>::type>
+  void
+  operator()(const std::vector<const Tobj *> & particles,
+             bool (*sortFunction)(const T *, const T *),
+             std::vector<const Tobj *> & selParticles) const
+  {
+    selParticles.clear();
+    int idx = 0;
+    for(const Tobj * particle: particles)
+    {
+      if(selector_(*particle))
+      {
+        if(idx == selIndex_ || selIndex_ == -1)
+        {
+          selParticles.push_back(particle);
+        }
+        ++idx;
+      }
+    }
+    std::sort(selParticles.begin(), selParticles.end(), sortFunction);
+  }
+
   Tsel &
   getSelector() 
   {
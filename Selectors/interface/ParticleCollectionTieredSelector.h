@@ -0,0 +1,243 @@
+#ifndef TallinnNtupleProducer_Selectors_ParticleCollectionTieredSelector_h
+#define TallinnNtupleProducer_Selectors_ParticleCollectionTieredSelector_h
+
+#include "TallinnNtupleProducer/Selectors/interface/ParticleCollectionSelector.h" // ParticleCollectionSelector
+
+#include <vector>                                                                 // std::vector
+#include <algorithm>                                                              // std::sort()
+#include <assert.h>                                                               // assert()
+#include <cstddef>                                                                // std::size_t
+
+/**
+ * @brief Particles passing at least one tier of a selection (e.g. loose, fakeable and tight), sorted once,
+ *        together with a bitmask of the tiers passed by each particle: bit k is set if the particle passes the k-th tier.
+ *
+ * The collections of particles passing each tier are derived from the same sorted array of particles,
+ * so that they neither need to be sorted separately nor intersected with each other.
+ */
+template <typename T>
+class TieredParticleCollection
+{
+ public:
+  typedef unsigned char Mask;
+
+  struct Entry
+  {
+    const T * particle_;
+    Mask mask_;
+  };
+
+  /**
+   * @brief Remove all particles (keeping the capacity of the collection)
+   */
+  void
+  clear()
+  {
+    entries_.clear();
+  }
+
+  void
+  push_back(const T * particle,
+            Mask mask)
+  {
+    entries_.push_back({ particle, mask });
+  }
+
+  const std::vector<Entry> &
+  entries() const
+  {
+    return entries_;
+  }
+
+  /**
+   * @brief Sort the particles by given function
+   */
+  template <typename F>
+  void
+  sort(bool (*sortFunction)(const F *, const F *))
+  {
+    std::sort(entries_.begin(), entries_.end(),
+      [sortFunction](const Entry & lhs, const Entry & rhs) -> bool
+      {
+        return sortFunction(lhs.particle_, rhs.particle_);
+      }
+    );
+  }
+
+  /**
+   * @brief Fill the collection with the particles of two collections that are sorted by the given function, keeping the sort order
+   *       (in the typical use-case "lhs" = electrons and "rhs" = muons)
+   */
+  template <typename U,
+            typename V,
+            typename F>
+  void
+  merge(const TieredParticleCollection<U> & lhs_collection,
+        const TieredParticleCollection<V> & rhs_collection,
+        bool (*sortFunction)(const F *, const F *))
+  {
+    const std::vector<typename TieredParticleCollection<U>::Entry> & lhs_entries = lhs_collection.entries();
+    const std::vector<typename TieredParticleCollection<V>::Entry> & rhs_entries = rhs_collection.entries();
+    entries_.clear();
+    entries_.reserve(lhs_entries.size() + rhs_entries.size());
+    auto lhs_entry = lhs_entries.begin();
+    auto rhs_entry = rhs_entries.begin();
+    while(lhs_entry != lhs_entries.end() || rhs_entry != rhs_entries.end())
+    {
+      if(rhs_entry == rhs_entries.end() || (lhs_entry != lhs_entries.end() && ! sortFunction(rhs_entry->particle_, lhs_entry->particle_)))
+      {
+        entries_.push_back({ lhs_entry->particle_, lhs_entry->mask_ });
+        ++lhs_entry;
+      }
+      else
+      {
+        entries_.push_back({ rhs_entry->particle_, rhs_entry->mask_ });
+        ++rhs_entry;
+      }
+    }
+  }
+
+  /**
+   * @brief Return the particles passing the given tier, in sort order
+   *
+   * @note The particles are filled into a buffer kept for each tier, which is reused for all events;
+   *       the returned reference stays valid until the next call to this function for the same tier
+   */
+  const std::vector<const T *> &
+  get(unsigned tier) const
+  {
+    assert(tier < numTiers);
+    const Mask tier_bit = Mask(1) << tier;
+    std::vector<const T *> & selParticles = selParticles_[tier];
+    selParticles.clear();
+    for(const Entry & entry: entries_)
+    {
+      if(entry.mask_ & tier_bit)
+      {
+        selParticles.push_back(entry.particle_);
+      }
+    }
+    return selParticles;
+  }
+
+  /**
+   * @brief Return the particles passing the given tier, amongst the first N particles passing the tier given as third function argument
+   *       (in the typical use-case the tight leptons amongst the N leading fakeable leptons)
+   *
+   * @note The particles are filled into a buffer kept for each tier, separate from the one used by the function above;
+   *       the returned reference stays valid until the next call to this function for the same tier
+   */
+  const std::vector<const T *> &
+  get(unsigned tier,
+      std::size_t N,
+      unsigned tier_firstN) const
+  {
+    assert(tier < numTiers);
+    const Mask tier_bit = Mask(1) << tier;
+    const Mask tier_firstN_bit = Mask(1) << tier_firstN;
+    std::vector<const T *> & selParticles = selParticles_firstN_[tier];
+    selParticles.clear();
+    std::size_t idx = 0;
+    for(const Entry & entry: entries_)
+    {
+      if(idx >= N)
+      {
+        break;
+      }
+      if(entry.mask_ & tier_firstN_bit)
+      {
+        if(entry.mask_ & tier_bit)
+        {
+          selParticles.push_back(entry.particle_);
+        }
+        ++idx;
+      }
+    }
+    return selParticles;
+  }
+
+  static const unsigned numTiers = 8 * sizeof(Mask);
+
+ protected:
+  std::vector<Entry> entries_;
+
+  // CV: buffers are kept between calls to avoid allocating memory for every event,
+  //     so the same instance must not be used by several threads at the same time
+  mutable std::vector<const T *> selParticles_[numTiers];        ///< particles passing each tier, filled by get(tier)
+  mutable std::vector<const T *> selParticles_firstN_[numTiers]; ///< particles passing each tier amongst the first N particles, filled by get(tier, N, tier_firstN)
+};
+
+/**
+ * @brief Apply several tiers of a selection (e.g. loose, fakeable and tight) to a collection of particles in one pass,
+ *        sorting the particles passing at least one tier once.
+ *
+ * If the tiers are nested, each tier is evaluated only for particles passing the previous tier,
+ * as when the collection selectors are applied one after another to the output of the previous selector.
+ * This matters, as the selectors set the isLoose, isFakeable and isTight flags of the particles.
+ */
+template <typename Tobj>
+class ParticleCollectionTieredSelector
+{
+ public:
+  typedef typename TieredParticleCollection<Tobj>::Mask Mask;
+
+  explicit
+  ParticleCollectionTieredSelector(bool nested = true)
+    : nested_(nested)
+  {}
+  ~ParticleCollectionTieredSelector() {}
+
+  /**
+   * @brief Classify the particles given as function argument according to the collection selectors,
+   *        ordered from the loosest to the tightest tier, and fill the passing particles into selParticles
+   *
+   * @note The index given to the collection selectors on construction is not taken into account
+   */
+  template <typename F,
+            typename... Tsels>
+  void
+  operator()(const std::vector<const Tobj *> & particles,
+             bool (*sortFunction)(const F *, const F *),
+             TieredParticleCollection<Tobj> & selParticles,
+             const ParticleCollectionSelector<Tobj, Tsels> &... selectors) const
+  {
+    static_assert(sizeof...(Tsels) <= TieredParticleCollection<Tobj>::numTiers, "Too many tiers");
+    selParticles.clear();
+    for(const Tobj * particle: particles)
+    {
+      const Mask mask = classify(*particle, 0, selectors.getSelector()...);
+      if(mask)
+      {
+        selParticles.push_back(particle, mask);
+      }
+    }
+    selParticles.sort(sortFunction);
+  }
+
+ protected:
+  template <typename Tsel,
+            typename... Tsels>
+  Mask
+  classify(const Tobj & particle,
+           unsigned tier,
+           const Tsel & selector,
+           const Tsels &... selectors) const
+  {
+    if(! selector(particle))
+    {
+      return nested_ ? 0 : classify(particle, tier + 1, selectors...);
+    }
+    return (Mask(1) << tier) | classify(particle, tier + 1, selectors...);
+  }
+
+  Mask
+  classify(const Tobj &,
+           unsigned) const
+  {
+    return 0;
+  }
+
+  bool nested_;
+};
+
+#endif // TallinnNtupleProducer_Selectors_ParticleCollectionTieredSelector_h
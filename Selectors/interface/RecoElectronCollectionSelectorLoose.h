@@ -29,6 +29,8 @@ class RecoElectronSelectorLoose
    */
   double get_min_pt() const;
   double get_max_absEta() const;
+  double get_max_dxy() const;
+  double get_max_dz() const;
 
   /**
    * @brief Check if electron given as function argument passes "loose" electron selection, defined in Table 13 of AN-2015/321
@@ -29,6 +29,18 @@ class RecoHadTauSelectorBase
   double
   get_max_absEta() const;
 
+  double
+  get_max_dz() const;
+
+  bool
+  get_apply_decayModeFinding() const;
+
+  const std::vector<int> &
+  get_decayMode_whitelist() const;
+
+  const std::vector<int> &
+  get_decayMode_blacklist() const;
+
   void
   set_min_id_mva(TauID tauId,
                  int min_id_mva);
@@ -26,6 +26,8 @@ class RecoMuonSelectorLoose
    */
   double get_min_pt() const;
   double get_max_absEta() const;
+  double get_max_dxy() const;
+  double get_max_dz() const;
 
   /**
    * @brief Check if muon given as function argument passes "loose" muon selection, defined in Table 12 of AN-2015/321
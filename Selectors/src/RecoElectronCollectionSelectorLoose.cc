@@ -62,6 +62,18 @@ RecoElectronSelectorLoose::get_max_absEta() const
   return max_absEta_;
 }
 
+double
+RecoElectronSelectorLoose::get_max_dxy() const
+{
+  return max_dxy_;
+}
+
+double
+RecoElectronSelectorLoose::get_max_dz() const
+{
+  return max_dz_;
+}
+
 void
 RecoElectronSelectorLoose::print_selection_conditions()
 {
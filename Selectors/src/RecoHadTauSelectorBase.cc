@@ -58,6 +58,30 @@ RecoHadTauSelectorBase::get_max_absEta() const
   return max_absEta_;
 }
 
+double
+RecoHadTauSelectorBase::get_max_dz() const
+{
+  return max_dz_;
+}
+
+bool
+RecoHadTauSelectorBase::get_apply_decayModeFinding() const
+{
+  return apply_decayModeFinding_;
+}
+
+const std::vector<int> &
+RecoHadTauSelectorBase::get_decayMode_whitelist() const
+{
+  return decayMode_whitelist_;
+}
+
+const std::vector<int> &
+RecoHadTauSelectorBase::get_decayMode_blacklist() const
+{
+  return decayMode_blacklist_;
+}
+
 void
 RecoHadTauSelectorBase::set_min_id_mva(TauID tauId,
                                        int min_id_mva)
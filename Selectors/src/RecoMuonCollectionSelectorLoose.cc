@@ -45,6 +45,18 @@ RecoMuonSelectorLoose::get_max_absEta() const
   return max_absEta_;
 }
 
+double
+RecoMuonSelectorLoose::get_max_dxy() const
+{
+  return max_dxy_;
+}
+
+double
+RecoMuonSelectorLoose::get_max_dz() const
+{
+  return max_dz_;
+}
+
 bool
 RecoMuonSelectorLoose::operator()(const RecoMuon & muon) const
 {
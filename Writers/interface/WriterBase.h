@@ -3,10 +3,14 @@
 
 #include "FWCore/ParameterSet/interface/ParameterSet.h"                       // edm::ParameterSet
 
+#include "TallinnNtupleProducer/CommonTools/interface/SysIdRegistry.h"        // SysId
 #include "TallinnNtupleProducer/EvtWeightTools/interface/EvtWeightRecorder.h" // EvtWeightRecorder
 #include "TallinnNtupleProducer/Objects/interface/Event.h"                    // Event
 
+#include <assert.h>                                                           // assert()
+#include <map>                                                                // std::map
 #include <string>                                                             // std::string
+#include <vector>                                                             // std::vector
 
 // forward declarations
 class TTree;
@@ -42,6 +46,16 @@ class WriterBase
   void
   set_central_or_shift(const std::string & central_or_shift) const;
 
+  /**
+   * @brief Same as above, for systematic shifts resolved by a SysIdRegistry.
+   *        Whether or not the writer supports the systematic shift is determined on the first call for each SysId and cached,
+   *        so that no systematic shift names need to be compared in the event loop.
+   *        Writer plugins that override the function above need to override this function, too.
+   */
+  virtual
+  void
+  set_central_or_shift(const SysId & sysId) const;
+
   /**
    * @brief Write relevant information to tree
    */
@@ -54,8 +68,47 @@ class WriterBase
   void
   writeImp(const Event & event, const EvtWeightRecorder & evtWeightRecorder) = 0;
 
+  /**
+   * @brief Return name of the systematic shift set by the last call to set_central_or_shift
+   */
+  const std::string &
+  get_current_central_or_shift() const;
+
+  /**
+   * @brief Return entry for given systematic shift in the map of branch buffers kept by the writer plugin (nullptr if the systematic shift is not supported).
+   *        The map is searched on the first call for each SysId only, the result is cached in the vector given as second function argument.
+   *        This function needs to be called after WriterBase::set_central_or_shift(const SysId &).
+   */
+  template <typename T>
+  T *
+  get_central_or_shiftEntry(const std::map<std::string, T> & central_or_shiftEntries,
+                            std::vector<T *> & central_or_shiftEntries_bySysId,
+                            const SysId & sysId) const
+  {
+    assert(sysId.idx < isSupported_.size() && isSupported_[sysId.idx] != -1);
+    if ( ! isSupported_[sysId.idx] )
+    {
+      return nullptr;
+    }
+    if ( sysId.idx >= central_or_shiftEntries_bySysId.size() )
+    {
+      central_or_shiftEntries_bySysId.resize(sysId.idx + 1, nullptr);
+    }
+    if ( ! central_or_shiftEntries_bySysId[sysId.idx] )
+    {
+      auto it = central_or_shiftEntries.find(sysId.central_or_shift);
+      assert(it != central_or_shiftEntries.end());
+      central_or_shiftEntries_bySysId[sysId.idx] = const_cast<T *>(&it->second);
+    }
+    return central_or_shiftEntries_bySysId[sysId.idx];
+  }
+
   std::vector<std::string> supported_systematics_;
-  mutable std::string current_central_or_shift_;
+  mutable std::string current_central_or_shift_; ///< set only if the systematic shift has been set by name
+  mutable const SysId * current_sysId_;          ///< SysId owned by the SysIdRegistry (nullptr if the systematic shift has been set by name)
+  mutable bool current_isSupported_;
+
+  mutable std::vector<int> isSupported_; ///< cache of supported systematic shifts, indexed by SysId::idx (-1 = not yet determined, 0 = not supported, 1 = supported)
 };
 
 #include "FWCore/PluginManager/interface/PluginFactory.h"  // edmplugin::PluginFactory
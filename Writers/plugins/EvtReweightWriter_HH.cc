@@ -65,18 +65,31 @@ EvtReweightWriter_HH::writeImp(const Event & event, const EvtWeightRecorder & ev
   const AnalysisConfig& analysisConfig = eventInfo.analysisConfig();
   if ( analysisConfig.isMC_HH_nonresonant() && analysisConfig.isHH_rwgt_allowed() && (apply_HH_rwgt_lo_ || apply_HH_rwgt_nlo_) )
   {
-    for ( auto bmName : bmNames_ )
+    if ( apply_HH_rwgt_lo_ )
+    {
+      // CV: compute LO reweights for all coupling scenarios at once
+      assert(hhWeightInterfaceLO_);
+      hhWeightInterfaceLO_->getRelativeWeights(eventInfo.gen_mHH, eventInfo.gen_cosThetaStar, hhReweights_lo_);
+      assert(hhReweights_lo_.size() == bmNames_.size());
+    }
+    if ( apply_HH_rwgt_nlo_ )
+    {
+      // CV: compute NLO reweights for all coupling scenarios at once
+      assert(hhWeightInterfaceNLO_);
+      hhWeightInterfaceNLO_->getRelativeWeights_LOtoNLO(eventInfo.gen_mHH, eventInfo.gen_cosThetaStar, hhReweights_nlo_);
+      assert(hhReweights_nlo_.size() == bmNames_.size());
+    }
+    for ( size_t idxBM = 0; idxBM < bmNames_.size(); ++idxBM )
     {
+      const std::string & bmName = bmNames_[idxBM];
       double hhReweight = 1.;
       if ( apply_HH_rwgt_lo_ )
       {
-        assert(hhWeightInterfaceLO_);
-        hhReweight = hhWeightInterfaceLO_->getRelativeWeight(bmName, eventInfo.gen_mHH, eventInfo.gen_cosThetaStar);
+        hhReweight = hhReweights_lo_[idxBM];
       }
       if ( apply_HH_rwgt_nlo_ )
       {
-        assert(hhWeightInterfaceNLO_);
-        hhReweight *= hhWeightInterfaceNLO_->getRelativeWeight_LOtoNLO(bmName, eventInfo.gen_mHH, eventInfo.gen_cosThetaStar);
+        hhReweight *= hhReweights_nlo_[idxBM];
       }
       hhReweights_[bmName] = hhReweight;
     }
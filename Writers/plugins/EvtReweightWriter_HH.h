@@ -52,6 +52,8 @@ class EvtReweightWriter_HH : public WriterBase
   HHWeightInterfaceNLO * hhWeightInterfaceNLO_;
 
   std::vector<std::string> bmNames_;
+  std::vector<double> hhReweights_lo_;  // LO reweights, in the same order as bmNames_
+  std::vector<double> hhReweights_nlo_; // LO-to-NLO reweights, in the same order as bmNames_
   
   bool apply_HH_rwgt_lo_;
   bool apply_HH_rwgt_nlo_;
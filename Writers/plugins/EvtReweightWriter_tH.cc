@@ -41,7 +41,7 @@ EvtReweightWriter_tH::writeImp(const Event & event, const EvtWeightRecorder & ev
   const EventInfo& eventInfo = event.eventInfo();
   if ( eventInfo.analysisConfig().isMC_tH() && !tHweights_.empty() )
   {
-    const std::string central_or_shift_tH = eventInfo.has_central_or_shift(current_central_or_shift_) ? current_central_or_shift_ : "central";
+    const std::string central_or_shift_tH = eventInfo.has_central_or_shift(get_current_central_or_shift()) ? get_current_central_or_shift() : "central";
     eventInfo.set_central_or_shift(central_or_shift_tH);
     if ( !eventInfo_isInitialized_ )
     {
@@ -58,15 +58,27 @@ EvtWeightWriter::set_central_or_shift(const std::string & central_or_shift) cons
   {
     current_central_or_shiftEntry_ = const_cast<central_or_shiftEntry *>(&it->second);
   }
-  else throw cmsException(__func__, __LINE__) 
-    << "Invalid systematic shift = '" << central_or_shift << "' !!";
+  else
+  {
+    // CV: systematic shift not supported by this writer plugin;
+    //     WriterBase::write will skip the call to writeImp in this case
+    current_central_or_shiftEntry_ = nullptr;
+  }
+}
+
+void
+EvtWeightWriter::set_central_or_shift(const SysId & sysId) const
+{
+  WriterBase::set_central_or_shift(sysId);
+  current_central_or_shiftEntry_ = get_central_or_shiftEntry(central_or_shiftEntries_, central_or_shiftEntries_bySysId_, sysId);
 }
 
 void
 EvtWeightWriter::writeImp(const Event & event, const EvtWeightRecorder & evtWeightRecorder)
 {
   assert(current_central_or_shiftEntry_);
-  current_central_or_shiftEntry_->evtWeight_ = evtWeightRecorder.get(current_central_or_shift_);
+  current_central_or_shiftEntry_->evtWeight_ = current_sysId_ ?
+    evtWeightRecorder.get(*current_sysId_) : evtWeightRecorder.get(current_central_or_shift_);
 }
 
 std::vector<std::string>
@@ -32,6 +32,12 @@ class EvtWeightWriter : public WriterBase
   void
   set_central_or_shift(const std::string & central_or_shift) const;
 
+  /**
+   * @brief Same as above, for systematic shifts resolved by a SysIdRegistry
+   */
+  void
+  set_central_or_shift(const SysId & sysId) const;
+
   /**
    * @brief Return list of systematic uncertainties supported by this plugin
    */
@@ -51,6 +57,7 @@ class EvtWeightWriter : public WriterBase
   };
   std::map<std::string, central_or_shiftEntry> central_or_shiftEntries_; // key = central_or_shift
   mutable central_or_shiftEntry * current_central_or_shiftEntry_;
+  mutable std::vector<central_or_shiftEntry *> central_or_shiftEntries_bySysId_; ///< cache of entries of central_or_shiftEntries_, indexed by SysId::idx
 };
 
 #endif // TallinnNtupleProducer_Writers_EvtWeightWriter_h
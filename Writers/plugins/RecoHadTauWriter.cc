@@ -10,16 +10,19 @@
 #include "TString.h"                                                             // Form()
 #include "TTree.h"                                                               // TTree
 
+#include <algorithm>                                                             // std::min()
 #include <assert.h>                                                              // assert()
 
 RecoHadTauWriter::RecoHadTauWriter(const edm::ParameterSet & cfg)
   : WriterBase(cfg)
   , branchName_num_("ntau")
   , branchName_obj_("tau")
+  , writeJaggedArrays_(false)
   , current_central_or_shiftEntry_(nullptr)
 {
   max_nHadTaus_ = cfg.getParameter<unsigned>("numNominalHadTaus");
   assert(max_nHadTaus_ >= 1);
+  writeJaggedArrays_ = cfg.exists("writeJaggedArrays") ? cfg.getParameter<bool>("writeJaggedArrays") : false;
   merge_systematic_shifts(supported_systematics_, RecoHadTauWriter::get_supported_systematics());
   merge_systematic_shifts(supported_systematics_, { "central" }); // CV: add central value
   for ( auto central_or_shift : supported_systematics_ )
@@ -74,40 +77,59 @@ namespace
     if ( central_or_shift == "central" ) return Form("%s%i_%s",    branchName_obj.data(), (int)idx, suffix.data());
     else                                 return Form("%s%i_%s_%s", branchName_obj.data(), (int)idx, central_or_shift.data(), suffix.data());
   }
+  std::string
+  get_branchName_array(const std::string & branchName_obj, const std::string & suffix, const std::string & central_or_shift)
+  {
+    if ( central_or_shift == "central" ) return Form("%s_%s",    branchName_obj.data(), suffix.data());
+    else                                 return Form("%s_%s_%s", branchName_obj.data(), central_or_shift.data(), suffix.data());
+  }
 }
 
 void
 RecoHadTauWriter::setBranches(TTree * outputTree)
 {
-std::cout << "<RecoHadTauWriter::setBranches>:" << std::endl;
-std::cout << "break-point B.1 reached" << std::endl;
   BranchAddressInitializer bai(outputTree);
-std::cout << "break-point B.2 reached" << std::endl;
   for ( auto central_or_shift : supported_systematics_ )
   {
-std::cout << "break-point B.3 reached" << std::endl;
     auto it = central_or_shiftEntries_.find(central_or_shift);
     assert(it != central_or_shiftEntries_.end());
-    bai.setBranch(it->second.nHadTaus_, get_branchName_num(branchName_num_, central_or_shift));
-    for ( size_t idxHadTau = 0; idxHadTau < it->second.nHadTaus_; ++idxHadTau )
+    const std::string branchName_num = get_branchName_num(branchName_num_, central_or_shift);
+    bai.setBranch(it->second.nHadTaus_, branchName_num);
+    if ( writeJaggedArrays_ )
     {
-std::cout << "break-point B.4 reached" << std::endl;
-      bai.setBranch(it->second.pt_[idxHadTau], get_branchName_obj(branchName_obj_, (int)idxHadTau, "pt", central_or_shift));
-      bai.setBranch(it->second.eta_[idxHadTau], get_branchName_obj(branchName_obj_, (int)idxHadTau, "eta", central_or_shift));
-      bai.setBranch(it->second.phi_[idxHadTau], get_branchName_obj(branchName_obj_, (int)idxHadTau, "phi", central_or_shift));
-      bai.setBranch(it->second.mass_[idxHadTau], get_branchName_obj(branchName_obj_, (int)idxHadTau, "mass", central_or_shift));
-      bai.setBranch(it->second.decayMode_[idxHadTau], get_branchName_obj(branchName_obj_, (int)idxHadTau, "decayMode", central_or_shift));
-      bai.setBranch(it->second.charge_[idxHadTau], get_branchName_obj(branchName_obj_, (int)idxHadTau, "charge", central_or_shift));
-      bai.setBranch(it->second.isFakeable_[idxHadTau], get_branchName_obj(branchName_obj_, (int)idxHadTau, "isFakeable", central_or_shift));
-      bai.setBranch(it->second.isTight_[idxHadTau], get_branchName_obj(branchName_obj_, (int)idxHadTau, "isTight", central_or_shift));    
-      bai.setBranch(it->second.genMatch_[idxHadTau], get_branchName_obj(branchName_obj_, (int)idxHadTau, "genMatch", central_or_shift));
-      bai.setBranch(it->second.isFake_[idxHadTau], get_branchName_obj(branchName_obj_, (int)idxHadTau, "isFake", central_or_shift));  
-      bai.setBranch(it->second.isFlip_[idxHadTau], get_branchName_obj(branchName_obj_, (int)idxHadTau, "isFlip", central_or_shift));  
-std::cout << "break-point B.5 reached" << std::endl;
+      // CV: the length of the arrays is given by the branch that stores the number of hadronic taus;
+      //     the arrays are owned by this writer plugin, so BranchAddressInitializer must not allocate them (lenVar = -1)
+      BranchAddressInitializer bai_array(outputTree, -1, branchName_num);
+      bai_array.setBranch(it->second.pt_, get_branchName_array(branchName_obj_, "pt", central_or_shift));
+      bai_array.setBranch(it->second.eta_, get_branchName_array(branchName_obj_, "eta", central_or_shift));
+      bai_array.setBranch(it->second.phi_, get_branchName_array(branchName_obj_, "phi", central_or_shift));
+      bai_array.setBranch(it->second.mass_, get_branchName_array(branchName_obj_, "mass", central_or_shift));
+      bai_array.setBranch(it->second.decayMode_, get_branchName_array(branchName_obj_, "decayMode", central_or_shift));
+      bai_array.setBranch(it->second.charge_, get_branchName_array(branchName_obj_, "charge", central_or_shift));
+      bai_array.setBranch(it->second.isFakeable_, get_branchName_array(branchName_obj_, "isFakeable", central_or_shift));
+      bai_array.setBranch(it->second.isTight_, get_branchName_array(branchName_obj_, "isTight", central_or_shift));
+      bai_array.setBranch(it->second.genMatch_, get_branchName_array(branchName_obj_, "genMatch", central_or_shift));
+      bai_array.setBranch(it->second.isFake_, get_branchName_array(branchName_obj_, "isFake", central_or_shift));
+      bai_array.setBranch(it->second.isFlip_, get_branchName_array(branchName_obj_, "isFlip", central_or_shift));
+    }
+    else
+    {
+      for ( size_t idxHadTau = 0; idxHadTau < max_nHadTaus_; ++idxHadTau )
+      {
+        bai.setBranch(it->second.pt_[idxHadTau], get_branchName_obj(branchName_obj_, (int)idxHadTau, "pt", central_or_shift));
+        bai.setBranch(it->second.eta_[idxHadTau], get_branchName_obj(branchName_obj_, (int)idxHadTau, "eta", central_or_shift));
+        bai.setBranch(it->second.phi_[idxHadTau], get_branchName_obj(branchName_obj_, (int)idxHadTau, "phi", central_or_shift));
+        bai.setBranch(it->second.mass_[idxHadTau], get_branchName_obj(branchName_obj_, (int)idxHadTau, "mass", central_or_shift));
+        bai.setBranch(it->second.decayMode_[idxHadTau], get_branchName_obj(branchName_obj_, (int)idxHadTau, "decayMode", central_or_shift));
+        bai.setBranch(it->second.charge_[idxHadTau], get_branchName_obj(branchName_obj_, (int)idxHadTau, "charge", central_or_shift));
+        bai.setBranch(it->second.isFakeable_[idxHadTau], get_branchName_obj(branchName_obj_, (int)idxHadTau, "isFakeable", central_or_shift));
+        bai.setBranch(it->second.isTight_[idxHadTau], get_branchName_obj(branchName_obj_, (int)idxHadTau, "isTight", central_or_shift));    
+        bai.setBranch(it->second.genMatch_[idxHadTau], get_branchName_obj(branchName_obj_, (int)idxHadTau, "genMatch", central_or_shift));
+        bai.setBranch(it->second.isFake_[idxHadTau], get_branchName_obj(branchName_obj_, (int)idxHadTau, "isFake", central_or_shift));  
+        bai.setBranch(it->second.isFlip_[idxHadTau], get_branchName_obj(branchName_obj_, (int)idxHadTau, "isFlip", central_or_shift));  
+      }
     }
-std::cout << "break-point B.6 reached" << std::endl;
   }
-std::cout << "break-point B.7 reached" << std::endl;
 }
 
 void
@@ -119,8 +141,19 @@ RecoHadTauWriter::set_central_or_shift(const std::string & central_or_shift) con
   {
     current_central_or_shiftEntry_ = const_cast<central_or_shiftEntry *>(&it->second);
   }
-  else throw cmsException(__func__, __LINE__) 
-    << "Invalid systematic shift = '" << central_or_shift << "' !!";
+  else
+  {
+    // CV: systematic shift not supported by this writer plugin;
+    //     WriterBase::write will skip the call to writeImp in this case
+    current_central_or_shiftEntry_ = nullptr;
+  }
+}
+
+void
+RecoHadTauWriter::set_central_or_shift(const SysId & sysId) const
+{
+  WriterBase::set_central_or_shift(sysId);
+  current_central_or_shiftEntry_ = get_central_or_shiftEntry(central_or_shiftEntries_, central_or_shiftEntries_bySysId_, sysId);
 }
 
 namespace
@@ -159,6 +192,11 @@ RecoHadTauWriter::writeImp(const Event & event, const EvtWeightRecorder & evtWei
   const RecoHadTauPtrCollection& hadTaus = event.fakeableHadTaus();
   auto it = current_central_or_shiftEntry_;
   it->nHadTaus_ = hadTaus.size();
+  if ( writeJaggedArrays_ )
+  {
+    // CV: number of hadronic taus is used as length of the arrays and hence must not exceed the size of the arrays
+    it->nHadTaus_ = std::min(it->nHadTaus_, max_nHadTaus_);
+  }
   for ( size_t idxHadTau = 0; idxHadTau < max_nHadTaus_; ++idxHadTau )
   {
     if ( idxHadTau < it->nHadTaus_ )
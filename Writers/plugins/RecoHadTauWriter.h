@@ -31,6 +31,12 @@ class RecoHadTauWriter : public WriterBase
    */
   void
   set_central_or_shift(const std::string & central_or_shift) const;
+
+  /**
+   * @brief Same as above, for systematic shifts resolved by a SysIdRegistry
+   */
+  void
+  set_central_or_shift(const SysId & sysId) const;
  
   /**
     * @brief Return list of systematic uncertainties supported by this plugin
@@ -50,6 +56,7 @@ class RecoHadTauWriter : public WriterBase
   std::string branchName_obj_;
 
   UInt_t max_nHadTaus_;
+  bool writeJaggedArrays_; ///< write each variable as one variable-length array (tau_pt[ntau]) instead of one branch per hadronic tau
 
   struct central_or_shiftEntry
   {
@@ -79,6 +86,7 @@ class RecoHadTauWriter : public WriterBase
   };
   std::map<std::string, central_or_shiftEntry> central_or_shiftEntries_; // key = central_or_shift
   mutable central_or_shiftEntry * current_central_or_shiftEntry_;
+  mutable std::vector<central_or_shiftEntry *> central_or_shiftEntries_bySysId_; ///< cache of entries of central_or_shiftEntries_, indexed by SysId::idx
 };
 
 #endif // TallinnNtupleProducer_Writers_RecoHadTauWriter_h
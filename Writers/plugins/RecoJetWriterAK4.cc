@@ -10,6 +10,7 @@
 #include "TString.h"                                                             // Form()
 #include "TTree.h"                                                               // TTree
 
+#include <algorithm>                                                             // std::min()
 #include <assert.h>                                                              // assert()
 
 RecoJetWriterAK4::RecoJetWriterAK4(const edm::ParameterSet & cfg)
@@ -17,6 +18,7 @@ RecoJetWriterAK4::RecoJetWriterAK4(const edm::ParameterSet & cfg)
   , jetCollection_(JetCollection::kUndefined)
   , branchName_num_("")
   , branchName_obj_("")
+  , writeJaggedArrays_(false)
   , current_central_or_shiftEntry_(nullptr)
 {
   std::string jetCollection_string = cfg.getParameter<std::string>("jetCollection");
@@ -25,10 +27,11 @@ RecoJetWriterAK4::RecoJetWriterAK4(const edm::ParameterSet & cfg)
   else if ( jetCollection_string == "selJetsAK4_btagMedium()" ) jetCollection_ = JetCollection::kSelJetsAK4_btagMedium;
   else throw cmsException(__func__, __LINE__) 
     << "Invalid Configuration parameter 'jetCollection' = " << jetCollection_string;
-  branchName_obj_ = cfg.getParameter<unsigned>("branchName");
+  branchName_obj_ = cfg.getParameter<std::string>("branchName");
   branchName_num_ = Form("n%s", branchName_obj_.data());
   max_nJets_ = cfg.getParameter<unsigned>("max_numJets");
   assert(max_nJets_ >= 1);
+  writeJaggedArrays_ = cfg.exists("writeJaggedArrays") ? cfg.getParameter<bool>("writeJaggedArrays") : false;
   merge_systematic_shifts(supported_systematics_, RecoJetWriterAK4::get_supported_systematics());
   merge_systematic_shifts(supported_systematics_, { "central" }); // CV: add central value
   for ( auto central_or_shift : supported_systematics_ )
@@ -81,6 +84,12 @@ namespace
     if ( central_or_shift == "central" ) return Form("%s%i_%s",    branchName_obj.data(), (int)idx, suffix.data());
     else                                 return Form("%s%i_%s_%s", branchName_obj.data(), (int)idx, central_or_shift.data(), suffix.data());
   }
+  std::string
+  get_branchName_array(const std::string & branchName_obj, const std::string & suffix, const std::string & central_or_shift)
+  {
+    if ( central_or_shift == "central" ) return Form("%s_%s",    branchName_obj.data(), suffix.data());
+    else                                 return Form("%s_%s_%s", branchName_obj.data(), central_or_shift.data(), suffix.data());
+  }
 }
 
 void
@@ -91,19 +100,39 @@ RecoJetWriterAK4::setBranches(TTree * outputTree)
   {
     auto it = central_or_shiftEntries_.find(central_or_shift);
     assert(it != central_or_shiftEntries_.end());
-    bai.setBranch(it->second.nJets_, get_branchName_num(branchName_num_, central_or_shift));
-    for ( size_t idxJet = 0; idxJet < it->second.nJets_; ++idxJet )
+    const std::string branchName_num = get_branchName_num(branchName_num_, central_or_shift);
+    bai.setBranch(it->second.nJets_, branchName_num);
+    if ( writeJaggedArrays_ )
+    {
+      // CV: the length of the arrays is given by the branch that stores the number of jets;
+      //     the arrays are owned by this writer plugin, so BranchAddressInitializer must not allocate them (lenVar = -1)
+      BranchAddressInitializer bai_array(outputTree, -1, branchName_num);
+      bai_array.setBranch(it->second.pt_, get_branchName_array(branchName_obj_, "pt", central_or_shift));
+      bai_array.setBranch(it->second.eta_, get_branchName_array(branchName_obj_, "eta", central_or_shift));
+      bai_array.setBranch(it->second.phi_, get_branchName_array(branchName_obj_, "phi", central_or_shift));
+      bai_array.setBranch(it->second.mass_, get_branchName_array(branchName_obj_, "mass", central_or_shift));
+      bai_array.setBranch(it->second.charge_, get_branchName_array(branchName_obj_, "charge", central_or_shift));
+      bai_array.setBranch(it->second.qgDiscr_, get_branchName_array(branchName_obj_, "qgDiscr", central_or_shift));
+      bai_array.setBranch(it->second.bRegCorr_, get_branchName_array(branchName_obj_, "bRegCorr", central_or_shift));
+      bai_array.setBranch(it->second.jetId_, get_branchName_array(branchName_obj_, "jetId", central_or_shift));
+      bai_array.setBranch(it->second.puId_, get_branchName_array(branchName_obj_, "puId", central_or_shift));
+      bai_array.setBranch(it->second.genMatch_, get_branchName_array(branchName_obj_, "genMatch", central_or_shift));
+    }
+    else
     {
-      bai.setBranch(it->second.pt_[idxJet], get_branchName_obj(branchName_obj_, (int)idxJet, "pt", central_or_shift));
-      bai.setBranch(it->second.eta_[idxJet], get_branchName_obj(branchName_obj_, (int)idxJet, "eta", central_or_shift));
-      bai.setBranch(it->second.phi_[idxJet], get_branchName_obj(branchName_obj_, (int)idxJet, "phi", central_or_shift));
-      bai.setBranch(it->second.mass_[idxJet], get_branchName_obj(branchName_obj_, (int)idxJet, "mass", central_or_shift));
-      bai.setBranch(it->second.charge_[idxJet], get_branchName_obj(branchName_obj_, (int)idxJet, "charge", central_or_shift));
-      bai.setBranch(it->second.qgDiscr_[idxJet], get_branchName_obj(branchName_obj_, (int)idxJet, "qgDiscr", central_or_shift));
-      bai.setBranch(it->second.bRegCorr_[idxJet], get_branchName_obj(branchName_obj_, (int)idxJet, "bRegCorr", central_or_shift));  
-      bai.setBranch(it->second.jetId_[idxJet], get_branchName_obj(branchName_obj_, (int)idxJet, "jetId", central_or_shift));
-      bai.setBranch(it->second.puId_[idxJet], get_branchName_obj(branchName_obj_, (int)idxJet, "puId", central_or_shift));  
-      bai.setBranch(it->second.genMatch_[idxJet], get_branchName_obj(branchName_obj_, (int)idxJet, "genMatch", central_or_shift));
+      for ( size_t idxJet = 0; idxJet < max_nJets_; ++idxJet )
+      {
+        bai.setBranch(it->second.pt_[idxJet], get_branchName_obj(branchName_obj_, (int)idxJet, "pt", central_or_shift));
+        bai.setBranch(it->second.eta_[idxJet], get_branchName_obj(branchName_obj_, (int)idxJet, "eta", central_or_shift));
+        bai.setBranch(it->second.phi_[idxJet], get_branchName_obj(branchName_obj_, (int)idxJet, "phi", central_or_shift));
+        bai.setBranch(it->second.mass_[idxJet], get_branchName_obj(branchName_obj_, (int)idxJet, "mass", central_or_shift));
+        bai.setBranch(it->second.charge_[idxJet], get_branchName_obj(branchName_obj_, (int)idxJet, "charge", central_or_shift));
+        bai.setBranch(it->second.qgDiscr_[idxJet], get_branchName_obj(branchName_obj_, (int)idxJet, "qgDiscr", central_or_shift));
+        bai.setBranch(it->second.bRegCorr_[idxJet], get_branchName_obj(branchName_obj_, (int)idxJet, "bRegCorr", central_or_shift));  
+        bai.setBranch(it->second.jetId_[idxJet], get_branchName_obj(branchName_obj_, (int)idxJet, "jetId", central_or_shift));
+        bai.setBranch(it->second.puId_[idxJet], get_branchName_obj(branchName_obj_, (int)idxJet, "puId", central_or_shift));  
+        bai.setBranch(it->second.genMatch_[idxJet], get_branchName_obj(branchName_obj_, (int)idxJet, "genMatch", central_or_shift));
+      }
     }
   }
 }
@@ -117,8 +146,19 @@ RecoJetWriterAK4::set_central_or_shift(const std::string & central_or_shift) con
   {
     current_central_or_shiftEntry_ = const_cast<central_or_shiftEntry *>(&it->second);
   }
-  else throw cmsException(__func__, __LINE__) 
-    << "Invalid systematic shift = '" << central_or_shift << "' !!";
+  else
+  {
+    // CV: systematic shift not supported by this writer plugin;
+    //     WriterBase::write will skip the call to writeImp in this case
+    current_central_or_shiftEntry_ = nullptr;
+  }
+}
+
+void
+RecoJetWriterAK4::set_central_or_shift(const SysId & sysId) const
+{
+  WriterBase::set_central_or_shift(sysId);
+  current_central_or_shiftEntry_ = get_central_or_shiftEntry(central_or_shiftEntries_, central_or_shiftEntries_bySysId_, sysId);
 }
 
 namespace
@@ -154,6 +194,11 @@ RecoJetWriterAK4::writeImp(const Event & event, const EvtWeightRecorder & evtWei
   else assert(0);
   auto it = current_central_or_shiftEntry_;
   it->nJets_ = jets->size();
+  if ( writeJaggedArrays_ )
+  {
+    // CV: number of jets is used as length of the arrays and hence must not exceed the size of the arrays
+    it->nJets_ = std::min(it->nJets_, max_nJets_);
+  }
   for ( size_t idxJet = 0; idxJet < max_nJets_; ++idxJet )
   {
     if ( idxJet < it->nJets_ )
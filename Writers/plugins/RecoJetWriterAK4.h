@@ -31,6 +31,12 @@ class RecoJetWriterAK4 : public WriterBase
    */
   void
   set_central_or_shift(const std::string & central_or_shift) const;
+
+  /**
+   * @brief Same as above, for systematic shifts resolved by a SysIdRegistry
+   */
+  void
+  set_central_or_shift(const SysId & sysId) const;
  
   /**
     * @brief Return list of systematic uncertainties supported by this plugin
@@ -52,6 +58,7 @@ class RecoJetWriterAK4 : public WriterBase
   std::string branchName_obj_;
 
   UInt_t max_nJets_;
+  bool writeJaggedArrays_; ///< write each variable as one variable-length array (jet_pt[njet]) instead of one branch per jet
 
   struct central_or_shiftEntry
   {
@@ -78,6 +85,7 @@ class RecoJetWriterAK4 : public WriterBase
   };
   std::map<std::string, central_or_shiftEntry> central_or_shiftEntries_; // key = central_or_shift
   mutable central_or_shiftEntry * current_central_or_shiftEntry_;
+  mutable std::vector<central_or_shiftEntry *> central_or_shiftEntries_bySysId_; ///< cache of entries of central_or_shiftEntries_, indexed by SysId::idx
 };
 
 #endif // TallinnNtupleProducer_Writers_RecoJetWriterAK4_h
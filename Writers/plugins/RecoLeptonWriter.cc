@@ -9,15 +9,19 @@
 #include "TString.h"                                                          // Form()
 #include "TTree.h"                                                            // TTree
 
+#include <algorithm>                                                          // std::min()
 #include <assert.h>                                                           // assert()
 
 RecoLeptonWriter::RecoLeptonWriter(const edm::ParameterSet & cfg)
   : WriterBase(cfg)
   , branchName_num_("nlep")
   , branchName_obj_("lep")
+  , writeJaggedArrays_(false)
+  , nLeptons_(0)
 {
   max_nLeptons_ = cfg.getParameter<unsigned>("numNominalLeptons");
   assert(max_nLeptons_ >= 1);
+  writeJaggedArrays_ = cfg.exists("writeJaggedArrays") ? cfg.getParameter<bool>("writeJaggedArrays") : false;
   pt_ = new Float_t[max_nLeptons_];
   eta_ = new Float_t[max_nLeptons_];
   phi_ = new Float_t[max_nLeptons_];
@@ -55,21 +59,43 @@ RecoLeptonWriter::setBranches(TTree * outputTree)
 {
   BranchAddressInitializer bai(outputTree);
   bai.setBranch(nLeptons_, branchName_num_);
-  for ( size_t idxLepton = 0; idxLepton < nLeptons_; ++idxLepton )
+  if ( writeJaggedArrays_ )
   {
-    bai.setBranch(pt_[idxLepton], Form("%s%i_%s", branchName_obj_.data(), (int)idxLepton, "pt"));
-    bai.setBranch(eta_[idxLepton], Form("%s%i_%s", branchName_obj_.data(), (int)idxLepton, "eta"));
-    bai.setBranch(phi_[idxLepton], Form("%s%i_%s", branchName_obj_.data(), (int)idxLepton, "phi"));
-    bai.setBranch(mass_[idxLepton], Form("%s%i_%s", branchName_obj_.data(), (int)idxLepton, "mass"));
-    bai.setBranch(pdgId_[idxLepton], Form("%s%i_%s", branchName_obj_.data(), (int)idxLepton, "pdgId"));
-    bai.setBranch(charge_[idxLepton], Form("%s%i_%s", branchName_obj_.data(), (int)idxLepton, "charge"));
-    bai.setBranch(mvaRawTTH_[idxLepton], Form("%s%i_%s", branchName_obj_.data(), (int)idxLepton, "mvaRawTTH"));
-    bai.setBranch(isFakeable_[idxLepton], Form("%s%i_%s", branchName_obj_.data(), (int)idxLepton, "isFakeable"));
-    bai.setBranch(isTight_[idxLepton], Form("%s%i_%s", branchName_obj_.data(), (int)idxLepton, "isTight"));    
-    bai.setBranch(tightCharge_[idxLepton], Form("%s%i_%s", branchName_obj_.data(), (int)idxLepton, "tightCharge"));
-    bai.setBranch(genMatch_[idxLepton], Form("%s%i_%s", branchName_obj_.data(), (int)idxLepton, "genMatch"));
-    bai.setBranch(isFake_[idxLepton], Form("%s%i_%s", branchName_obj_.data(), (int)idxLepton, "isFake"));
-    bai.setBranch(isFlip_[idxLepton], Form("%s%i_%s", branchName_obj_.data(), (int)idxLepton, "isFlip"));
+    // CV: the length of the arrays is given by the branch that stores the number of leptons;
+    //     the arrays are owned by this writer plugin, so BranchAddressInitializer must not allocate them (lenVar = -1)
+    BranchAddressInitializer bai_array(outputTree, -1, branchName_num_);
+    bai_array.setBranch(pt_, Form("%s_%s", branchName_obj_.data(), "pt"));
+    bai_array.setBranch(eta_, Form("%s_%s", branchName_obj_.data(), "eta"));
+    bai_array.setBranch(phi_, Form("%s_%s", branchName_obj_.data(), "phi"));
+    bai_array.setBranch(mass_, Form("%s_%s", branchName_obj_.data(), "mass"));
+    bai_array.setBranch(pdgId_, Form("%s_%s", branchName_obj_.data(), "pdgId"));
+    bai_array.setBranch(charge_, Form("%s_%s", branchName_obj_.data(), "charge"));
+    bai_array.setBranch(mvaRawTTH_, Form("%s_%s", branchName_obj_.data(), "mvaRawTTH"));
+    bai_array.setBranch(isFakeable_, Form("%s_%s", branchName_obj_.data(), "isFakeable"));
+    bai_array.setBranch(isTight_, Form("%s_%s", branchName_obj_.data(), "isTight"));
+    bai_array.setBranch(tightCharge_, Form("%s_%s", branchName_obj_.data(), "tightCharge"));
+    bai_array.setBranch(genMatch_, Form("%s_%s", branchName_obj_.data(), "genMatch"));
+    bai_array.setBranch(isFake_, Form("%s_%s", branchName_obj_.data(), "isFake"));
+    bai_array.setBranch(isFlip_, Form("%s_%s", branchName_obj_.data(), "isFlip"));
+  }
+  else
+  {
+    for ( size_t idxLepton = 0; idxLepton < max_nLeptons_; ++idxLepton )
+    {
+      bai.setBranch(pt_[idxLepton], Form("%s%i_%s", branchName_obj_.data(), (int)idxLepton, "pt"));
+      bai.setBranch(eta_[idxLepton], Form("%s%i_%s", branchName_obj_.data(), (int)idxLepton, "eta"));
+      bai.setBranch(phi_[idxLepton], Form("%s%i_%s", branchName_obj_.data(), (int)idxLepton, "phi"));
+      bai.setBranch(mass_[idxLepton], Form("%s%i_%s", branchName_obj_.data(), (int)idxLepton, "mass"));
+      bai.setBranch(pdgId_[idxLepton], Form("%s%i_%s", branchName_obj_.data(), (int)idxLepton, "pdgId"));
+      bai.setBranch(charge_[idxLepton], Form("%s%i_%s", branchName_obj_.data(), (int)idxLepton, "charge"));
+      bai.setBranch(mvaRawTTH_[idxLepton], Form("%s%i_%s", branchName_obj_.data(), (int)idxLepton, "mvaRawTTH"));
+      bai.setBranch(isFakeable_[idxLepton], Form("%s%i_%s", branchName_obj_.data(), (int)idxLepton, "isFakeable"));
+      bai.setBranch(isTight_[idxLepton], Form("%s%i_%s", branchName_obj_.data(), (int)idxLepton, "isTight"));    
+      bai.setBranch(tightCharge_[idxLepton], Form("%s%i_%s", branchName_obj_.data(), (int)idxLepton, "tightCharge"));
+      bai.setBranch(genMatch_[idxLepton], Form("%s%i_%s", branchName_obj_.data(), (int)idxLepton, "genMatch"));
+      bai.setBranch(isFake_[idxLepton], Form("%s%i_%s", branchName_obj_.data(), (int)idxLepton, "isFake"));
+      bai.setBranch(isFlip_[idxLepton], Form("%s%i_%s", branchName_obj_.data(), (int)idxLepton, "isFlip"));
+    }
   }
 }
 
@@ -107,6 +133,12 @@ RecoLeptonWriter::writeImp(const Event & event, const EvtWeightRecorder & evtWei
   //          for which the number of fakeable leptons is equal to the number of "nominal" leptons 
   //         (where the number of "nominal" leptons is specific to a given channel)
   const RecoLeptonPtrCollection& leptons = event.fakeableLeptons();
+  nLeptons_ = leptons.size();
+  if ( writeJaggedArrays_ )
+  {
+    // CV: number of leptons is used as length of the arrays and hence must not exceed the size of the arrays
+    nLeptons_ = std::min(nLeptons_, max_nLeptons_);
+  }
   for ( size_t idxLepton = 0; idxLepton < max_nLeptons_; ++idxLepton )
   {
     if ( idxLepton < nLeptons_ )
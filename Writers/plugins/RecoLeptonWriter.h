@@ -43,6 +43,7 @@ class RecoLeptonWriter : public WriterBase
   std::string branchName_obj_;
 
   UInt_t max_nLeptons_;
+  bool writeJaggedArrays_; ///< write each variable as one variable-length array (lep_pt[nlep]) instead of one branch per lepton
 
   UInt_t nLeptons_;
   Float_t * pt_;
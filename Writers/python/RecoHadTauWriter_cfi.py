@@ -1,5 +1,6 @@
 import FWCore.ParameterSet.Config as cms
 
 fakeableHadTaus = cms.PSet(
-    pluginType = cms.string("RecoHadTauWriter")
+    pluginType = cms.string("RecoHadTauWriter"),
+    writeJaggedArrays = cms.bool(False)
 )
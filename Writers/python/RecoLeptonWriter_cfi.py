@@ -1,5 +1,6 @@
 import FWCore.ParameterSet.Config as cms
 
 fakeableLeptons = cms.PSet(
-    pluginType = cms.string("RecoLeptonWriter")
+    pluginType = cms.string("RecoLeptonWriter"),
+    writeJaggedArrays = cms.bool(False)
 )
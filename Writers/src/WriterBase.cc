@@ -5,6 +5,8 @@
 
 WriterBase::WriterBase(const edm::ParameterSet & cfg)
   : current_central_or_shift_("central")
+  , current_sysId_(nullptr)
+  , current_isSupported_(false) // CV: set by set_central_or_shift, as supported_systematics_ is filled by the constructors of derrived classes
 {}
 
 WriterBase::~WriterBase()
@@ -26,12 +28,35 @@ void
 WriterBase::set_central_or_shift(const std::string & central_or_shift) const
 {
   current_central_or_shift_ = central_or_shift;
+  current_sysId_ = nullptr;
+  current_isSupported_ = contains(supported_systematics_, central_or_shift);
+}
+
+void
+WriterBase::set_central_or_shift(const SysId & sysId) const
+{
+  if ( sysId.idx >= isSupported_.size() )
+  {
+    isSupported_.resize(sysId.idx + 1, -1);
+  }
+  if ( isSupported_[sysId.idx] == -1 )
+  {
+    isSupported_[sysId.idx] = contains(supported_systematics_, sysId.central_or_shift);
+  }
+  current_sysId_ = &sysId;
+  current_isSupported_ = isSupported_[sysId.idx];
+}
+
+const std::string &
+WriterBase::get_current_central_or_shift() const
+{
+  return current_sysId_ ? current_sysId_->central_or_shift : current_central_or_shift_;
 }
 
 void
 WriterBase::write(const Event & event, const EvtWeightRecorder & evtWeightRecorder)
 {
-  if ( contains(supported_systematics_, current_central_or_shift_) )
+  if ( current_isSupported_ )
   {
     writeImp(event, evtWeightRecorder);
   }